@@ -1,4 +1,7 @@
 #include "Flight3DViewer.h"
+#include "FlightTracker.h"
+#include "TraceRecorder.h"
+#include "ModelCache.h"
 
 #include "AttributeListModel.h"
 #include <QFuture>
@@ -11,6 +14,7 @@
 #include "SpatialReference.h"
 #include "Point.h"
 #include "Viewpoint.h"
+#include "Camera.h"
 
 // Graphics includes
 #include "GraphicsOverlay.h"
@@ -35,25 +39,72 @@
 #include "MapTypes.h"        // For BasemapStyle
 #include "SceneViewTypes.h"  // For SurfacePlacement, SceneSymbolAnchorPosition
 #include "SymbolTypes.h"     // For SimpleMarkerSceneSymbolStyle
-#include "Basemap.h"         // For Basemap
 
-#include <QJsonArray>
 #include <QStandardPaths>
 #include <QDebug>
 #include <QtMath>
 #include <QFileInfo>
 #include <QCoreApplication>
-#include <QTemporaryDir>
-#include <QFile>
+#include <QTimer>
+#include <QtConcurrent>
 
 using namespace Esri::ArcGISRuntime;
 
+namespace {
+const QString ModelResourceDir = ":/Resources/AirplaneModel";
+const QString ModelFile = "11803_Airplane_v1_l1.obj";
+const QStringList ModelFiles = {
+    ModelFile,
+    "11803_Airplane_v1_l1.mtl",
+    "11803_Airplane_body_diff.jpg",
+    "11803_Airplane_tail_diff.jpg",
+    "11803_Airplane_wing_big_L_diff.jpg",
+    "11803_Airplane_wing_big_R_diff.jpg",
+    "11803_Airplane_wing_details_L_diff.jpg",
+    "11803_Airplane_wing_details_R_diff.jpg"
+};
+
+// Shared by every 3D view in the process: the model is extracted and parsed once
+QFuture<QString> s_modelPath;
+QPointer<ModelSceneSymbol> s_aircraftSymbol;
+QPointer<ModelSceneSymbol> s_trafficSymbol;
+
+// Level of detail is recomputed at most this often while the camera moves
+constexpr int TrafficLevelIntervalMs = 100;
+constexpr int MotionIntervalMs = 33;
+
+// Aircraft on the ground report altitudes at or below the terrain
+Point aircraftPosition(double longitude, double latitude, double altitude)
+{
+    return Point(longitude, latitude, qMax(altitude, 40.0), SpatialReference::wgs84());
+}
+
+// The model's nose points along X, ArcGIS headings start at north
+double modelHeading(double heading)
+{
+    double adjustedHeading = heading - 90;
+    if (adjustedHeading < 0.0) adjustedHeading += 360.0;
+    return adjustedHeading;
+}
+}
 
 Flight3DViewer::Flight3DViewer(QObject *parent)
     : QObject(parent)
 {
-    m_darkBasemap = new Basemap(BasemapStyle::ArcGISImageryStandard, this);
-    m_lightBasemap = new Basemap(BasemapStyle::ArcGISLightGray, this);
+    // Hashing and copying the model overlaps with the scene setup
+    prepareModel();
+
+    m_trafficLevelTimer = new QTimer(this);
+    m_trafficLevelTimer->setSingleShot(true);
+    m_trafficLevelTimer->setInterval(TrafficLevelIntervalMs);
+    connect(m_trafficLevelTimer, &QTimer::timeout, this, &Flight3DViewer::updateTrafficLevels);
+
+    // Roughly display rate; stops whenever the aircraft has nothing left to move
+    m_motionTimer = new QTimer(this);
+    m_motionTimer->setTimerType(Qt::PreciseTimer);
+    m_motionTimer->setInterval(MotionIntervalMs);
+    connect(m_motionTimer, &QTimer::timeout, this, &Flight3DViewer::advanceMotion);
+    m_clock.start();
 }
 
 Flight3DViewer::~Flight3DViewer() = default;
@@ -100,6 +151,8 @@ void Flight3DViewer::setupScene()
     if (!m_sceneView)
         return;
 
+    TraceScope trace("setup scene", "3d");
+
     // Create scene with imagery basemap (always, regardless of theme for better 3D visualization)
     m_scene = new Scene(BasemapStyle::ArcGISImageryStandard, this);
 
@@ -120,8 +173,22 @@ void Flight3DViewer::setupScene()
     renderer3D->setSceneProperties(properties);
     m_flightOverlay->setRenderer(renderer3D);
 
+    // Surrounding traffic, oriented the same way as the selected aircraft
+    m_trafficOverlay = new GraphicsOverlay(this);
+    m_trafficOverlay->setSceneProperties(LayerSceneProperties(SurfacePlacement::Absolute));
+    SimpleRenderer* trafficRenderer = new SimpleRenderer(this);
+    trafficRenderer->setSceneProperties(properties);
+    m_trafficOverlay->setRenderer(trafficRenderer);
+
     m_sceneView->setArcGISScene(m_scene);
+    m_sceneView->graphicsOverlays()->append(m_trafficOverlay);
     m_sceneView->graphicsOverlays()->append(m_flightOverlay);
+
+    // Throttled rather than debounced, so levels keep up while the camera orbits
+    connect(m_sceneView, &SceneQuickView::viewpointChanged, this, [this]() {
+        if (!m_trafficLevelTimer->isActive())
+            m_trafficLevelTimer->start();
+    });
 }
 
 void Flight3DViewer::setupMap()
@@ -129,6 +196,8 @@ void Flight3DViewer::setupMap()
     if (!m_mapView)
         return;
 
+    TraceScope trace("setup minimap", "3d");
+
     // Create map with imagery basemap (same as 3D scene for consistency)
     m_map = new Map(BasemapStyle::ArcGISImageryStandard, this);
 
@@ -139,139 +208,146 @@ void Flight3DViewer::setupMap()
     m_mapView->graphicsOverlays()->append(m_mapFlightOverlay);
 }
 
-void Flight3DViewer::displayFlight(const QJsonArray& flightData)
+QString Flight3DViewer::icao24() const
 {
-    if (!m_sceneView || flightData.size() < 13)
+    return m_flightIcao24;
+}
+
+void Flight3DViewer::setIcao24(const QString& icao24)
+{
+    if (icao24 == m_flightIcao24)
         return;
 
-    clearFlight();
-    createFlightGraphic(flightData);
+    m_flightIcao24 = icao24;
+    m_motion.clear();
+    m_motionTimer->stop();
+    emit icao24Changed();
+
+    // Until the aircraft shows up in the data there is nothing to draw
+    if (!updateFollowedFlight())
+        hideFlight();
+    updateTraffic();
 }
 
-void Flight3DViewer::createFlightGraphic(const QJsonArray& flightData)
+void Flight3DViewer::onFlightsUpdated()
 {
-    // Safely extract flight data with bounds checking
-    if (flightData.size() < 11) {
-        qDebug() << "Insufficient flight data";
-        return;
+    updateFollowedFlight();
+    updateTraffic();
+}
+
+bool Flight3DViewer::updateFollowedFlight()
+{
+    if (!m_sceneView || !m_flightTracker || m_flightIcao24.isEmpty())
+        return false;
+
+    // Out of coverage for a refresh or two: keep coasting on the last report
+    const FlightData flight = m_flightTracker->store().flight(m_flightIcao24);
+    if (!flight.isValid())
+        return m_motion.isValid();
+
+    const bool first = !m_motion.isValid();
+    m_motion.report(flight, m_clock.elapsed());
+    if (first && !createFlightGraphic()) {
+        m_motion.clear();
+        return false;
     }
 
-    QJsonValue lonValue = flightData[5];
-    QJsonValue latValue = flightData[6];
-    QJsonValue altValue = flightData[7];
-    QJsonValue headingValue = flightData[10];
+    advanceMotion();
+    if (!m_motionTimer->isActive())
+        m_motionTimer->start();
 
-    if (lonValue.isNull() || latValue.isNull() || altValue.isNull()) {
-        qDebug() << "Invalid flight position data";
-        return;
+    // Center minimap on aircraft position with appropriate scale, gliding after the first report
+    if (m_mapView && m_mapFlightGraphic) {
+        Viewpoint mapViewpoint(Point(m_mapFlightGraphic->geometry()), 1000000, 0);
+        m_mapView->setViewpointAsync(mapViewpoint, first ? 0.0f : 1.0f);
     }
+    return true;
+}
 
-    double longitude = lonValue.toDouble();
-    double latitude = latValue.toDouble();
-    double altitude = altValue.toDouble();
-    double heading = headingValue.isNull() ? 0.0 : headingValue.toDouble();
+bool Flight3DViewer::createFlightGraphic()
+{
+    TraceScope trace("create flight graphic", "3d", m_flightIcao24);
+
+    // Placed by advanceMotion straight after
+    const Point position = aircraftPosition(m_motion.lastReport().longitude(), m_motion.lastReport().latitude(),
+                                            m_motion.lastReport().altitude());
+
+    // The graphic is kept for the life of the view, so the orbit camera keeps its target
+    if (!m_flightGraphic) {
+        ModelSceneSymbol* symbol = aircraftSymbol();
+        if (!symbol) {
+            qWarning() << "Aircraft model is not available";
+            return false;
+        }
 
-    if (qIsNaN(longitude) || qIsNaN(latitude) || qIsNaN(altitude)) {
-        qDebug() << "NaN values in flight data";
-        return;
+        m_flightGraphic = new Graphic(position, symbol, this);
+        m_flightGraphic->attributes()->insertAttribute("HEADING", 0.0);
+        m_flightGraphic->attributes()->insertAttribute("PITCH", -90.0);
+        m_flightOverlay->graphics()->append(m_flightGraphic);
     }
+    m_flightGraphic->setVisible(true);
 
-    // Convert altitude from meters to feet for display
-    double altitudeFeet = altitude * 3.28084;
-    
-    const double minOffsetMeters = 40.0;
-    if (altitude < minOffsetMeters) {
-        altitude = minOffsetMeters;
-        altitudeFeet = altitude * 3.28084;
+    // Create 2D flight icon for minimap
+    if (m_mapView && m_mapFlightOverlay) {
+        if (!m_mapFlightGraphic) {
+            // Create airplane symbol for 2D map with white color for visibility
+            QString aircraftChar = "✈";
+            QColor flightColor = QColor(Qt::white);  // Always white for better visibility on minimap
+
+            m_mapFlightSymbol = new TextSymbol(aircraftChar, flightColor, 18.0f,
+                                               HorizontalAlignment::Center,
+                                               VerticalAlignment::Middle, this);
+            m_mapFlightSymbol->setFontFamily("Arial Unicode MS");
+
+            m_mapFlightGraphic = new Graphic(position, m_mapFlightSymbol, this);
+            m_mapFlightGraphic->attributes()->insertAttribute("HEADING", 0.0);
+            m_mapFlightOverlay->graphics()->append(m_mapFlightGraphic);
+        }
+        m_mapFlightGraphic->setVisible(true);
     }
 
-
-    static QString tempModelPath;
-    if (tempModelPath.isEmpty()) {
-        QTemporaryDir tempDir;
-        tempDir.setAutoRemove(false);
-        if (tempDir.isValid()) {
-            QString basePath = tempDir.path();
-            
-            // Extract all model files
-            QStringList filesToExtract = {
-                "11803_Airplane_v1_l1.obj",
-                "11803_Airplane_v1_l1.mtl",
-                "11803_Airplane_body_diff.jpg",
-                "11803_Airplane_tail_diff.jpg",
-                "11803_Airplane_wing_big_L_diff.jpg",
-                "11803_Airplane_wing_big_R_diff.jpg",
-                "11803_Airplane_wing_details_L_diff.jpg",
-                "11803_Airplane_wing_details_R_diff.jpg"
-            };
-            
-            for (const QString& file : filesToExtract) {
-                QString srcPath = ":/Resources/AirplaneModel/" + file;
-                QString destPath = basePath + "/" + file;
-                QFile::copy(srcPath, destPath);
-            }
-            
-            tempModelPath = basePath + "/11803_Airplane_v1_l1.obj";
-        }
+    if (!m_orbitCam) {
+        createOrbitCamera();
     }
-    
-    // Create aircraft symbol using extracted model
-    ModelSceneSymbol* aircraftSymbol = new ModelSceneSymbol(QUrl::fromLocalFile(tempModelPath), this);
-    
 
-    aircraftSymbol->setWidth(2);
-    aircraftSymbol->setHeight(2);
-    aircraftSymbol->setDepth(0.5);
-    
-    aircraftSymbol->setAnchorPosition(SceneSymbolAnchorPosition::Center);
-    
+    if (!m_hasActiveFlight) {
+        m_hasActiveFlight = true;
+        emit activeFlightChanged();
+    }
+    return true;
+}
 
-    connect(aircraftSymbol, &ModelSceneSymbol::loadStatusChanged, [=]() {
-        if (aircraftSymbol->loadStatus() == LoadStatus::FailedToLoad) {
-            qDebug() << "Model failed to load!";
-        }
-    });
+void Flight3DViewer::advanceMotion()
+{
+    if (!m_flightGraphic || !m_motion.isValid()) {
+        m_motionTimer->stop();
+        return;
+    }
 
-    // Create point for aircraft position
-    Point aircraftPosition(longitude, latitude, altitude, SpatialReference::wgs84());
+    const qint64 now = m_clock.elapsed();
+    const FlightMotion::State state = m_motion.at(now);
+    const Point position = aircraftPosition(state.longitude, state.latitude, state.altitude);
 
-    // Create flight graphic
-    m_flightGraphic = new Graphic(aircraftPosition, aircraftSymbol, this);
-    
     // Adjust heading for model coordinate system (X-front to ArcGIS Y-north)
-    double adjustedHeading = heading - 90;
-    if (adjustedHeading < 0.0) adjustedHeading += 360.0;
-    
-    m_flightGraphic->attributes()->insertAttribute("HEADING", adjustedHeading);
-    m_flightGraphic->attributes()->insertAttribute("PITCH", -90.0);
+    const double adjustedHeading = modelHeading(state.heading);
 
-    m_flightOverlay->graphics()->append(m_flightGraphic);
+    // The -90 stands the model the right way up; the climb angle tilts the nose from there
+    m_flightGraphic->setGeometry(position);
+    m_flightGraphic->attributes()->replaceAttribute("HEADING", adjustedHeading);
+    m_flightGraphic->attributes()->replaceAttribute("PITCH", -90.0 + state.pitch);
 
-    // Create 2D flight icon for minimap
-    if (m_mapView && m_mapFlightOverlay) {
-        // Create airplane symbol for 2D map with white color for visibility
-        QString aircraftChar = "✈";
-        QColor flightColor = QColor(Qt::white);  // Always white for better visibility on minimap
-        
-        TextSymbol* airplaneIcon = new TextSymbol(aircraftChar, flightColor, 18.0f,
-                                                 HorizontalAlignment::Center,
-                                                 VerticalAlignment::Middle, this);
-        airplaneIcon->setFontFamily("Arial Unicode MS");
-        airplaneIcon->setAngle(adjustedHeading);  // Rotate to match heading
-            
-        m_mapFlightGraphic = new Graphic(aircraftPosition, airplaneIcon, this);
-        m_mapFlightGraphic->attributes()->insertAttribute("HEADING", adjustedHeading);
-        
-        m_mapFlightOverlay->graphics()->clear();
-        m_mapFlightOverlay->graphics()->append(m_mapFlightGraphic);
-        
-        // Center minimap on aircraft position with appropriate scale
-        // Rotate viewpoint so aircraft points north (rotate by negative heading)
-        Viewpoint mapViewpoint(aircraftPosition, 1000000, 0);
-        m_mapView->setViewpointAsync(mapViewpoint);
+    if (m_mapFlightGraphic) {
+        m_mapFlightGraphic->setGeometry(position);
+        m_mapFlightGraphic->attributes()->replaceAttribute("HEADING", adjustedHeading);
+        m_mapFlightSymbol->setAngle(adjustedHeading);  // Rotate to match heading
     }
 
-    // Create orbit camera controller
+    if (m_motion.isSettled(now))
+        m_motionTimer->stop();
+}
+
+void Flight3DViewer::createOrbitCamera()
+{
     m_orbitCam = new OrbitGeoElementCameraController(m_flightGraphic, 5, this);
     m_orbitCam->setMinCameraDistance(1);
     m_orbitCam->setMaxCameraDistance(100000);
@@ -294,9 +370,183 @@ void Flight3DViewer::createFlightGraphic(const QJsonArray& flightData)
 
     m_sceneView->setCameraController(m_orbitCam);
     qDebug() << "Camera controller set to scene view";
+}
+
+void Flight3DViewer::prepareModel()
+{
+    if (s_modelPath.isValid())
+        return;
+
+    s_modelPath = QtConcurrent::run([]() {
+        TraceScope trace("extract model", "3d");
+        return ModelCache::extract(ModelResourceDir, ModelFiles, ModelFile);
+    });
+}
+
+ModelSceneSymbol* Flight3DViewer::aircraftSymbol()
+{
+    // Sized for the orbit camera's close-up distances
+    if (!s_aircraftSymbol)
+        s_aircraftSymbol = createModelSymbol(2, 2, 0.5);
+    return s_aircraftSymbol;
+}
 
-    m_hasActiveFlight = true;
-    emit activeFlightChanged();
+ModelSceneSymbol* Flight3DViewer::trafficSymbol()
+{
+    // Airliner-sized, so it stays visible kilometers from the camera
+    if (!s_trafficSymbol)
+        s_trafficSymbol = createModelSymbol(40, 40, 10);
+    return s_trafficSymbol;
+}
+
+ModelSceneSymbol* Flight3DViewer::createModelSymbol(double width, double height, double depth)
+{
+    prepareModel();
+    // Normally finished long before the first flight is shown
+    const QString modelPath = s_modelPath.result();
+    if (modelPath.isEmpty()) {
+        // Let the next display try again
+        s_modelPath = QFuture<QString>();
+        return nullptr;
+    }
+
+    // Owned by the application so it outlives the 3D view that created it
+    ModelSceneSymbol* symbol = new ModelSceneSymbol(QUrl::fromLocalFile(modelPath), QCoreApplication::instance());
+    symbol->setWidth(width);
+    symbol->setHeight(height);
+    symbol->setDepth(depth);
+    symbol->setAnchorPosition(SceneSymbolAnchorPosition::Center);
+
+    connect(symbol, &ModelSceneSymbol::loadStatusChanged, symbol, [symbol]() {
+        if (symbol->loadStatus() == LoadStatus::FailedToLoad) {
+            qDebug() << "Model failed to load!";
+        }
+    });
+
+    return symbol;
+}
+
+void Flight3DViewer::updateTraffic()
+{
+    if (!m_showTraffic || !m_flightTracker || !m_trafficOverlay)
+        return;
+
+    const FlightStore& store = m_flightTracker->store();
+    TraceScope trace("update traffic", "3d", QString::number(store.size()));
+
+    // Graphics of aircraft still present are moved instead of rebuilt
+    QHash<QString, Graphic*> previous;
+    for (qsizetype i = 0; i < m_trafficGraphics.size(); ++i) {
+        if (m_trafficGraphics[i])
+            previous.insert(m_trafficFlights[i].icao24(), m_trafficGraphics[i]);
+    }
+
+    // The 2D view's filters apply here too; the selected aircraft has its own graphic
+    m_trafficFlights.clear();
+    const QList<FlightData>& flights = store.flights();
+    const QList<bool>& visible = store.visibility();
+    for (qsizetype i = 0; i < flights.size(); ++i) {
+        if (visible.value(i) && flights[i].icao24() != m_flightIcao24)
+            m_trafficFlights.append(flights[i]);
+    }
+    m_trafficLod.setFlights(m_trafficFlights);
+
+    m_trafficGraphics = QList<Graphic*>(m_trafficFlights.size(), nullptr);
+    for (qsizetype i = 0; i < m_trafficFlights.size(); ++i) {
+        const FlightData& flight = m_trafficFlights[i];
+        Graphic* graphic = previous.take(flight.icao24());
+        if (!graphic)
+            continue;
+
+        m_trafficGraphics[i] = graphic;
+        graphic->setGeometry(aircraftPosition(flight.longitude(), flight.latitude(), flight.altitude()));
+        graphic->attributes()->replaceAttribute("HEADING", modelHeading(flight.heading()));
+        // A marker's color follows the altitude
+        if (m_trafficLod.level(int(i)) == TrafficLod::Marker)
+            graphic->setSymbol(trafficSymbolFor(flight, TrafficLod::Marker));
+    }
+
+    // Aircraft that left, or no longer match the filters
+    for (Graphic* graphic : std::as_const(previous)) {
+        m_trafficOverlay->graphics()->removeOne(graphic);
+        delete graphic;
+    }
+
+    updateTrafficLevels();
+    emit trafficChanged();
+}
+
+void Flight3DViewer::updateTrafficLevels()
+{
+    if (!m_sceneView || m_trafficLod.size() == 0)
+        return;
+
+    const Point camera = m_sceneView->currentViewpointCamera().location();
+    if (camera.isEmpty())
+        return;
+
+    const QList<int> changed = m_trafficLod.update(camera.x(), camera.y(), camera.z());
+    if (changed.isEmpty())
+        return;
+
+    TraceScope trace("traffic levels", "3d", QString::number(changed.size()));
+    for (int index : changed)
+        applyTrafficLevel(index);
+    emit trafficChanged();
+}
+
+void Flight3DViewer::applyTrafficLevel(int index)
+{
+    const FlightData& flight = m_trafficFlights[index];
+    const TrafficLod::Level level = m_trafficLod.level(index);
+    Graphic*& graphic = m_trafficGraphics[index];
+
+    // Hidden aircraft have no graphic at all, which keeps the overlay to what is drawn
+    if (level == TrafficLod::Hidden) {
+        if (graphic) {
+            m_trafficOverlay->graphics()->removeOne(graphic);
+            delete graphic;
+            graphic = nullptr;
+        }
+        return;
+    }
+
+    Symbol* symbol = trafficSymbolFor(flight, level);
+    if (graphic) {
+        graphic->setSymbol(symbol);
+        return;
+    }
+
+    graphic = new Graphic(aircraftPosition(flight.longitude(), flight.latitude(), flight.altitude()), symbol, this);
+    graphic->attributes()->insertAttribute("HEADING", modelHeading(flight.heading()));
+    graphic->attributes()->insertAttribute("PITCH", -90.0);
+    m_trafficOverlay->graphics()->append(graphic);
+}
+
+Symbol* Flight3DViewer::trafficSymbolFor(const FlightData& flight, TrafficLod::Level level)
+{
+    if (level == TrafficLod::Model) {
+        if (ModelSceneSymbol* model = trafficSymbol())
+            return model;
+    }
+
+    // Screen-sized dots, one shared symbol per altitude band
+    const QColor color = getAltitudeColor(flight.altitude() * 3.28084);
+    SimpleMarkerSymbol*& marker = m_markerSymbols[color.rgb()];
+    if (!marker)
+        marker = new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Circle, color, 8.0f, this);
+    return marker;
+}
+
+void Flight3DViewer::clearTraffic()
+{
+    if (m_trafficOverlay)
+        m_trafficOverlay->graphics()->clear();
+    qDeleteAll(m_trafficGraphics);
+    m_trafficGraphics.clear();
+    m_trafficFlights.clear();
+    m_trafficLod.clear();
+    emit trafficChanged();
 }
 
 QColor Flight3DViewer::getAltitudeColor(double altitude)
@@ -317,11 +567,16 @@ QColor Flight3DViewer::getAltitudeColor(double altitude)
 
 void Flight3DViewer::clearFlight()
 {
-    if (m_flightOverlay)
-        m_flightOverlay->graphics()->clear();
+    setIcao24(QString());
+}
 
-    m_flightGraphic = nullptr;
-    m_orbitCam = nullptr;
+void Flight3DViewer::hideFlight()
+{
+    // Hidden rather than removed: the next flight reuses the graphics and the camera controller
+    if (m_flightGraphic)
+        m_flightGraphic->setVisible(false);
+    if (m_mapFlightGraphic)
+        m_mapFlightGraphic->setVisible(false);
 
     if (m_hasActiveFlight) {
         m_hasActiveFlight = false;
@@ -399,6 +654,56 @@ bool Flight3DViewer::hasActiveFlight() const
     return m_hasActiveFlight;
 }
 
+FlightTracker* Flight3DViewer::flightTracker() const
+{
+    return m_flightTracker;
+}
+
+void Flight3DViewer::setFlightTracker(FlightTracker* flightTracker)
+{
+    if (flightTracker == m_flightTracker)
+        return;
+
+    if (m_flightTracker)
+        disconnect(m_flightTracker, nullptr, this, nullptr);
+
+    m_flightTracker = flightTracker;
+    if (m_flightTracker)
+        connect(m_flightTracker, &FlightTracker::flightsUpdated, this, &Flight3DViewer::onFlightsUpdated);
+
+    clearTraffic();
+    onFlightsUpdated();
+    emit flightTrackerChanged();
+}
+
+bool Flight3DViewer::showTraffic() const
+{
+    return m_showTraffic;
+}
+
+void Flight3DViewer::setShowTraffic(bool show)
+{
+    if (show == m_showTraffic)
+        return;
+
+    m_showTraffic = show;
+    if (m_showTraffic)
+        updateTraffic();
+    else
+        clearTraffic();
+    emit showTrafficChanged();
+}
+
+int Flight3DViewer::trafficModels() const
+{
+    return m_trafficLod.count(TrafficLod::Model);
+}
+
+int Flight3DViewer::trafficMarkers() const
+{
+    return m_trafficLod.count(TrafficLod::Marker);
+}
+
 bool Flight3DViewer::isDarkTheme() const
 {
     return m_isDarkTheme;
@@ -411,13 +716,4 @@ void Flight3DViewer::setIsDarkTheme(bool isDark)
         
         emit isDarkThemeChanged();
     }
-}
-
-void Flight3DViewer::displayFlight(const QVariantList& flightDataVariant)
-{
-    QJsonArray jsonArray;
-    for (const QVariant& variant : flightDataVariant) {
-        jsonArray.append(QJsonValue::fromVariant(variant));
-    }
-    displayFlight(jsonArray);
-}
+}
\ No newline at end of file
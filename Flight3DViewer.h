@@ -2,8 +2,16 @@
 #define FLIGHT3DVIEWER_H
 
 #include <QObject>
-#include <QJsonArray>
 #include <QColor>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include "FlightData.h"
+#include "FlightMotion.h"
+#include "TrafficLod.h"
+
+class QTimer;
+class FlightTracker;
 
 // Add these forward declarations
 namespace Esri::ArcGISRuntime {
@@ -14,14 +22,18 @@ class MapQuickView;
 class GraphicsOverlay;
 class Graphic;
 class OrbitGeoElementCameraController;
+class ModelSceneSymbol;
+class TextSymbol;
+class Symbol;
+class SimpleMarkerSymbol;
 class SimpleMarkerSceneSymbol;
 class SimpleRenderer;
 class ArcGISTiledElevationSource;
-class Basemap;
 }
 
 Q_MOC_INCLUDE("SceneQuickView.h")
 Q_MOC_INCLUDE("MapQuickView.h")
+Q_MOC_INCLUDE("FlightTracker.h")
 
 class Flight3DViewer : public QObject
 {
@@ -34,6 +46,11 @@ class Flight3DViewer : public QObject
     Q_PROPERTY(double cameraPitch READ cameraPitch WRITE setCameraPitch NOTIFY cameraPitchChanged)
     Q_PROPERTY(bool hasActiveFlight READ hasActiveFlight NOTIFY activeFlightChanged)
     Q_PROPERTY(bool isDarkTheme READ isDarkTheme WRITE setIsDarkTheme NOTIFY isDarkThemeChanged)
+    Q_PROPERTY(QString icao24 READ icao24 WRITE setIcao24 NOTIFY icao24Changed)
+    Q_PROPERTY(FlightTracker* flightTracker READ flightTracker WRITE setFlightTracker NOTIFY flightTrackerChanged)
+    Q_PROPERTY(bool showTraffic READ showTraffic WRITE setShowTraffic NOTIFY showTrafficChanged)
+    Q_PROPERTY(int trafficModels READ trafficModels NOTIFY trafficChanged)
+    Q_PROPERTY(int trafficMarkers READ trafficMarkers NOTIFY trafficChanged)
 
 public:
     explicit Flight3DViewer(QObject *parent = nullptr);
@@ -61,12 +78,23 @@ public:
     bool isDarkTheme() const;
     void setIsDarkTheme(bool isDark);
 
+    // The aircraft to follow; its position comes from the tracker on every refresh
+    QString icao24() const;
+    void setIcao24(const QString& icao24);
+
+    // Surrounding traffic comes from the 2D view's flights, with its filters applied
+    FlightTracker* flightTracker() const;
+    void setFlightTracker(FlightTracker* flightTracker);
+
+    bool showTraffic() const;
+    void setShowTraffic(bool show);
+    int trafficModels() const;
+    int trafficMarkers() const;
+
 public slots:
-    Q_INVOKABLE void displayFlight(const QJsonArray& flightData);
     Q_INVOKABLE void clearFlight();
     Q_INVOKABLE void cockpitView();
     Q_INVOKABLE void followView();
-    Q_INVOKABLE void displayFlight(const QVariantList& flightDataVariant);
 
 signals:
     void sceneViewChanged();
@@ -76,12 +104,31 @@ signals:
     void cameraPitchChanged();
     void activeFlightChanged();
     void isDarkThemeChanged();
+    void icao24Changed();
+    void flightTrackerChanged();
+    void showTrafficChanged();
+    void trafficChanged();
 
 private:
     void setupScene();
     void setupMap();
-    void createFlightGraphic(const QJsonArray& flightData);
-    void updateMinimapPosition();
+    void onFlightsUpdated();
+    bool updateFollowedFlight();
+    bool createFlightGraphic();
+    void advanceMotion();
+    void hideFlight();
+    void createOrbitCamera();
+    static void prepareModel();
+    static Esri::ArcGISRuntime::ModelSceneSymbol* aircraftSymbol();
+    static Esri::ArcGISRuntime::ModelSceneSymbol* trafficSymbol();
+    static Esri::ArcGISRuntime::ModelSceneSymbol* createModelSymbol(double width, double height, double depth);
+
+    // Surrounding traffic
+    void updateTraffic();
+    void updateTrafficLevels();
+    void applyTrafficLevel(int index);
+    void clearTraffic();
+    Esri::ArcGISRuntime::Symbol* trafficSymbolFor(const FlightData& flight, TrafficLod::Level level);
     QColor getAltitudeColor(double altitude);
 
     Esri::ArcGISRuntime::Scene* m_scene = nullptr;
@@ -93,13 +140,25 @@ private:
     Esri::ArcGISRuntime::OrbitGeoElementCameraController* m_orbitCam = nullptr;
     Esri::ArcGISRuntime::Graphic* m_flightGraphic = nullptr;
     Esri::ArcGISRuntime::Graphic* m_mapFlightGraphic = nullptr;
+    Esri::ArcGISRuntime::TextSymbol* m_mapFlightSymbol = nullptr;
     bool m_hasActiveFlight = false;
+    QString m_flightIcao24;
+    FlightMotion m_motion;
+    QTimer* m_motionTimer = nullptr;
+    QElapsedTimer m_clock;
+
+    QPointer<FlightTracker> m_flightTracker;
+    bool m_showTraffic = true;
+    Esri::ArcGISRuntime::GraphicsOverlay* m_trafficOverlay = nullptr;
+    TrafficLod m_trafficLod;
+    // Parallel to the flights given to m_trafficLod; null while an aircraft is hidden
+    QList<FlightData> m_trafficFlights;
+    QList<Esri::ArcGISRuntime::Graphic*> m_trafficGraphics;
+    QHash<QRgb, Esri::ArcGISRuntime::SimpleMarkerSymbol*> m_markerSymbols;
+    QTimer* m_trafficLevelTimer = nullptr;
     
     // Theme management
     bool m_isDarkTheme = true;
-    // Pre-created basemaps
-    Esri::ArcGISRuntime::Basemap *m_darkBasemap = nullptr;
-    Esri::ArcGISRuntime::Basemap *m_lightBasemap = nullptr;
 };
 
 #endif
@@ -1,18 +1,21 @@
 #include "FlightRenderer.h"
+#include "FlightTrack.h"
+#include "FlightClassifier.h"
+#include "DensityGrid.h"
 #include "TextSymbol.h"
 #include "Graphic.h"
 #include "Point.h"
 #include "SpatialReference.h"
 #include "SimpleLineSymbol.h"
 #include "SimpleMarkerSymbol.h"
+#include "PictureMarkerSymbol.h"
 #include "GraphicsOverlay.h"
 #include "GraphicListModel.h"
 #include "Polyline.h"
 #include "PolylineBuilder.h"
 #include "SymbolTypes.h"
 #include "MapTypes.h"
-#include <QJsonObject>
-#include <QJsonArray>
+#include <algorithm>
 #include <cmath>
 
 using namespace Esri::ArcGISRuntime;
@@ -41,34 +44,35 @@ QColor FlightRenderer::getAltitudeColor(double altitude)
 
 int FlightRenderer::getCategoryFromCallsign(const QString& callsign)
 {
-    if (callsign.isEmpty()) return 1;
-
-    QString trimmed = callsign.trimmed();
-    int length = trimmed.length();
-    int digitCount = 0;
+    return FlightClassifier::categoryFromCallsign(callsign);
+}
 
-    for (QChar c : trimmed) {
-        if (c.isDigit()) digitCount++;
+GraphicsGeneration* FlightRenderer::generation(GraphicsOverlay* overlay)
+{
+    QPointer<GraphicsGeneration>& generation = m_generations[overlay];
+    if (!generation) {
+        generation = new GraphicsGeneration(this);
     }
+    return generation;
+}
 
-    // US N-number pattern
-    if (trimmed.startsWith('N') && digitCount >= 2) return 2;
-
-    // Cargo indicators
-    if (trimmed.contains("FDX") || trimmed.contains("UPS") ||
-        trimmed.contains("CARGO") || trimmed.contains("ABX")) return 6;
+void FlightRenderer::clearGraphics(GraphicsOverlay* overlay)
+{
+    if (!overlay) return;
 
-    // Emergency/helicopter indicators
-    if (trimmed.contains("MED") || trimmed.contains("RESCUE") ||
-        trimmed.contains("LIFE") || trimmed.contains("HELI")) return 8;
+    if (overlay->graphics()) {
+        overlay->graphics()->clear();
+    }
 
-    // Size-based categorization
-    if (length <= 5) return 3;
-    else if (length <= 7) return 4;
-    else return 3;
+    // Released on the next event loop pass, once nothing queued can still reach them
+    GraphicsGeneration* retired = m_generations.take(overlay);
+    if (retired) {
+        retired->deleteLater();
+    }
 }
 
-TextSymbol* FlightRenderer::getSymbolForCategory(int category, bool onGround, double altitude)
+TextSymbol* FlightRenderer::getSymbolForCategory(int category, bool onGround, double altitude,
+                                                 GraphicsGeneration* generation)
 {
     QString aircraftChar = "✈";
     float fontSize = 20.0f;
@@ -94,15 +98,16 @@ TextSymbol* FlightRenderer::getSymbolForCategory(int category, bool onGround, do
 
     TextSymbol* symbol = new TextSymbol(aircraftChar, color, fontSize,
                                        HorizontalAlignment::Center,
-                                       VerticalAlignment::Middle, this);
+                                       VerticalAlignment::Middle, generation);
+    generation->track(GraphicsGeneration::Symbols);
     symbol->setFontFamily("Arial Unicode MS");
     return symbol;
 }
 
-TextSymbol* FlightRenderer::createFlightSymbol(const FlightData& flight)
+TextSymbol* FlightRenderer::createFlightSymbol(const FlightData& flight, GraphicsGeneration* generation)
 {
     int category = getCategoryFromCallsign(flight.callsign());
-    TextSymbol* symbol = getSymbolForCategory(category, flight.onGround(), flight.altitude());
+    TextSymbol* symbol = getSymbolForCategory(category, flight.onGround(), flight.altitude(), generation);
 
     // Set rotation based on heading
     double heading = flight.heading();
@@ -115,7 +120,7 @@ TextSymbol* FlightRenderer::createFlightSymbol(const FlightData& flight)
     return symbol;
 }
 
-Graphic* FlightRenderer::createFlightGraphic(const FlightData& flight)
+Graphic* FlightRenderer::createFlightGraphic(const FlightData& flight, GraphicsGeneration* generation)
 {
     if (!flight.isValid()) {
         qDebug() << "FlightRenderer: Invalid flight data";
@@ -135,14 +140,16 @@ Graphic* FlightRenderer::createFlightGraphic(const FlightData& flight)
 
     try {
         Point flightPoint(lon, lat, SpatialReference::wgs84());
-        TextSymbol* symbol = createFlightSymbol(flight);
+        TextSymbol* symbol = createFlightSymbol(flight, generation);
         
         if (!symbol) {
             qDebug() << "FlightRenderer: Failed to create symbol";
             return nullptr;
         }
         
-        return new Graphic(flightPoint, symbol, this);
+        Graphic* graphic = new Graphic(flightPoint, symbol, generation);
+        generation->track(GraphicsGeneration::Graphics);
+        return graphic;
         
     } catch (const std::exception& e) {
         qDebug() << "FlightRenderer: Exception creating graphic:" << e.what();
@@ -171,6 +178,8 @@ void FlightRenderer::updateFlightGraphics(GraphicsOverlay* overlay, const QList<
     // Don't clear here - FlightTracker already cleared graphics safely
     // This avoids potential race conditions with selection graphics
 
+    GraphicsGeneration* owner = generation(overlay);
+
     int validFlights = 0;
     for (int i = 0; i < flights.size(); ++i) {
         const FlightData& flight = flights[i];
@@ -180,7 +189,7 @@ void FlightRenderer::updateFlightGraphics(GraphicsOverlay* overlay, const QList<
         }
 
         try {
-            Graphic* graphic = createFlightGraphic(flight);
+            Graphic* graphic = createFlightGraphic(flight, owner);
             if (graphic) {
                 graphics->append(graphic);
                 validFlights++;
@@ -197,26 +206,33 @@ void FlightRenderer::updateFlightGraphics(GraphicsOverlay* overlay, const QList<
     }
 
     qDebug() << "FlightRenderer: Created graphics for" << validFlights << "out of" << flights.size() << "flights";
+
+    // Anything made per refresh belongs to a generation; an object parented to the renderer itself
+    // would live until shutdown, which the SDK-free soak test cannot see
+    Q_ASSERT_X(std::all_of(children().cbegin(), children().cend(),
+                           [](QObject* child) { return qobject_cast<GraphicsGeneration*>(child) != nullptr; }),
+               "FlightRenderer::updateFlightGraphics", "per-refresh object parented to the renderer");
 }
 
 void FlightRenderer::createSelectionGraphic(GraphicsOverlay* selectionOverlay, const FlightData& flight, bool isDarkTheme)
 {
     if (!selectionOverlay) return;
 
-    selectionOverlay->graphics()->clear();
+    clearGraphics(selectionOverlay);
+    GraphicsGeneration* owner = generation(selectionOverlay);
 
     Point flightPoint(flight.longitude(), flight.latitude(), SpatialReference::wgs84());
 
     // Create theme-aware selection ring
     QColor ringColor = isDarkTheme ? QColor(255, 255, 255) : QColor(0, 0, 0);  // White for dark, black for light
     SimpleLineSymbol* outline = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid,
-                                                    ringColor, 2.5f, this);
+                                                    ringColor, 2.5f, owner);
 
     SimpleMarkerSymbol* ringSymbol = new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Circle,
-                                                           QColor(Qt::transparent), 30.0f, this);
+                                                           QColor(Qt::transparent), 30.0f, owner);
     ringSymbol->setOutline(outline);
 
-    Graphic* ringGraphic = new Graphic(flightPoint, ringSymbol, this);
+    Graphic* ringGraphic = new Graphic(flightPoint, ringSymbol, owner);
     selectionOverlay->graphics()->append(ringGraphic);
 
     // Create theme-aware label
@@ -226,61 +242,194 @@ void FlightRenderer::createSelectionGraphic(GraphicsOverlay* selectionOverlay, c
     
     TextSymbol* labelSymbol = new TextSymbol(labelText, labelColor, 14.0f,
                                            HorizontalAlignment::Center,
-                                           VerticalAlignment::Top, this);
+                                           VerticalAlignment::Top, owner);
     labelSymbol->setHaloColor(haloColor);
     labelSymbol->setHaloWidth(1.0f);
     labelSymbol->setOffsetY(-16.0f);
 
     Point labelPoint(flight.longitude(), flight.latitude() - 0.0003, SpatialReference::wgs84());
-    Graphic* labelGraphic = new Graphic(labelPoint, labelSymbol, this);
+    Graphic* labelGraphic = new Graphic(labelPoint, labelSymbol, owner);
     selectionOverlay->graphics()->append(labelGraphic);
+
+    owner->track(GraphicsGeneration::Symbols, 3);
+    owner->track(GraphicsGeneration::Graphics, 2);
 }
 
-void FlightRenderer::drawFlightTrack(GraphicsOverlay* trackOverlay, const QJsonObject& trackData)
+int FlightRenderer::drawFlightTrack(GraphicsOverlay* trackOverlay, const FlightTrack& track, double toleranceMeters)
 {
-    if (!trackOverlay) return;
-
-    trackOverlay->graphics()->clear();
-
-    if (!trackData.contains("path")) return;
+    if (!trackOverlay) return 0;
 
-    QJsonArray path = trackData["path"].toArray();
-    if (path.isEmpty()) return;
+    clearGraphics(trackOverlay);
 
-    QList<Point> trackPoints;
-    QList<double> altitudes;
+    if (track.isEmpty()) return 0;
 
-    for (const QJsonValue& value : path) {
-        QJsonArray waypoint = value.toArray();
-        if (waypoint.size() >= 6) {
-            double lat = waypoint[1].toDouble();
-            double lon = waypoint[2].toDouble();
-            double altitude = waypoint[3].toDouble();
-            bool onGround = waypoint[5].toBool();
+    // Only the vertices significant at the current map scale are drawn
+    const QList<FlightTrack::Waypoint>& waypoints = track.waypoints();
+    const QList<int> vertices = track.verticesForTolerance(toleranceMeters);
 
-            if (lat == 0.0 && lon == 0.0) continue;
+    if (vertices.size() < 2) return 0;
 
-            trackPoints.append(Point(lon, lat, SpatialReference::wgs84()));
-            altitudes.append(onGround ? 0.0 : altitude);
-        }
-    }
-
-    if (trackPoints.size() < 2) return;
+    GraphicsGeneration* owner = generation(trackOverlay);
 
     // Draw colored line segments
-    for (int i = 0; i < trackPoints.size() - 1; ++i) {
+    for (int i = 0; i < vertices.size() - 1; ++i) {
+        const FlightTrack::Waypoint& from = waypoints[vertices[i]];
+        const FlightTrack::Waypoint& to = waypoints[vertices[i + 1]];
+
         PolylineBuilder polylineBuilder(SpatialReference::wgs84());
-        polylineBuilder.addPoint(trackPoints[i]);
-        polylineBuilder.addPoint(trackPoints[i + 1]);
+        polylineBuilder.addPoint(Point(from.longitude, from.latitude, SpatialReference::wgs84()));
+        polylineBuilder.addPoint(Point(to.longitude, to.latitude, SpatialReference::wgs84()));
 
-        double avgAltitude = (altitudes[i] + altitudes[i + 1]) / 2.0;
+        double avgAltitude = (from.altitude + to.altitude) / 2.0;
         QColor lineColor = getAltitudeColor(avgAltitude);
 
         SimpleLineSymbol* lineSymbol = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid,
-                                                           lineColor, 3.0f, this);
+                                                           lineColor, 3.0f, owner);
         lineSymbol->setAntiAlias(true);
 
-        Graphic* segmentGraphic = new Graphic(polylineBuilder.toPolyline(), lineSymbol, this);
+        Graphic* segmentGraphic = new Graphic(polylineBuilder.toPolyline(), lineSymbol, owner);
         trackOverlay->graphics()->append(segmentGraphic);
     }
+
+    owner->track(GraphicsGeneration::Symbols, vertices.size() - 1);
+    owner->track(GraphicsGeneration::Graphics, vertices.size() - 1);
+
+    return int(vertices.size());
+}
+
+QImage FlightRenderer::densityImage(const DensityGrid& grid)
+{
+    // Transparent through blue, green and yellow to red, more opaque as traffic gets denser
+    static const QList<QRgb> ramp = []() {
+        const QColor stops[] = {QColor(0, 60, 255, 0), QColor(0, 120, 255, 110), QColor(0, 220, 120, 160),
+                                QColor(255, 230, 0, 200), QColor(255, 40, 0, 235)};
+        QList<QRgb> colors(256);
+        for (int i = 0; i < 256; ++i) {
+            const double t = i / 255.0 * 4.0;
+            const int stop = qMin(int(t), 3);
+            const double f = t - stop;
+            const QColor& a = stops[stop];
+            const QColor& b = stops[stop + 1];
+            colors[i] = qPremultiply(qRgba(int(a.red() + (b.red() - a.red()) * f),
+                                           int(a.green() + (b.green() - a.green()) * f),
+                                           int(a.blue() + (b.blue() - a.blue()) * f),
+                                           int(a.alpha() + (b.alpha() - a.alpha()) * f)));
+        }
+        return colors;
+    }();
+
+    const int size = grid.size();
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    if (grid.maxValue() <= 0.0f) {
+        return image;
+    }
+
+    // Log scale, so a few busy hubs do not wash out everything else
+    const float scale = 255.0f / std::log1p(grid.maxValue());
+    const float* values = grid.values().constData();
+    for (int row = 0; row < size; ++row) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(row));
+        for (int column = 0; column < size; ++column) {
+            const float value = values[qsizetype(row) * size + column];
+            if (value > 0.01f) {
+                line[column] = ramp[qBound(0, int(std::log1p(value) * scale), 255)];
+            }
+        }
+    }
+    return image;
+}
+
+void FlightRenderer::drawDensity(GraphicsOverlay* densityOverlay, const DensityGrid& grid, double unitsPerDIP)
+{
+    if (!densityOverlay) return;
+
+    clearGraphics(densityOverlay);
+    GraphicsGeneration* owner = generation(densityOverlay);
+
+    // One marker at the centre of the Web Mercator square, as wide as the square on screen
+    m_densitySymbol = new PictureMarkerSymbol(densityImage(grid), owner);
+    resizeDensity(unitsPerDIP);
+
+    Graphic* graphic = new Graphic(Point(0.0, 0.0, SpatialReference::webMercator()), m_densitySymbol, owner);
+    densityOverlay->graphics()->append(graphic);
+
+    owner->track(GraphicsGeneration::Symbols);
+    owner->track(GraphicsGeneration::Graphics);
+}
+
+void FlightRenderer::resizeDensity(double unitsPerDIP)
+{
+    if (!m_densitySymbol || unitsPerDIP <= 0.0) return;
+
+    const float size = float(2.0 * DensityGrid::HalfExtent / unitsPerDIP);
+    m_densitySymbol->setWidth(size);
+    m_densitySymbol->setHeight(size);
+}
+
+void FlightRenderer::drawAlertHighlights(GraphicsOverlay* alertOverlay, const QList<FlightData>& flights)
+{
+    if (!alertOverlay) return;
+
+    clearGraphics(alertOverlay);
+    if (flights.isEmpty()) return;
+    GraphicsGeneration* owner = generation(alertOverlay);
+
+    // One shared ring, red on any basemap and larger than the selection ring
+    SimpleLineSymbol* outline = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, QColor(230, 30, 30), 3.0f, owner);
+    SimpleMarkerSymbol* ring = new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Circle,
+                                                      QColor(230, 30, 30, 50), 40.0f, owner);
+    ring->setOutline(outline);
+
+    for (const FlightData& flight : flights) {
+        Graphic* graphic = new Graphic(Point(flight.longitude(), flight.latitude(), SpatialReference::wgs84()),
+                                       ring, owner);
+        alertOverlay->graphics()->append(graphic);
+    }
+
+    owner->track(GraphicsGeneration::Symbols, 2);
+    owner->track(GraphicsGeneration::Graphics, flights.size());
+}
+
+void FlightRenderer::drawConflicts(GraphicsOverlay* conflictOverlay, const QList<FlightData>& flights,
+                                   const QList<ConflictDetector::Conflict>& conflicts)
+{
+    if (!conflictOverlay) return;
+
+    clearGraphics(conflictOverlay);
+    if (conflicts.isEmpty()) return;
+    GraphicsGeneration* owner = generation(conflictOverlay);
+
+    SimpleLineSymbol* closing = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, QColor(230, 30, 30), 2.5f, owner);
+    SimpleLineSymbol* diverging = new SimpleLineSymbol(SimpleLineSymbolStyle::Dash, QColor(255, 170, 0), 2.0f, owner);
+    SimpleLineSymbol* outline = new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, QColor(255, 170, 0), 2.0f, owner);
+    SimpleMarkerSymbol* marker = new SimpleMarkerSymbol(SimpleMarkerSymbolStyle::Diamond,
+                                                        QColor(255, 170, 0, 60), 18.0f, owner);
+    marker->setOutline(outline);
+
+    int drawn = 0;
+    for (const ConflictDetector::Conflict& conflict : conflicts) {
+        if (conflict.first < 0 || conflict.second >= flights.size()) continue;
+        const FlightData& first = flights[conflict.first];
+        const FlightData& second = flights[conflict.second];
+
+        // Across the antimeridian, the short way round
+        double secondLongitude = second.longitude();
+        if (secondLongitude - first.longitude() > 180.0) secondLongitude -= 360.0;
+        else if (secondLongitude - first.longitude() < -180.0) secondLongitude += 360.0;
+
+        PolylineBuilder polylineBuilder(SpatialReference::wgs84());
+        polylineBuilder.addPoint(Point(first.longitude(), first.latitude(), SpatialReference::wgs84()));
+        polylineBuilder.addPoint(Point(secondLongitude, second.latitude(), SpatialReference::wgs84()));
+        conflictOverlay->graphics()->append(new Graphic(polylineBuilder.toPolyline(),
+                                                        conflict.closureKnots > 0.0 ? closing : diverging, owner));
+
+        const Point middle((first.longitude() + secondLongitude) / 2.0, (first.latitude() + second.latitude()) / 2.0,
+                           SpatialReference::wgs84());
+        conflictOverlay->graphics()->append(new Graphic(middle, marker, owner));
+        ++drawn;
+    }
+
+    owner->track(GraphicsGeneration::Symbols, 4);
+    owner->track(GraphicsGeneration::Graphics, 2 * drawn);
 }
\ No newline at end of file
@@ -3,12 +3,21 @@
 
 #include <QObject>
 #include <QColor>
+#include <QImage>
+#include <QHash>
+#include <QPointer>
 #include "FlightData.h"
+#include "ConflictDetector.h"
+#include "GraphicsGeneration.h"
+
+class FlightTrack;
+class DensityGrid;
 
 namespace Esri::ArcGISRuntime {
 class TextSymbol;
 class GraphicsOverlay;
 class Graphic;
+class PictureMarkerSymbol;
 class Point;
 class Polyline;
 class SimpleLineSymbol;
@@ -24,9 +33,16 @@ public:
 
     static QColor getAltitudeColor(double altitude);
     static int getCategoryFromCallsign(const QString& callsign);
-    
-    Esri::ArcGISRuntime::TextSymbol* createFlightSymbol(const FlightData& flight);
-    Esri::ArcGISRuntime::Graphic* createFlightGraphic(const FlightData& flight);
+
+    // The symbol and graphic are owned by generation
+    Esri::ArcGISRuntime::TextSymbol* createFlightSymbol(const FlightData& flight, GraphicsGeneration* generation);
+    Esri::ArcGISRuntime::Graphic* createFlightGraphic(const FlightData& flight, GraphicsGeneration* generation);
+
+    // Owner of everything currently drawn in overlay, created on first use
+    GraphicsGeneration* generation(Esri::ArcGISRuntime::GraphicsOverlay* overlay);
+
+    // Empties overlay and releases the graphics and symbols that were drawn in it
+    void clearGraphics(Esri::ArcGISRuntime::GraphicsOverlay* overlay);
     
     void updateFlightGraphics(Esri::ArcGISRuntime::GraphicsOverlay* overlay, 
                              const QList<FlightData>& flights);
@@ -34,11 +50,31 @@ public:
     void createSelectionGraphic(Esri::ArcGISRuntime::GraphicsOverlay* selectionOverlay,
                                const FlightData& flight, bool isDarkTheme = true);
 
-    void drawFlightTrack(Esri::ArcGISRuntime::GraphicsOverlay* trackOverlay,
-                        const QJsonObject& trackData);
+    // Draws the vertices of track kept at toleranceMeters and returns how many were drawn
+    int drawFlightTrack(Esri::ArcGISRuntime::GraphicsOverlay* trackOverlay,
+                        const FlightTrack& track, double toleranceMeters = 0.0);
+
+    // Draws grid as one image over the Web Mercator square, scaled for unitsPerDIP map meters
+    // per DIP. resizeDensity rescales it after a zoom without rebuilding the image.
+    void drawDensity(Esri::ArcGISRuntime::GraphicsOverlay* densityOverlay, const DensityGrid& grid,
+                     double unitsPerDIP);
+    void resizeDensity(double unitsPerDIP);
+    static QImage densityImage(const DensityGrid& grid);
+
+    // Replaces the rings drawn around aircraft with an active alert
+    void drawAlertHighlights(Esri::ArcGISRuntime::GraphicsOverlay* alertOverlay, const QList<FlightData>& flights);
+
+    // Replaces the lines joining aircraft in conflict, red when closing and amber otherwise, with
+    // a marker halfway so a pair stays visible zoomed out. Indexes refer to flights.
+    void drawConflicts(Esri::ArcGISRuntime::GraphicsOverlay* conflictOverlay, const QList<FlightData>& flights,
+                       const QList<ConflictDetector::Conflict>& conflicts);
 
 private:
-    Esri::ArcGISRuntime::TextSymbol* getSymbolForCategory(int category, bool onGround, double altitude);
+    Esri::ArcGISRuntime::TextSymbol* getSymbolForCategory(int category, bool onGround, double altitude,
+                                                          GraphicsGeneration* generation);
+
+    QHash<Esri::ArcGISRuntime::GraphicsOverlay*, QPointer<GraphicsGeneration>> m_generations;
+    QPointer<Esri::ArcGISRuntime::PictureMarkerSymbol> m_densitySymbol;
 };
 
 #endif // FLIGHTRENDERER_H
\ No newline at end of file
@@ -1,10 +1,21 @@
 #include "FlightTracker.h"
+#include "TraceRecorder.h"
+#include "GraphicsGeneration.h"
+#include "MemoryStats.h"
 #include "OpenSkyAuthManager.h"
 #include "FlightDataService.h"
+#include "FlightShards.h"
+#include "FileFlightDataSource.h"
+#include "SyntheticFlightDataSource.h"
 #include "FlightRenderer.h"
+#include "FlightReplayService.h"
+#include "SnapshotCache.h"
+#include "StartupTimeline.h"
+#include "FlightFilter.h"
 #include "Map.h"
 #include "MapQuickView.h"
 #include "MapTypes.h"
+#include "MapViewTypes.h"
 #include "Basemap.h"
 #include "GraphicsOverlay.h"
 #include "Graphic.h"
@@ -14,12 +25,18 @@
 #include "PopupDefinition.h"
 #include "TextPopupElement.h"
 #include "Point.h"
+#include "Polygon.h"
+#include "Envelope.h"
 #include "SpatialReference.h"
+#include "GeometryEngine.h"
 #include "GeoElement.h"
 #include <QFile>
+#include <QQuickWindow>
+#include <QCoreApplication>
+#include <QtConcurrent>
+#include <QFutureWatcher>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QLineF>
 #include <QTimer>
 #include <QDebug>
 
@@ -29,35 +46,89 @@ FlightTracker::FlightTracker(QObject *parent)
     : QObject(parent)
     , m_map(new Map(BasemapStyle::ArcGISHumanGeographyDark, this))  // Start with dark basemap
     , m_authManager(new OpenSkyAuthManager(this))
-    , m_dataService(new FlightDataService(this))
     , m_renderer(new FlightRenderer(this))
+    , m_replayService(new FlightReplayService(this))
     , m_flightOverlay(new GraphicsOverlay(this))
     , m_selectionOverlay(new GraphicsOverlay(this))
     , m_trackOverlay(new GraphicsOverlay(this))
+    , m_densityOverlay(new GraphicsOverlay(this))
+    , m_alertOverlay(new GraphicsOverlay(this))
+    , m_conflictOverlay(new GraphicsOverlay(this))
     , m_displayUpdateTimer(new QTimer(this))
     , m_flightUpdateTimer(new QTimer(this))
     , m_filterUpdateTimer(new QTimer(this))
+    , m_alerts(new AlertEngine(this))
+    , m_alertHighlightTimer(new QTimer(this))
+    , m_countryTree(new CountryTreeModel(this))
+    , m_flightList(new FlightListModel(this))
+    , m_frameStatsTimer(new QTimer(this))
+    , m_snapshotCacheTimer(new QTimer(this))
 {
-    // Initialize pre-created basemaps for fast switching
-    m_darkBasemap = new Basemap(BasemapStyle::ArcGISHumanGeographyDark, this);
-    m_lightBasemap = new Basemap(BasemapStyle::ArcGISLightGray, this);
+    StartupTimeline::instance().mark("map requested");
+
+    // The light basemap is created on the first switch to it
+    m_darkBasemap = m_map->basemap();
     
     loadConfig();
+    StartupTimeline::instance().mark("config loaded");
     loadCountryMappings();
+
+    if (!m_dataService) {
+        m_dataService = new FlightDataService(this);
+    }
     
     // Connect authentication signals
     connect(m_authManager, &OpenSkyAuthManager::authenticationSuccess,
             this, &FlightTracker::onAuthenticationSuccess);
     connect(m_authManager, &OpenSkyAuthManager::authenticationFailed,
             this, &FlightTracker::onAuthenticationFailed);
+
+    // Tokens are refreshed in the background; a rejected one is refreshed once and the
+    // held requests replayed, so the refresh loop carries on without a gap
+    connect(m_authManager, &OpenSkyAuthManager::accessTokenChanged,
+            m_dataService, &FlightDataSource::setAccessToken);
+    connect(m_dataService, &FlightDataSource::accessTokenRejected,
+            m_authManager, &OpenSkyAuthManager::refreshToken);
     
     // Connect data service signals
-    connect(m_dataService, &FlightDataService::flightDataReceived,
+    connect(m_dataService, &FlightDataSource::flightDataReceived,
             this, &FlightTracker::onFlightDataReceived);
-    connect(m_dataService, &FlightDataService::trackDataReceived,
+    connect(m_dataService, &FlightDataSource::partialFlightDataReceived,
+            this, &FlightTracker::onPartialFlightDataReceived);
+    connect(m_dataService, &FlightDataSource::trackDataReceived,
             this, &FlightTracker::onTrackDataReceived);
-    connect(m_dataService, &FlightDataService::dataFetchFailed,
+    connect(m_dataService, &FlightDataSource::dataFetchFailed,
             this, &FlightTracker::onDataFetchFailed);
+
+    // Country toggles reach the filter as bit flips in the tree's selection
+    connect(m_countryTree, &CountryTreeModel::selectionChanged, this, [this]() {
+        emit selectedCountriesChanged();
+        scheduleFilterUpdate();
+    });
+
+    // Rings around alerting aircraft follow raises, clears and dismissals
+    m_alertHighlightTimer->setSingleShot(true);
+    m_alertHighlightTimer->setInterval(0);
+    connect(m_alertHighlightTimer, &QTimer::timeout, this, &FlightTracker::drawAlertHighlights);
+    connect(m_alerts, &AlertEngine::activeAircraftChanged, m_alertHighlightTimer, qOverload<>(&QTimer::start));
+    connect(m_alerts, &AlertEngine::alertRaised, this, [](AlertEngine::Kind kind, const QString& icao24,
+                                                          const QString& message) {
+        qInfo() << "Alert:" << AlertEngine::kindName(kind) << icao24 << message;
+    });
+
+    // Replayed snapshots take the same path as live data
+    connect(m_replayService, &FlightReplayService::flightDataReceived,
+            this, &FlightTracker::onFlightDataReceived);
+    connect(m_replayService, &FlightReplayService::currentTimeChanged, this, [this]() {
+        updateDisplayTime();
+        emit replayTimeChanged();
+    });
+    connect(m_replayService, &FlightReplayService::playingChanged,
+            this, &FlightTracker::replayStateChanged);
+    connect(m_replayService, &FlightReplayService::replayFinished,
+            this, &FlightTracker::onReplayFinished);
+    connect(m_replayService, &FlightReplayService::replayFailed,
+            this, &FlightTracker::replayFailed);
     
     // Setup timers
     m_displayUpdateTimer->setInterval(1000);
@@ -71,7 +142,33 @@ FlightTracker::FlightTracker(QObject *parent)
     m_filterUpdateTimer->setSingleShot(true);
     m_filterUpdateTimer->setInterval(150); // 150ms debounce
     connect(m_filterUpdateTimer, &QTimer::timeout, this, &FlightTracker::applyFilters);
+
+    // Frame statistics refresh at 2 Hz while the overlay is shown; faster would itself cost frames
+    m_frameStatsTimer->setInterval(500);
+    connect(m_frameStatsTimer, &QTimer::timeout, this, &FlightTracker::frameStatsChanged);
+    connect(m_frameStatsTimer, &QTimer::timeout, this, &FlightTracker::memoryStatsChanged);
     
+    // The last live snapshot is kept for the next launch, periodically and on quit
+    if (!m_snapshotCachePath.isEmpty()) {
+        connect(m_snapshotCacheTimer, &QTimer::timeout, this, [this]() { saveSnapshotCache(false); });
+        m_snapshotCacheTimer->start();
+        connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() { saveSnapshotCache(true); });
+    }
+
+    // Replay a recorded archive instead of the live feed when one is configured
+    if (!m_replayArchivePath.isEmpty() && startReplay(m_replayArchivePath)) {
+        return;
+    }
+
+    // Draw the previous session's flights while authentication and the first download run
+    loadCachedSnapshot();
+
+    // File and synthetic sources need no token, start once QML has finished wiring up the view
+    if (!m_dataService->requiresAuthentication()) {
+        QTimer::singleShot(0, this, &FlightTracker::startDataUpdates);
+        return;
+    }
+
     // Start authentication
     m_authManager->authenticate();
 }
@@ -91,11 +188,131 @@ void FlightTracker::loadConfig()
         
         m_authManager->setCredentials(clientId, clientSecret);
         qDebug() << "OpenSky credentials loaded from config.json";
+
+        // Optional Chrome trace of refresh cycles, written when the app quits
+        QJsonObject trace = config["trace"].toObject();
+        QString tracePath = trace["path"].toString();
+        if (!tracePath.isEmpty()) {
+            if (TraceRecorder::instance().start(tracePath, trace["maxEvents"].toInt(1000000))) {
+                qDebug() << "Tracing refresh cycles to" << tracePath;
+            } else {
+                qWarning() << TraceRecorder::instance().errorString();
+            }
+        }
+
+        m_dataService = createDataSource(config["source"].toObject());
+
+        // Warm start from the last snapshot, on unless turned off
+        QJsonObject warmStart = config["warmStart"].toObject();
+        if (warmStart["enabled"].toBool(true)) {
+            m_snapshotCachePath = warmStart["path"].toString(SnapshotCache::defaultPath());
+            m_snapshotCacheTimer->setInterval(warmStart["saveInterval"].toInt(300) * 1000);
+        }
+
+        // Time from pressing Start to the first drawn map that counts as fast enough
+        m_startupBudgetMs = config["startup"].toObject()["mapBudgetMs"].toDouble(m_startupBudgetMs);
+
+        // Density view for zoomed-out maps; minScale 0 always draws aircraft
+        QJsonObject density = config["density"].toObject();
+        m_densityMinScale = density["minScale"].toDouble(m_densityMinScale);
+        DensityGrid::Options densityOptions;
+        densityOptions.size = density["cells"].toInt(densityOptions.size);
+        densityOptions.blurRadius = density["blurRadius"].toInt(densityOptions.blurRadius);
+        m_densityGrid.setOptions(densityOptions);
+
+        // Alert thresholds
+        QJsonObject alertConfig = config["alerts"].toObject();
+        AlertEngine::Options alertOptions;
+        alertOptions.descentFeetPerMinute = alertConfig["descentFeetPerMinute"].toDouble(alertOptions.descentFeetPerMinute);
+        alertOptions.silentMinAltitudeFeet = alertConfig["silentMinAltitude"].toDouble(alertOptions.silentMinAltitudeFeet);
+        alertOptions.silentExpiryMs = qint64(alertConfig["silentExpiryMinutes"].toDouble(alertOptions.silentExpiryMs / 60000.0) * 60000.0);
+        alertOptions.silentEdgeMarginDegrees = alertConfig["silentEdgeMargin"].toDouble(alertOptions.silentEdgeMarginDegrees);
+        alertOptions.squawkReports = alertConfig["squawkReports"].toInt(alertOptions.squawkReports);
+        alertOptions.descentReports = alertConfig["descentReports"].toInt(alertOptions.descentReports);
+        alertOptions.clearReports = alertConfig["clearReports"].toInt(alertOptions.clearReports);
+        m_alerts->setOptions(alertOptions);
+
+        // Separation minima for proximity detection; horizontalNm 0 turns it off
+        QJsonObject conflictConfig = config["conflicts"].toObject();
+        ConflictDetector::Options conflictOptions;
+        conflictOptions.horizontalNm = conflictConfig["horizontalNm"].toDouble(conflictOptions.horizontalNm);
+        conflictOptions.verticalFeet = conflictConfig["verticalFeet"].toDouble(conflictOptions.verticalFeet);
+        conflictOptions.minAltitudeFeet = conflictConfig["minAltitude"].toDouble(conflictOptions.minAltitudeFeet);
+        m_conflictDetector.setOptions(conflictOptions);
+
+        // Optional replay of a recorded archive
+        QJsonObject replay = config["replay"].toObject();
+        m_replayArchivePath = replay["archive"].toString();
+        m_replayService->setSpeed(replay["speed"].toDouble(1.0));
+        m_replayService->setLoop(replay["loop"].toBool(false));
+
+        // Optional recording of live snapshots
+        QJsonObject recording = config["recording"].toObject();
+        QString recordingPath = recording["archive"].toString();
+        if (!recordingPath.isEmpty()) {
+            if (m_store.startRecording(recordingPath, recording["keyframeInterval"].toInt(30))) {
+                qDebug() << "Recording flight snapshots to" << recordingPath;
+            } else {
+                qWarning() << m_store.recordingError();
+            }
+        }
     } else {
         qWarning() << "Could not open config.json - OpenSky credentials are required";
     }
 }
 
+FlightDataSource* FlightTracker::createDataSource(const QJsonObject& sourceConfig)
+{
+    const QString type = sourceConfig["type"].toString("opensky");
+
+    if (type == "file") {
+        QString path = sourceConfig["path"].toString();
+        qDebug() << "Using fixture data from" << path;
+        return new FileFlightDataSource(path, this);
+    }
+
+    if (type == "synthetic") {
+        TrafficGenerator::Options options;
+        options.seed = quint32(sourceConfig["seed"].toInt(1));
+        options.aircraftCount = sourceConfig["aircraft"].toInt(options.aircraftCount);
+        options.groundFraction = sourceConfig["groundFraction"].toDouble(options.groundFraction);
+        options.churnPerHour = sourceConfig["churnPerHour"].toDouble(options.churnPerHour);
+        options.regionalFraction = sourceConfig["regionalFraction"].toDouble(options.regionalFraction);
+
+        SyntheticFlightDataSource* source = new SyntheticFlightDataSource(options, this);
+        source->setStepSeconds(sourceConfig["step"].toDouble(0.0));
+        source->setEncodeJson(sourceConfig["json"].toBool(false));
+        return source;
+    }
+
+    FlightDataService* service = new FlightDataService(this);
+
+    // Optional split of each refresh into bounding boxes fetched in parallel
+    service->setShardCount(sourceConfig["shards"].toInt(1));
+    const QJsonArray area = sourceConfig["area"].toArray();
+    if (area.size() == 4) {
+        service->setArea(QRectF(QPointF(area[0].toDouble(), area[1].toDouble()),
+                                QPointF(area[2].toDouble(), area[3].toDouble())).normalized());
+        // Aircraft leaving the fetched area are not lost contacts
+        m_alerts->setArea(service->area());
+    }
+
+    if (type == "local") {
+        // A server speaking the OpenSky API, such as tools/OpenSkyStandIn, under one root URL
+        QString root = sourceConfig["url"].toString("http://127.0.0.1:8080");
+        if (root.endsWith('/')) {
+            root.chop(1);
+        }
+        service->setApiUrl(QUrl(root + FlightDataService::defaultApiUrl().path()));
+        m_authManager->setTokenUrl(QUrl(root + OpenSkyAuthManager::defaultTokenUrl().path()));
+        qDebug() << "Using local OpenSky-compatible server at" << root;
+    } else if (type != "opensky") {
+        qWarning() << "Unknown data source type" << type << "- using OpenSky";
+    }
+
+    return service;
+}
+
 MapQuickView *FlightTracker::mapView() const
 {
     return m_mapView;
@@ -111,16 +328,37 @@ void FlightTracker::setMapView(MapQuickView *mapView)
     m_mapView->setMap(m_map);
 
     // Add overlays in correct order
+    m_mapView->graphicsOverlays()->append(m_densityOverlay);
     m_mapView->graphicsOverlays()->append(m_trackOverlay);
+    m_mapView->graphicsOverlays()->append(m_conflictOverlay);
     m_mapView->graphicsOverlays()->append(m_flightOverlay);
+    m_mapView->graphicsOverlays()->append(m_alertOverlay);
     m_mapView->graphicsOverlays()->append(m_selectionOverlay);
 
+    // The startup budget runs until the map first finishes drawing
+    StartupTimeline::instance().mark("map view attached");
+    connect(m_mapView, &MapQuickView::drawStatusChanged, this, [this](DrawStatus status) {
+        StartupTimeline& timeline = StartupTimeline::instance();
+        if (status == DrawStatus::Completed && !timeline.isFinished()) {
+            timeline.mark("first map frame");
+            timeline.finish("map requested", m_startupBudgetMs);
+            emit startupStatsChanged();
+        }
+    });
+
+    // Redraw the selected track at the detail the new scale needs
+    connect(m_mapView, &MapQuickView::mapScaleChanged, this, &FlightTracker::onMapScaleChanged);
+
+    // Frame timing follows the view into whichever window shows it
+    connect(m_mapView, &QQuickItem::windowChanged, this, &FlightTracker::attachFrameTiming);
+    attachFrameTiming();
+
     emit mapViewChanged();
 }
 
 bool FlightTracker::isAuthenticated() const
 {
-    return m_authManager->isAuthenticated();
+    return m_authManager->isAuthenticated() || !m_dataService->requiresAuthentication();
 }
 
 bool FlightTracker::hasSelectedFlight() const
@@ -137,7 +375,10 @@ void FlightTracker::setShowTrack(bool show)
         if (m_showTrack && m_selectedFlight.isValid()) {
             m_dataService->fetchFlightTrack(m_selectedFlight.icao24());
         } else if (!m_showTrack) {
-            m_trackOverlay->graphics()->clear();
+            m_dataService->cancelFlightTracks();
+            m_renderer->clearGraphics(m_trackOverlay);
+            m_selectedTrack = FlightTrack();
+            m_drawnTrackVertexCount = 0;
         }
     }
 }
@@ -147,16 +388,14 @@ void FlightTracker::setIsDarkTheme(bool isDark)
     if (m_isDarkTheme != isDark) {
         m_isDarkTheme = isDark;
         
-        // Switch between pre-created basemaps for fast performance
-        if (m_map && m_darkBasemap && m_lightBasemap) {
-            Basemap* targetBasemap = isDark ? m_darkBasemap : m_lightBasemap;
+        // Basemaps are created on first use and kept for fast switching
+        if (m_map) {
+            Basemap*& targetBasemap = isDark ? m_darkBasemap : m_lightBasemap;
+            if (!targetBasemap) {
+                targetBasemap = new Basemap(isDark ? BasemapStyle::ArcGISHumanGeographyDark
+                                                   : BasemapStyle::ArcGISLightGray, this);
+            }
             m_map->setBasemap(targetBasemap);
-        } else if (m_map) {
-            // Fallback: create basemap on demand if pre-created ones aren't ready
-            BasemapStyle newStyle = isDark ? 
-                BasemapStyle::ArcGISHumanGeographyDark : 
-                BasemapStyle::ArcGISLightGray;
-            m_map->setBasemap(new Basemap(newStyle, this));
         }
         
         // Recreate popup and selection graphic with new theme colors if a flight is selected
@@ -169,21 +408,157 @@ void FlightTracker::setIsDarkTheme(bool isDark)
     }
 }
 
+void FlightTracker::setShowPerformanceOverlay(bool show)
+{
+    if (m_showPerformanceOverlay == show) {
+        return;
+    }
+
+    m_showPerformanceOverlay = show;
+    attachFrameTiming();
+
+    if (show) {
+        m_frameStatsTimer->start();
+    } else {
+        m_frameStatsTimer->stop();
+    }
+
+    emit showPerformanceOverlayChanged();
+}
+
+QVariantMap FlightTracker::frameStats() const
+{
+    QVariantMap stats = m_frameCost.toVariantMap();
+    stats["fps"] = m_frameInterval.count() > 0 && m_frameInterval.mean() > 0.0
+        ? 1000.0 / m_frameInterval.mean() : 0.0;
+    return stats;
+}
+
+QVariantMap FlightTracker::startupStats() const
+{
+    const StartupTimeline& timeline = StartupTimeline::instance();
+    const double requested = timeline.msAt("map requested");
+    const double drawn = timeline.msAt("first map frame");
+
+    QVariantMap stats;
+    stats["mapMs"] = requested >= 0.0 && drawn >= 0.0 ? drawn - requested : -1.0;
+    stats["budgetMs"] = m_startupBudgetMs;
+    stats["marks"] = timeline.toVariantList();
+    return stats;
+}
+
+QVariantMap FlightTracker::memoryStats() const
+{
+    QVariantMap stats = GraphicsGeneration::liveCounts();
+    stats["residentBytes"] = MemoryStats::residentBytes();
+    return stats;
+}
+
+void FlightTracker::attachFrameTiming()
+{
+    for (const QMetaObject::Connection& connection : std::as_const(m_frameConnections)) {
+        disconnect(connection);
+    }
+    m_frameConnections.clear();
+    m_frameCost.clear();
+    m_frameInterval.clear();
+
+    m_frameWindow = m_mapView ? m_mapView->window() : nullptr;
+    if ((!m_showPerformanceOverlay && !TraceRecorder::isEnabled()) || !m_frameWindow) {
+        return;
+    }
+
+    // Frame hooks fire on the render thread, only the results cross back to this object
+    m_frameBegin.invalidate();
+    m_lastFrameEnd.invalidate();
+    m_frameConnections.append(connect(m_frameWindow, &QQuickWindow::beforeFrameBegin, this, [this]() {
+        m_frameBegin.start();
+    }, Qt::DirectConnection));
+    m_frameConnections.append(connect(m_frameWindow, &QQuickWindow::afterFrameEnd, this, [this]() {
+        if (!m_frameBegin.isValid()) {
+            return;
+        }
+
+        const double cost = m_frameBegin.nsecsElapsed() / 1e6;
+        if (TraceRecorder::isEnabled()) {
+            TraceRecorder& recorder = TraceRecorder::instance();
+            recorder.complete("frame", "render", recorder.now() - m_frameBegin.nsecsElapsed());
+        }
+        // Gaps longer than a few frames are idle time, not a frame rate
+        double interval = -1.0;
+        if (m_lastFrameEnd.isValid()) {
+            const double sinceLast = m_lastFrameEnd.nsecsElapsed() / 1e6;
+            if (sinceLast < 250.0) {
+                interval = sinceLast;
+            }
+        }
+        m_lastFrameEnd.start();
+
+        QMetaObject::invokeMethod(this, [this, cost, interval]() {
+            m_frameCost.add(cost);
+            if (interval >= 0.0) {
+                m_frameInterval.add(interval);
+            }
+        }, Qt::QueuedConnection);
+    }, Qt::DirectConnection));
+}
+
 void FlightTracker::fetchFlightData()
 {
+    if (m_isReplaying) {
+        qDebug() << "Replay active, ignoring live fetch";
+        return;
+    }
+
     if (!isAuthenticated()) {
         qDebug() << "Not authenticated, cannot fetch flight data";
         return;
     }
     
     clearFlightSelection();
+    m_refreshTimer.start();
+    beginRefreshTrace();
+    m_dataService->setPriorityArea(visibleLonLatArea());
     m_dataService->fetchFlightData();
 }
 
+QRectF FlightTracker::visibleLonLatArea() const
+{
+    if (!m_mapView) {
+        return QRectF();
+    }
+
+    const Envelope extent = geometry_cast<Envelope>(
+        GeometryEngine::project(m_mapView->visibleArea().extent(), SpatialReference::wgs84()));
+    if (extent.isEmpty()) {
+        return QRectF();
+    }
+
+    // A view across the antimeridian keeps only the part west of it
+    return QRectF(QPointF(extent.xMin(), extent.yMin()), QPointF(extent.xMax(), extent.yMax()))
+        .intersected(FlightShards::world());
+}
+
 void FlightTracker::selectFlightAtPoint(QPointF screenPoint)
 {
-    FlightData flight = findFlightAtPoint(screenPoint);
-    
+    setSelectedFlight(findFlightAtPoint(screenPoint));
+}
+
+void FlightTracker::selectFlight(const QString& icao24)
+{
+    // Picked from the list, which only holds visible flights; the map pans to it
+    const FlightData flight = m_store.flight(icao24);
+    if (!flight.isValid()) {
+        return;
+    }
+    setSelectedFlight(flight);
+    if (m_mapView) {
+        m_mapView->setViewpointCenterAsync(Point(flight.longitude(), flight.latitude(), SpatialReference::wgs84()));
+    }
+}
+
+void FlightTracker::setSelectedFlight(const FlightData& flight)
+{
     if (flight.isValid() && !(flight.icao24() == m_selectedFlight.icao24())) {
         m_selectedFlight = flight;
         createFlightPopup(flight);
@@ -207,20 +582,16 @@ void FlightTracker::clearFlightSelection()
         emit selectedFlightChanged();
         
         // Now safely handle popup deletion
-        if (m_selectedFlightPopup) {
-            Popup* oldPopup = m_selectedFlightPopup;
-            m_selectedFlightPopup = nullptr;
-            QTimer::singleShot(50, oldPopup, &QObject::deleteLater);
-        }
-        
-        // Clear overlays safely
-        if (m_selectionOverlay && m_selectionOverlay->graphics()) {
-            m_selectionOverlay->graphics()->clear();
-        }
+        releaseFlightPopup();
         
-        if (m_trackOverlay && m_trackOverlay->graphics()) {
-            m_trackOverlay->graphics()->clear();
-        }
+        // A track still on its way is for a selection that no longer exists
+        m_dataService->cancelFlightTracks();
+
+        // Clear overlays safely, releasing their graphics and symbols
+        m_renderer->clearGraphics(m_selectionOverlay);
+        m_renderer->clearGraphics(m_trackOverlay);
+        m_selectedTrack = FlightTrack();
+        m_drawnTrackVertexCount = 0;
         
     } catch (...) {
         qDebug() << "Exception in clearFlightSelection";
@@ -241,6 +612,110 @@ QVariantList FlightTracker::getSelectedFlightData()
     return result;
 }
 
+bool FlightTracker::isReplayPaused() const
+{
+    return m_isReplaying && !m_replayService->isPlaying() && !m_replayService->isFinished();
+}
+
+bool FlightTracker::isReplayFinished() const
+{
+    return m_isReplaying && m_replayService->isFinished();
+}
+
+double FlightTracker::replaySpeed() const
+{
+    return m_replayService->speed();
+}
+
+void FlightTracker::setReplaySpeed(double speed)
+{
+    if (m_replayService->speed() != speed) {
+        m_replayService->setSpeed(speed);
+        emit replaySpeedChanged();
+    }
+}
+
+QDateTime FlightTracker::replayTime() const
+{
+    const qint64 timestamp = m_replayService->currentTime();
+    return timestamp > 0 ? QDateTime::fromMSecsSinceEpoch(timestamp) : QDateTime();
+}
+
+bool FlightTracker::startReplay(const QString& archivePath)
+{
+    if (!m_replayService->open(archivePath)) {
+        return false;
+    }
+
+    m_flightUpdateTimer->stop();
+    m_isReplaying = true;
+    m_alerts->reset();
+    m_replayService->start();
+
+    qDebug() << "Replaying" << archivePath << "at" << m_replayService->speed() << "x";
+    emit replayStateChanged();
+    return true;
+}
+
+void FlightTracker::stopReplay()
+{
+    if (!m_isReplaying) {
+        return;
+    }
+
+    m_replayService->close();
+    m_isReplaying = false;
+    m_alerts->reset();
+    emit replayStateChanged();
+
+    // Hand back to the live feed
+    if (isAuthenticated()) {
+        fetchFlightData();
+        m_flightUpdateTimer->start();
+    } else {
+        m_authManager->authenticate();
+    }
+}
+
+void FlightTracker::pauseReplay()
+{
+    m_replayService->pause();
+}
+
+void FlightTracker::resumeReplay()
+{
+    if (isReplayFinished()) {
+        restartReplay();
+        return;
+    }
+    m_replayService->resume();
+}
+
+void FlightTracker::restartReplay()
+{
+    if (!m_isReplaying) {
+        return;
+    }
+    // The alert state belongs to the run that just ended
+    m_alerts->reset();
+    m_replayService->start();
+    emit replayStateChanged();
+}
+
+void FlightTracker::seekReplay(const QDateTime& time)
+{
+    if (m_isReplaying && time.isValid()) {
+        m_replayService->seek(time.toMSecsSinceEpoch());
+        emit replayStateChanged();
+    }
+}
+
+void FlightTracker::onReplayFinished()
+{
+    qDebug() << "Replay finished at" << replayTime().toString(Qt::ISODate);
+    emit replayStateChanged();
+}
+
 Popup* FlightTracker::selectedFlightPopup() const
 {
     // Return popup only if it's still valid and hasn't been marked for deletion
@@ -249,11 +724,8 @@ Popup* FlightTracker::selectedFlightPopup() const
 
 void FlightTracker::setSelectedCountries(const QStringList& countries)
 {
-    if (m_selectedCountries != countries) {
-        m_selectedCountries = countries;
-        emit selectedCountriesChanged();
-        scheduleFilterUpdate();
-    }
+    // Reported back through the tree's selectionChanged
+    m_countryTree->setSelectedCountries(countries);
 }
 
 void FlightTracker::setSelectedFlightStatus(const QString& status)
@@ -312,10 +784,15 @@ void FlightTracker::setSelectedVerticalStatus(const QString& status)
 
 void FlightTracker::onAuthenticationSuccess()
 {
-    m_dataService->setAccessToken(m_authManager->accessToken());
+    StartupTimeline::instance().mark("authenticated");
     emit authenticationSuccess();
     emit authenticationChanged();
-    
+
+    startDataUpdates();
+}
+
+void FlightTracker::startDataUpdates()
+{
     // If dev mode is enabled, create dummy flight data immediately for testing
     if (m_devMode) {
         QList<FlightData> dummyFlights;
@@ -360,11 +837,43 @@ void FlightTracker::onAuthenticationFailed(const QString& error)
 
 void FlightTracker::onFlightDataReceived(const QList<FlightData>& flights)
 {
+    // Late live replies must not interleave with a replay
+    if (m_isReplaying && sender() != m_replayService) {
+        return;
+    }
+
     if (m_isUpdatingFlights) {
+        if (m_isReplaying) {
+            m_replayService->acknowledgeSnapshot();
+        }
         return;
     }
     
     m_isUpdatingFlights = true;
+
+    // Live or replayed data replaces the cached snapshot shown at launch
+    if (sender()) {
+        m_hasReceivedData = true;
+        setStale(false);
+    }
+
+    TraceScope trace("prepare", "pipeline", QString::number(flights.size()));
+    QElapsedTimer prepareTimer;
+    prepareTimer.start();
+
+    // Replayed snapshots start their refresh here
+    if (!m_refreshTimer.isValid()) {
+        m_refreshTimer.start();
+        beginRefreshTrace();
+    }
+
+    if (sender() == m_dataService) {
+        const FlightDataSource::FetchTiming timing = m_dataService->lastFetchTiming();
+        m_pipelineStats.record(PipelineStats::Fetch, timing.fetchMs);
+        m_pipelineStats.record(PipelineStats::Decode, timing.decodeMs);
+        recordSnapshot(flights);
+        m_lastLiveFlights = flights;
+    }
     
     try {
         // Clear selection first to avoid dangling references
@@ -372,7 +881,7 @@ void FlightTracker::onFlightDataReceived(const QList<FlightData>& flights)
             clearFlightSelection();
         }
         
-        m_flights = flights;
+        QList<FlightData> current = flights;
         
         // Add dummy flight data for testing when dev mode is enabled
         if (m_devMode) {
@@ -397,9 +906,17 @@ void FlightTracker::onFlightDataReceived(const QList<FlightData>& flights)
             dummyData.append(0);               // [16] position_source (unused)
             
             FlightData dummyFlight(dummyData);
-            m_flights.append(dummyFlight);
+            current.append(dummyFlight);
         }
         
+        const FlightSnapshotDelta delta = m_store.ingest(current);
+        m_flightList->update(m_store);
+        m_alerts->process(delta, m_isReplaying ? m_replayService->currentTime()
+                                               : QDateTime::currentMSecsSinceEpoch());
+        m_alertHighlightTimer->start();
+        detectConflicts();
+        emit flightsUpdated();
+
         m_lastUpdateDateTime = QDateTime::currentDateTime();
         updateDisplayTime();
         
@@ -408,18 +925,42 @@ void FlightTracker::onFlightDataReceived(const QList<FlightData>& flights)
             return;
         }
         
-        // Clear existing graphics first
-        m_flightOverlay->graphics()->clear();
+        // Clear existing graphics first, releasing the previous refresh's graphics and symbols
+        m_renderer->clearGraphics(m_flightOverlay);
         
         // Update graphics after a brief delay to ensure UI is ready
-        QTimer::singleShot(50, this, [this, flights]() {
+        QElapsedTimer delayTimer;
+        delayTimer.start();
+        const quint64 delayTraceId = TraceRecorder::isEnabled() ? TraceRecorder::nextId() : 0;
+        if (delayTraceId) {
+            TraceRecorder::instance().asyncBegin("render delay", "pipeline", delayTraceId);
+        }
+        QTimer::singleShot(50, this, [this, flights, delayTimer, delayTraceId]() {
+            m_pipelineStats.record(PipelineStats::RenderDelay, delayTimer.nsecsElapsed() / 1e6);
+            if (delayTraceId && TraceRecorder::isEnabled()) {
+                TraceRecorder::instance().asyncEnd("render delay", "pipeline", delayTraceId);
+            }
+
             try {
+                TraceScope renderTrace("render", "pipeline", QString::number(flights.size()));
+                QElapsedTimer graphicsTimer;
+                graphicsTimer.start();
                 m_renderer->updateFlightGraphics(m_flightOverlay, flights);
+                m_pipelineStats.record(PipelineStats::Graphics, graphicsTimer.nsecsElapsed() / 1e6);
+                StartupTimeline::instance().mark("first flights drawn");
                 m_isUpdatingFlights = false;
             } catch (...) {
                 qDebug() << "Exception updating flight graphics";
                 m_isUpdatingFlights = false;
             }
+
+            // A replay only advances once the snapshot has been rendered and filtered,
+            // so filters are applied now rather than after the debounce
+            if (m_isReplaying) {
+                m_filterUpdateTimer->stop();
+                applyFilters();
+                m_replayService->acknowledgeSnapshot();
+            }
         });
         
     } catch (...) {
@@ -428,45 +969,16 @@ void FlightTracker::onFlightDataReceived(const QList<FlightData>& flights)
         return;
     }
     
-    // Process countries and update available countries on initial load
-    if (m_isInitialLoad) {
-        QMap<QString, QStringList> continentsWithCountries;
-        QSet<QString> uniqueCountries;
-        
-        for (const FlightData& flight : flights) {
-            QString country = extractCountryFromFlight(flight);
-            if (!country.isEmpty() && !uniqueCountries.contains(country)) {
-                uniqueCountries.insert(country);
-                QString continent = getCountryContinent(country);
-                continentsWithCountries[continent].append(country);
-            }
-        }
-        
-        // Sort countries within each continent
-        for (auto& countries : continentsWithCountries) {
-            std::sort(countries.begin(), countries.end());
-        }
-        
-        // Convert to QVariantMap for QML
-        QVariantMap availableCountries;
-        for (auto it = continentsWithCountries.begin(); it != continentsWithCountries.end(); ++it) {
-            availableCountries[it.key()] = QVariant::fromValue(it.value());
-        }
-        
-        m_availableCountries = availableCountries;
-        
-        // Initialize selected countries to all countries
-        QStringList allCountries = uniqueCountries.values();
-        std::sort(allCountries.begin(), allCountries.end());
-        m_selectedCountries = allCountries;
-        
+    // The filter's countries follow the store: rebuilt on the first load and whenever a country
+    // turns up for the first time, otherwise only the running counts are passed on
+    if (m_isInitialLoad || m_store.hasNewCountries()) {
+        ensureCountryMappings();
+        setAvailableCountries(m_store.countriesByContinent());
         m_isInitialLoad = false;
-        
-        emit availableCountriesChanged();
-        emit selectedCountriesChanged();
-        
-        qDebug() << "Populated" << uniqueCountries.size() << "countries";
+    } else {
+        m_countryTree->updateFlightCounts(m_store.stats());
     }
+    emit trafficStatsChanged();
     
     // Restore selection if possible
     if (m_selectedFlight.isValid()) {
@@ -480,17 +992,152 @@ void FlightTracker::onFlightDataReceived(const QList<FlightData>& flights)
         }
     }
     
+    m_pipelineStats.record(PipelineStats::Prepare, prepareTimer.nsecsElapsed() / 1e6);
+
     // Apply current filters using debounced approach
     scheduleFilterUpdate();
     
     qDebug() << "Updated" << flights.size() << "flights on map";
 }
 
+void FlightTracker::onPartialFlightDataReceived(const QList<FlightData>& flights)
+{
+    // Only the first load is drawn early. Later refreshes keep the previous snapshot on
+    // screen until the merged one replaces it, rather than blanking everything off-screen.
+    if (m_isReplaying || m_isUpdatingFlights || !m_store.isEmpty() || !m_renderer || !m_flightOverlay) {
+        return;
+    }
+
+    try {
+        TraceScope trace("first paint", "pipeline", QString::number(flights.size()));
+        m_renderer->clearGraphics(m_flightOverlay);
+        m_renderer->updateFlightGraphics(m_flightOverlay, flights);
+    } catch (...) {
+        qDebug() << "Exception drawing partial flight data";
+    }
+}
+
 void FlightTracker::onTrackDataReceived(const QString& icao24, const QJsonObject& trackData)
 {
     if (m_selectedFlight.isValid() && m_selectedFlight.icao24() == icao24) {
-        m_renderer->drawFlightTrack(m_trackOverlay, trackData);
+        TraceScope trace("build track", "track", icao24);
+        // Simplification importance is computed once here and reused at every scale
+        m_selectedTrack = FlightTrack::fromJson(trackData);
+        m_drawnTrackVertexCount = 0;
+        drawSelectedTrack();
+    }
+}
+
+double FlightTracker::trackToleranceMeters() const
+{
+    constexpr double tolerancePixels = 1.0;
+    return m_mapView ? m_mapView->unitsPerDIP() * tolerancePixels : 0.0;
+}
+
+void FlightTracker::drawSelectedTrack()
+{
+    if (!m_showTrack || m_selectedTrack.isEmpty()) {
+        return;
+    }
+
+    // Skip the redraw when the zoom change keeps the same vertex subset
+    const double tolerance = trackToleranceMeters();
+    if (m_drawnTrackVertexCount == m_selectedTrack.vertexCountForTolerance(tolerance)) {
+        return;
+    }
+
+    TraceScope trace("draw track", "track", m_selectedTrack.icao24());
+
+    m_drawnTrackVertexCount = m_renderer->drawFlightTrack(m_trackOverlay, m_selectedTrack, tolerance);
+}
+
+void FlightTracker::onMapScaleChanged()
+{
+    drawSelectedTrack();
+    updateDensityMode();
+}
+
+void FlightTracker::updateDensityMode()
+{
+    if (!m_mapView) {
+        return;
+    }
+
+    const bool show = m_densityMinScale > 0.0 && m_mapView->mapScale() >= m_densityMinScale;
+    if (show == m_showDensity) {
+        // Zooming only rescales the image; it is rebuilt with the next snapshot
+        if (show) {
+            m_renderer->resizeDensity(m_mapView->unitsPerDIP());
+        }
+        return;
+    }
+
+    // The aircraft graphics stay up to date underneath, so switching back is immediate
+    m_showDensity = show;
+    m_flightOverlay->setVisible(!show);
+    m_densityOverlay->setVisible(show);
+    if (show) {
+        drawDensity();
+    } else {
+        m_renderer->clearGraphics(m_densityOverlay);
     }
+    emit showDensityChanged();
+}
+
+void FlightTracker::drawAlertHighlights()
+{
+    // Highlighted whatever the filter, since an alert matters more than the current view
+    QList<FlightData> alerting;
+    for (const QString& icao24 : m_alerts->activeAircraft()) {
+        const FlightData flight = m_store.flight(icao24);
+        if (flight.isValid()) {
+            alerting.append(flight);
+        }
+    }
+    m_renderer->drawAlertHighlights(m_alertOverlay, alerting);
+}
+
+void FlightTracker::detectConflicts()
+{
+    QElapsedTimer conflictTimer;
+    conflictTimer.start();
+    const QList<FlightData>& flights = m_store.flights();
+    m_conflictDetector.detect(flights);
+    const QList<ConflictDetector::Conflict>& found = m_conflictDetector.conflicts();
+    m_renderer->drawConflicts(m_conflictOverlay, flights, found);
+
+    // QML gets the nearest pairs with the indexes resolved, since the store moves on
+    constexpr qsizetype maxListed = 50;
+    m_conflicts.clear();
+    for (qsizetype i = 0; i < found.size() && i < maxListed; ++i) {
+        const ConflictDetector::Conflict& conflict = found[i];
+        const FlightData& first = flights[conflict.first];
+        const FlightData& second = flights[conflict.second];
+        m_conflicts.append(QVariantMap{
+            {"first", first.icao24()},
+            {"firstCallsign", first.callsign().trimmed()},
+            {"second", second.icao24()},
+            {"secondCallsign", second.callsign().trimmed()},
+            {"distanceNm", conflict.distanceNm},
+            {"verticalFeet", conflict.verticalFeet},
+            {"closureKnots", conflict.closureKnots}
+        });
+    }
+    m_pipelineStats.record(PipelineStats::Conflicts, conflictTimer.nsecsElapsed() / 1e6);
+    emit conflictsChanged();
+}
+
+void FlightTracker::drawDensity()
+{
+    if (!m_mapView) {
+        return;
+    }
+
+    QElapsedTimer densityTimer;
+    densityTimer.start();
+    m_densityGrid.build(m_store.flights(), m_store.visibility());
+    m_renderer->drawDensity(m_densityOverlay, m_densityGrid, m_mapView->unitsPerDIP());
+    m_pipelineStats.record(PipelineStats::Density, densityTimer.nsecsElapsed() / 1e6);
 }
 
 void FlightTracker::onDataFetchFailed(const QString& error)
@@ -500,7 +1147,11 @@ void FlightTracker::onDataFetchFailed(const QString& error)
 
 void FlightTracker::updateDisplayTime()
 {
-    if (!m_lastUpdateDateTime.isValid()) {
+    if (m_isReplaying) {
+        // Replays show the recorded clock rather than wall time
+        QDateTime recorded = replayTime();
+        m_lastUpdateTime = recorded.isValid() ? recorded.toString("HH:mm:ss") : "Replay";
+    } else if (!m_lastUpdateDateTime.isValid()) {
         m_lastUpdateTime = "Never";
     } else {
         qint64 secondsAgo = m_lastUpdateDateTime.secsTo(QDateTime::currentDateTime());
@@ -519,28 +1170,25 @@ void FlightTracker::updateDisplayTime()
 
 FlightData FlightTracker::findFlightAtPoint(QPointF screenPoint)
 {
-    if (!m_mapView || m_flights.isEmpty()) {
+    if (!m_mapView || m_store.isEmpty()) {
         return FlightData();
     }
 
     constexpr double tolerancePixels = 15.0;
-    GraphicListModel* graphics = m_flightOverlay->graphics();
-    
-    for (int i = 0; i < graphics->size() && i < m_flights.size(); ++i) {
-        Graphic* graphic = graphics->at(i);
-        if (!graphic || !graphic->isVisible()) continue;
-        
-        const FlightData& flight = m_flights[i];
-        Point flightPoint(flight.longitude(), flight.latitude(), SpatialReference::wgs84());
-        QPointF flightScreen = m_mapView->locationToScreen(flightPoint);
-        
-        double distance = QLineF(screenPoint, flightScreen).length();
-        if (distance <= tolerancePixels) {
-            return flight;
-        }
+
+    const Point location = geometry_cast<Point>(GeometryEngine::project(
+        m_mapView->screenToLocation(screenPoint.x(), screenPoint.y()), SpatialReference::wgs84()));
+    if (location.isEmpty()) {
+        return FlightData();
     }
-    
-    return FlightData();
+
+    // Only flights that passed the filter and have a graphic can be picked
+    if (m_showDensity) {
+        return FlightData();
+    }
+    const int index = m_store.hitTest(location.x(), location.y(), tolerancePixels * m_mapView->unitsPerDIP(),
+                                      m_flightOverlay->graphics()->size());
+    return index >= 0 ? m_store.flights()[index] : FlightData();
 }
 
 void FlightTracker::createFlightPopup(const FlightData& flight)
@@ -549,17 +1197,17 @@ void FlightTracker::createFlightPopup(const FlightData& flight)
     
     try {
         // Clear previous popup safely (matching old implementation)
-        if (m_selectedFlightPopup) {
-            qDebug() << "Cleaning up existing popup";
-            Popup* oldPopup = m_selectedFlightPopup;
-            m_selectedFlightPopup = nullptr;
-            QTimer::singleShot(50, oldPopup, &QObject::deleteLater);
-        }
+        releaseFlightPopup();
 
         QString title = flight.callsign().isEmpty() ?
                        QString("Flight %1").arg(flight.icao24().left(6)) : flight.callsign();
 
-        PopupDefinition* popupDef = new PopupDefinition(this);
+        // The popup, its definition and elements are released together, and never outlive
+        // the flight graphic they show
+        GraphicsGeneration* popupOwner = new GraphicsGeneration(m_renderer->generation(m_flightOverlay));
+        m_popupGeneration = popupOwner;
+
+        PopupDefinition* popupDef = new PopupDefinition(popupOwner);
         popupDef->setTitle(title);
 
         // Theme-aware colors
@@ -595,7 +1243,7 @@ void FlightTracker::createFlightPopup(const FlightData& flight)
 
         htmlContent += "</table></div>";
 
-        TextPopupElement* textElement = new TextPopupElement(htmlContent, this);
+        TextPopupElement* textElement = new TextPopupElement(htmlContent, popupOwner);
         QList<PopupElement*> elements;
         elements.append(textElement);
         popupDef->setElements(elements);
@@ -605,108 +1253,86 @@ void FlightTracker::createFlightPopup(const FlightData& flight)
         Graphic* flightGraphic = nullptr;
         
         // Find the graphic for this flight
-        for (int i = 0; i < graphics->size() && i < m_flights.size(); ++i) {
-            const FlightData& flightData = m_flights[i];
-            if (flightData.icao24() == flight.icao24()) {
-                flightGraphic = graphics->at(i);
-                break;
-            }
+        const int index = m_store.indexOf(flight.icao24());
+        if (index >= 0 && index < graphics->size()) {
+            flightGraphic = graphics->at(index);
         }
         
         if (!flightGraphic) {
             qDebug() << "Failed to find graphic for popup";
+            releaseFlightPopup();
             return;
         }
         
         // Create popup from the existing graphic (like old implementation)
-        m_selectedFlightPopup = new Popup(flightGraphic, popupDef, this);
+        m_selectedFlightPopup = new Popup(flightGraphic, popupDef, popupOwner);
+        popupOwner->track(GraphicsGeneration::Popups);
         qDebug() << "Popup created successfully from existing graphic";
         
         emit selectedFlightChanged();
         
     } catch (const std::exception& e) {
         qDebug() << "Exception creating popup:" << e.what();
-        m_selectedFlightPopup = nullptr;
+        releaseFlightPopup();
     } catch (...) {
         qDebug() << "Unknown exception creating popup";
-        m_selectedFlightPopup = nullptr;
+        releaseFlightPopup();
     }
 }
 
-void FlightTracker::loadCountryMappings()
+void FlightTracker::releaseFlightPopup()
 {
-    QFile file(":/resources/countries.json");
-    if (!file.open(QIODevice::ReadOnly)) {
-        qDebug() << "Could not open countries.json file";
-        return;
-    }
+    m_selectedFlightPopup = nullptr;
 
-    QByteArray data = file.readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    QJsonArray countries = doc.array();
-
-    for (const QJsonValue& value : countries) {
-        QJsonObject country = value.toObject();
-        QString countryName = country["country"].toString();
-
-        QJsonValue continentValue = country["continent"];
-        QString continent;
-
-        if (continentValue.isArray()) {
-            QJsonArray continentArray = continentValue.toArray();
-            if (!continentArray.isEmpty()) {
-                continent = continentArray[0].toString();
-            }
-        } else {
-            continent = continentValue.toString();
-        }
-
-        if (!countryName.isEmpty() && !continent.isEmpty()) {
-            m_countryToContinentMap[countryName] = continent;
-        }
+    if (m_popupGeneration) {
+        QTimer::singleShot(50, m_popupGeneration.data(), &QObject::deleteLater);
+        m_popupGeneration = nullptr;
     }
-
-    qDebug() << "Loaded" << m_countryToContinentMap.size() << "country mappings";
 }
 
-QString FlightTracker::extractCountryFromFlight(const FlightData& flight)
+void FlightTracker::loadCountryMappings()
 {
-    QString country = flight.country().trimmed();
-    return country.isEmpty() ? QString() : country;
+    // Parsed on the thread pool; nothing needs it before the first snapshot arrives
+    m_countryMappingsLoad = QtConcurrent::run([]() {
+        CountryRegistry registry;
+        if (!registry.load(":/resources/countries.json")) {
+            qDebug() << "Could not open countries.json file";
+        }
+        return registry;
+    });
 }
 
-QString FlightTracker::getCountryContinent(const QString& country)
+void FlightTracker::ensureCountryMappings()
 {
-    QString exactMatch = m_countryToContinentMap.value(country, QString());
-    if (!exactMatch.isEmpty()) {
-        return exactMatch;
+    if (!m_countryMappingsLoad.isValid()) {
+        return;
     }
 
-    QString lowerCountry = country.toLower();
+    // Waits only if the first snapshot beat the parse
+    m_store.setCountries(m_countryMappingsLoad.result());
+    m_countryMappingsLoad = QFuture<CountryRegistry>();
+    StartupTimeline::instance().mark("country mappings loaded");
 
-    if (lowerCountry == "republic of korea") {
-        return m_countryToContinentMap.value("South Korea", "Asia");
-    }
-
-    for (auto it = m_countryToContinentMap.begin(); it != m_countryToContinentMap.end(); ++it) {
-        QString jsonCountryName = it.key().toLower();
-        QString continent = it.value();
+    qDebug() << "Loaded" << m_store.countries().size() << "country mappings";
+}
 
-        if (lowerCountry.contains(jsonCountryName) || jsonCountryName.contains(lowerCountry)) {
-            return continent;
-        }
+void FlightTracker::setAvailableCountries(const QMap<QString, QStringList>& continentsWithCountries)
+{
+    // Convert to QVariantMap for QML
+    QVariantMap availableCountries;
+    for (auto it = continentsWithCountries.begin(); it != continentsWithCountries.end(); ++it) {
+        availableCountries[it.key()] = QVariant::fromValue(it.value());
     }
+    
+    m_availableCountries = availableCountries;
 
-    // Handle common name variations
-    if (lowerCountry.contains("republic of korea")) return "Asia";
-    if (lowerCountry.contains("democratic people's republic of korea")) return "Asia";
-    if (lowerCountry.contains("netherlands")) return "Europe";
-    if (lowerCountry.contains("korea")) return "Asia";
-    if (lowerCountry.contains("moldova")) return "Europe";
-    if (lowerCountry.contains("russia")) return "Europe";
-    if (lowerCountry.contains("vietnam") || lowerCountry.contains("viet nam")) return "Asia";
+    // New countries start selected; ones the user turned off stay off
+    m_countryTree->setCountries(continentsWithCountries);
+    m_countryTree->updateFlightCounts(m_store.stats());
 
-    return "Other";
+    emit availableCountriesChanged();
+    
+    qDebug() << "Populated" << m_countryTree->countryCount() << "countries";
 }
 
 void FlightTracker::applyFilters()
@@ -723,13 +1349,22 @@ void FlightTracker::applyFilters()
     }
 
     int graphicsCount = graphics->size();
-    int flightsCount = m_flights.size();
+    int flightsCount = m_store.size();
     
     qDebug() << "Applying filters to" << graphicsCount << "graphics and" << flightsCount << "flights";
 
     // Use the smaller of the two sizes to avoid out-of-bounds access
     int maxCount = qMin(graphicsCount, flightsCount);
 
+    TraceScope trace("filter", "pipeline", QString::number(maxCount));
+    QElapsedTimer filterTimer;
+    filterTimer.start();
+
+    m_store.setFilter(currentFilter());
+    m_flightList->update(m_store);
+    const QList<FlightData>& flights = m_store.flights();
+    const QList<bool>& visibility = m_store.visibility();
+
     for (int i = 0; i < maxCount; ++i) {
         Graphic* graphic = graphics->at(i);
         if (!graphic) {
@@ -737,79 +1372,13 @@ void FlightTracker::applyFilters()
             continue;
         }
 
-        if (i >= m_flights.size()) {
-            qDebug() << "Flight index out of bounds:" << i;
-            break;
-        }
-
-        const FlightData& flight = m_flights[i];
+        const FlightData& flight = flights[i];
         if (!flight.isValid()) {
             qDebug() << "Invalid flight data at index" << i;
             continue;
         }
         
-        bool shouldShow = true;
-
-        // Check country filter
-        if (m_selectedCountries.isEmpty()) {
-            // No countries selected - hide all flights
-            shouldShow = false;
-        } else {
-            // Get all available countries to check if all are selected
-            QStringList allAvailableCountries;
-            for (auto it = m_availableCountries.begin(); it != m_availableCountries.end(); ++it) {
-                QStringList continentCountries = it.value().toStringList();
-                allAvailableCountries.append(continentCountries);
-            }
-            
-            // Only apply country filter if not all countries are selected
-            if (m_selectedCountries.size() != allAvailableCountries.size()) {
-                QString country = extractCountryFromFlight(flight);
-                bool countryMatch = country.isEmpty() || m_selectedCountries.contains(country);
-                shouldShow = shouldShow && countryMatch;
-            }
-            // If all countries are selected, don't filter by country (shouldShow remains unchanged)
-        }
-
-        // Check status filter
-        if (m_selectedFlightStatus != "All") {
-            bool statusMatch = true;
-            if (m_selectedFlightStatus == "Airborne") {
-                statusMatch = !flight.onGround();
-            } else if (m_selectedFlightStatus == "OnGround") {
-                statusMatch = flight.onGround();
-            }
-            shouldShow = shouldShow && statusMatch;
-        }
-
-        // Check altitude filter
-        double altitudeFeet = flight.altitude() * 3.28084; // Convert to feet
-        if (altitudeFeet >= 0) { // Only filter if altitude is valid
-            bool altitudeMatch = (altitudeFeet >= m_minAltitudeFilter && altitudeFeet <= m_maxAltitudeFilter);
-            shouldShow = shouldShow && altitudeMatch;
-        }
-
-        // Check speed filter
-        double speedKnots = flight.velocity() * 1.94384; // Convert to knots
-        if (speedKnots >= 0) { // Only filter if speed is valid
-            bool speedMatch = (speedKnots >= m_minSpeedFilter && speedKnots <= m_maxSpeedFilter);
-            shouldShow = shouldShow && speedMatch;
-        }
-
-        // Check vertical status filter
-        if (m_selectedVerticalStatus != "All") {
-            double verticalRate = flight.verticalRate();
-            bool verticalMatch = true;
-            
-            if (m_selectedVerticalStatus == "Climbing") {
-                verticalMatch = (verticalRate > 0.5);
-            } else if (m_selectedVerticalStatus == "Descending") {
-                verticalMatch = (verticalRate < -0.5);
-            } else if (m_selectedVerticalStatus == "Level") {
-                verticalMatch = (verticalRate >= -0.5 && verticalRate <= 0.5);
-            }
-            shouldShow = shouldShow && verticalMatch;
-        }
+        const bool shouldShow = visibility[i];
 
         // Safely set visibility
         try {
@@ -825,12 +1394,160 @@ void FlightTracker::applyFilters()
         }
     }
 
+    m_pipelineStats.record(PipelineStats::Filter, filterTimer.nsecsElapsed() / 1e6);
+
+    // The density image follows the snapshot and the filter, like the symbols it stands in for
+    if (m_showDensity) {
+        drawDensity();
+    }
+
+    // A refresh ends once its filters are applied
+    if (m_refreshTimer.isValid()) {
+        m_pipelineStats.record(PipelineStats::Refresh, m_refreshTimer.nsecsElapsed() / 1e6);
+        m_refreshTimer.invalidate();
+    }
+    if (m_refreshTraceId && TraceRecorder::isEnabled()) {
+        TraceRecorder::instance().asyncEnd("refresh", "pipeline", m_refreshTraceId);
+    }
+    m_refreshTraceId = 0;
+    emit pipelineStatsChanged();
+    emit memoryStatsChanged();
+
     qDebug() << "Filter application completed";
 }
 
+FlightFilter FlightTracker::currentFilter() const
+{
+    FlightFilter filter;
+    filter.setCountrySelection(m_countryTree->countryIds(), m_countryTree->selection());
+    filter.setStatus(m_selectedFlightStatus);
+    filter.setAltitudeRange(m_minAltitudeFilter, m_maxAltitudeFilter);
+    filter.setSpeedRange(m_minSpeedFilter, m_maxSpeedFilter);
+    filter.setVerticalStatus(m_selectedVerticalStatus);
+    return filter;
+}
+
+void FlightTracker::recordSnapshot(const QList<FlightData>& flights)
+{
+    if (m_store.isRecording() && !m_store.record(flights, QDateTime::currentMSecsSinceEpoch())) {
+        qWarning() << m_store.recordingError();
+    }
+}
+
+void FlightTracker::beginRefreshTrace()
+{
+    // A refresh that never reached applyFilters is closed where the next one starts
+    if (m_refreshTraceId && TraceRecorder::isEnabled()) {
+        TraceRecorder::instance().asyncEnd("refresh", "pipeline", m_refreshTraceId, "superseded");
+    }
+    m_refreshTraceId = 0;
+
+    if (TraceRecorder::isEnabled()) {
+        m_refreshTraceId = TraceRecorder::nextId();
+        TraceRecorder::instance().asyncBegin("refresh", "pipeline", m_refreshTraceId,
+                                             m_isReplaying ? "replay" : "live");
+    }
+}
+
+void FlightTracker::loadCachedSnapshot()
+{
+    if (m_snapshotCachePath.isEmpty()) {
+        return;
+    }
+
+    // Decoded on the thread pool so a large cache does not hold up the first frame
+    auto *watcher = new QFutureWatcher<SnapshotCache::Contents>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        showCachedSnapshot(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run([path = m_snapshotCachePath]() {
+        SnapshotCache::Contents contents;
+        SnapshotCache::load(path, contents);
+        return contents;
+    }));
+}
+
+void FlightTracker::showCachedSnapshot(const SnapshotCache::Contents& cached)
+{
+    // Too late once a source or replay has delivered, or while a refresh is being drawn
+    if (cached.snapshot.flights.isEmpty() || m_hasReceivedData || m_isReplaying || m_isUpdatingFlights
+        || !m_renderer || !m_flightOverlay) {
+        return;
+    }
+
+    TraceScope trace("warm start", "pipeline", QString::number(cached.snapshot.flights.size()));
+    qDebug() << "Showing" << cached.snapshot.flights.size() << "cached flights from"
+             << QDateTime::fromMSecsSinceEpoch(cached.snapshot.timestamp).toString(Qt::ISODate);
+
+    // Drawn straight away; the first live snapshot replaces it through the normal path
+    m_store.ingest(cached.snapshot.flights);
+    m_flightList->update(m_store);
+    emit flightsUpdated();
+    m_renderer->clearGraphics(m_flightOverlay);
+    m_renderer->updateFlightGraphics(m_flightOverlay, cached.snapshot.flights);
+    StartupTimeline::instance().mark("cached flights drawn");
+
+    // The cached country list stands in until the first live snapshot derives it again,
+    // so m_isInitialLoad stays set
+    setAvailableCountries(cached.countriesByContinent);
+    emit trafficStatsChanged();
+
+    m_lastUpdateDateTime = QDateTime::fromMSecsSinceEpoch(cached.snapshot.timestamp);
+    setStale(true);
+    updateDisplayTime();
+    scheduleFilterUpdate();
+}
+
+void FlightTracker::saveSnapshotCache(bool synchronous)
+{
+    // Only live data is worth showing next time, and only once per snapshot
+    if (m_snapshotCachePath.isEmpty() || m_isReplaying || m_isStale || m_lastLiveFlights.isEmpty()
+        || !m_lastUpdateDateTime.isValid() || m_lastUpdateDateTime == m_snapshotCacheSavedAt) {
+        return;
+    }
+
+    if (m_snapshotCacheSave.isRunning()) {
+        if (!synchronous) {
+            return;
+        }
+        m_snapshotCacheSave.waitForFinished();
+    }
+
+    SnapshotCache::Contents contents;
+    contents.snapshot.timestamp = m_lastUpdateDateTime.toMSecsSinceEpoch();
+    contents.snapshot.flights = m_lastLiveFlights;
+    ensureCountryMappings();
+    contents.countriesByContinent = m_store.countriesByContinent();
+    m_snapshotCacheSavedAt = m_lastUpdateDateTime;
+
+    auto save = [path = m_snapshotCachePath, contents]() {
+        TraceScope trace("save cache", "pipeline", QString::number(contents.snapshot.flights.size()));
+        QString error;
+        if (!SnapshotCache::save(path, contents, &error)) {
+            qWarning() << error;
+        }
+    };
+
+    // Periodic saves encode off the GUI thread; the one on quit has to finish first
+    if (synchronous) {
+        save();
+    } else {
+        m_snapshotCacheSave = QtConcurrent::run(save);
+    }
+}
+
+void FlightTracker::setStale(bool stale)
+{
+    if (m_isStale != stale) {
+        m_isStale = stale;
+        emit isStaleChanged();
+    }
+}
+
 void FlightTracker::scheduleFilterUpdate()
 {
-    if (m_flightOverlay && !m_flights.isEmpty() && m_filterUpdateTimer) {
+    if (m_flightOverlay && !m_store.isEmpty() && m_filterUpdateTimer) {
         m_filterUpdateTimer->start(); // Restart the timer, will call applyFilters after delay
     }
 }
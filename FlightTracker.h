@@ -4,7 +4,20 @@
 #include <QObject>
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QFuture>
+#include <QRectF>
 #include "FlightData.h"
+#include "FlightTrack.h"
+#include "FlightStore.h"
+#include "CountryTreeModel.h"
+#include "FlightListModel.h"
+#include "DensityGrid.h"
+#include "AlertEngine.h"
+#include "ConflictDetector.h"
+#include "SnapshotCache.h"
+#include "PipelineStats.h"
 
 namespace Esri::ArcGISRuntime {
 class Map;
@@ -16,8 +29,12 @@ class Basemap;
 }
 
 class OpenSkyAuthManager;
-class FlightDataService;
+class FlightDataSource;
 class FlightRenderer;
+class FlightReplayService;
+class FlightFilter;
+class GraphicsGeneration;
+class QQuickWindow;
 
 Q_MOC_INCLUDE("MapQuickView.h")
 Q_MOC_INCLUDE("Popup.h")
@@ -31,12 +48,27 @@ class FlightTracker : public QObject
     Q_PROPERTY(bool hasSelectedFlight READ hasSelectedFlight NOTIFY selectedFlightChanged)
     Q_PROPERTY(Esri::ArcGISRuntime::Popup *selectedFlightPopup READ selectedFlightPopup NOTIFY selectedFlightChanged)
     Q_PROPERTY(QString lastUpdateTime READ lastUpdateTime NOTIFY lastUpdateTimeChanged)
+    Q_PROPERTY(bool isStale READ isStale NOTIFY isStaleChanged)
     Q_PROPERTY(bool showTrack READ showTrack WRITE setShowTrack NOTIFY showTrackChanged)
+    Q_PROPERTY(bool showDensity READ showDensity NOTIFY showDensityChanged)
     Q_PROPERTY(bool isDarkTheme READ isDarkTheme WRITE setIsDarkTheme NOTIFY isDarkThemeChanged)
+
+    // Replay properties
+    Q_PROPERTY(bool isReplaying READ isReplaying NOTIFY replayStateChanged)
+    Q_PROPERTY(bool isReplayPaused READ isReplayPaused NOTIFY replayStateChanged)
+    Q_PROPERTY(bool isReplayFinished READ isReplayFinished NOTIFY replayStateChanged)
+    Q_PROPERTY(double replaySpeed READ replaySpeed WRITE setReplaySpeed NOTIFY replaySpeedChanged)
+    Q_PROPERTY(QDateTime replayTime READ replayTime NOTIFY replayTimeChanged)
     
     // Filter properties
     Q_PROPERTY(QVariantMap availableCountries READ availableCountries NOTIFY availableCountriesChanged)
     Q_PROPERTY(QStringList selectedCountries READ selectedCountries WRITE setSelectedCountries NOTIFY selectedCountriesChanged)
+    Q_PROPERTY(CountryTreeModel* countryTree READ countryTree CONSTANT)
+    Q_PROPERTY(QVariantMap trafficStats READ trafficStats NOTIFY trafficStatsChanged)
+    Q_PROPERTY(AlertEngine* alerts READ alerts CONSTANT)
+    Q_PROPERTY(QVariantList conflicts READ conflicts NOTIFY conflictsChanged)
+    Q_PROPERTY(int conflictCount READ conflictCount NOTIFY conflictsChanged)
+    Q_PROPERTY(FlightListModel* flightList READ flightList CONSTANT)
     Q_PROPERTY(QString selectedFlightStatus READ selectedFlightStatus WRITE setSelectedFlightStatus NOTIFY selectedFlightStatusChanged)
     Q_PROPERTY(double minAltitudeFilter READ minAltitudeFilter WRITE setMinAltitudeFilter NOTIFY altitudeFilterChanged)
     Q_PROPERTY(double maxAltitudeFilter READ maxAltitudeFilter WRITE setMaxAltitudeFilter NOTIFY altitudeFilterChanged)
@@ -44,6 +76,13 @@ class FlightTracker : public QObject
     Q_PROPERTY(double maxSpeedFilter READ maxSpeedFilter WRITE setMaxSpeedFilter NOTIFY speedFilterChanged)
     Q_PROPERTY(QString selectedVerticalStatus READ selectedVerticalStatus WRITE setSelectedVerticalStatus NOTIFY selectedVerticalStatusChanged)
 
+    // Performance instrumentation
+    Q_PROPERTY(bool showPerformanceOverlay READ showPerformanceOverlay WRITE setShowPerformanceOverlay NOTIFY showPerformanceOverlayChanged)
+    Q_PROPERTY(QVariantList pipelineStats READ pipelineStats NOTIFY pipelineStatsChanged)
+    Q_PROPERTY(QVariantMap frameStats READ frameStats NOTIFY frameStatsChanged)
+    Q_PROPERTY(QVariantMap memoryStats READ memoryStats NOTIFY memoryStatsChanged)
+    Q_PROPERTY(QVariantMap startupStats READ startupStats NOTIFY startupStatsChanged)
+
 public:
     explicit FlightTracker(QObject *parent = nullptr);
     ~FlightTracker() override;
@@ -52,17 +91,35 @@ public:
     bool isAuthenticated() const;
     bool hasSelectedFlight() const;
     Esri::ArcGISRuntime::Popup *selectedFlightPopup() const;
-    bool hasValidPopup() const { return m_selectedFlightPopup != nullptr; }
+    bool hasValidPopup() const { return !m_selectedFlightPopup.isNull(); }
     QString lastUpdateTime() const { return m_lastUpdateTime; }
+    bool isStale() const { return m_isStale; }
     bool showTrack() const { return m_showTrack; }
     void setShowTrack(bool show);
+    bool showDensity() const { return m_showDensity; }
     bool isDarkTheme() const { return m_isDarkTheme; }
     void setIsDarkTheme(bool isDark);
+
+    // Replay property getters/setters
+    bool isReplaying() const { return m_isReplaying; }
+    bool isReplayPaused() const;
+    bool isReplayFinished() const;
+    double replaySpeed() const;
+    void setReplaySpeed(double speed);
+    QDateTime replayTime() const;
     
     // Filter property getters/setters
     QVariantMap availableCountries() const { return m_availableCountries; }
-    QStringList selectedCountries() const { return m_selectedCountries; }
+    QStringList selectedCountries() const { return m_countryTree->selectedCountries(); }
     void setSelectedCountries(const QStringList& countries);
+    CountryTreeModel* countryTree() const { return m_countryTree; }
+    QVariantMap trafficStats() const { return m_store.stats().toVariantMap(); }
+    AlertEngine* alerts() const { return m_alerts; }
+    // The nearest pairs, at most 50, as {first, firstCallsign, second, secondCallsign,
+    // distanceNm, verticalFeet, closureKnots}
+    QVariantList conflicts() const { return m_conflicts; }
+    int conflictCount() const { return int(m_conflictDetector.conflicts().size()); }
+    FlightListModel* flightList() const { return m_flightList; }
     QString selectedFlightStatus() const { return m_selectedFlightStatus; }
     void setSelectedFlightStatus(const QString& status);
     double minAltitudeFilter() const { return m_minAltitudeFilter; }
@@ -76,12 +133,32 @@ public:
     QString selectedVerticalStatus() const { return m_selectedVerticalStatus; }
     void setSelectedVerticalStatus(const QString& status);
 
+    // Performance property getters/setters
+    bool showPerformanceOverlay() const { return m_showPerformanceOverlay; }
+    void setShowPerformanceOverlay(bool show);
+    QVariantList pipelineStats() const { return m_pipelineStats.toVariantList(); }
+    QVariantMap frameStats() const;
+    QVariantMap memoryStats() const;
+    QVariantMap startupStats() const;
+
+    // The current flights, for other views of the same data
+    const FlightStore& store() const { return m_store; }
+
 public slots:
     Q_INVOKABLE void selectFlightAtPoint(QPointF screenPoint);
+    Q_INVOKABLE void selectFlight(const QString& icao24);
     Q_INVOKABLE void clearFlightSelection();
     Q_INVOKABLE void fetchFlightData();
     Q_INVOKABLE QVariantList getSelectedFlightData();
 
+    // Replay controls
+    Q_INVOKABLE bool startReplay(const QString& archivePath);
+    Q_INVOKABLE void stopReplay();
+    Q_INVOKABLE void pauseReplay();
+    Q_INVOKABLE void resumeReplay();
+    Q_INVOKABLE void restartReplay();
+    Q_INVOKABLE void seekReplay(const QDateTime& time);
+
 signals:
     void mapViewChanged();
     void authenticationChanged();
@@ -89,76 +166,141 @@ signals:
     void authenticationFailed(const QString &error);
     void selectedFlightChanged();
     void lastUpdateTimeChanged();
+    void isStaleChanged();
     void showTrackChanged();
+    void showDensityChanged();
+    void conflictsChanged();
     void isDarkThemeChanged();
+    void flightsUpdated();
+
+    // Replay signals
+    void replayStateChanged();
+    void replaySpeedChanged();
+    void replayTimeChanged();
+    void replayFailed(const QString &error);
     
     // Filter signals
     void availableCountriesChanged();
     void selectedCountriesChanged();
+    void trafficStatsChanged();
     void selectedFlightStatusChanged();
     void altitudeFilterChanged();
     void speedFilterChanged();
     void selectedVerticalStatusChanged();
 
+    // Performance signals
+    void showPerformanceOverlayChanged();
+    void pipelineStatsChanged();
+    void frameStatsChanged();
+    void memoryStatsChanged();
+    void startupStatsChanged();
+
 private slots:
     void onAuthenticationSuccess();
     void onAuthenticationFailed(const QString& error);
     void onFlightDataReceived(const QList<FlightData>& flights);
+    void onPartialFlightDataReceived(const QList<FlightData>& flights);
     void onTrackDataReceived(const QString& icao24, const QJsonObject& trackData);
     void onDataFetchFailed(const QString& error);
     void updateDisplayTime();
+    void onReplayFinished();
+    void onMapScaleChanged();
+    void attachFrameTiming();
 
 private:
     Esri::ArcGISRuntime::MapQuickView *mapView() const;
     void setMapView(Esri::ArcGISRuntime::MapQuickView *mapView);
     
     void loadConfig();
+    FlightDataSource* createDataSource(const QJsonObject& sourceConfig);
+    void startDataUpdates();
     void createFlightPopup(const FlightData& flight);
     FlightData findFlightAtPoint(QPointF screenPoint);
+    void setSelectedFlight(const FlightData& flight);
+    QRectF visibleLonLatArea() const;
     
     // Country and filtering helpers
     void loadCountryMappings();
-    QString extractCountryFromFlight(const FlightData& flight);
-    QString getCountryContinent(const QString& country);
+    void ensureCountryMappings();
+    void setAvailableCountries(const QMap<QString, QStringList>& continentsWithCountries);
+    FlightFilter currentFilter() const;
     void applyFilters();
     void scheduleFilterUpdate();
+    void recordSnapshot(const QList<FlightData>& flights);
+    void beginRefreshTrace();
+    void releaseFlightPopup();
+    double trackToleranceMeters() const;
+    void drawSelectedTrack();
+    void updateDensityMode();
+    void drawDensity();
+    void drawAlertHighlights();
+    void detectConflicts();
+    void loadCachedSnapshot();
+    void showCachedSnapshot(const SnapshotCache::Contents& cached);
+    void saveSnapshotCache(bool synchronous);
+    void setStale(bool stale);
 
     // Core components
     Esri::ArcGISRuntime::Map *m_map = nullptr;
     Esri::ArcGISRuntime::MapQuickView *m_mapView = nullptr;
     
-    // Pre-created basemaps for fast switching
+    // Basemaps kept for fast switching, created on first use
     Esri::ArcGISRuntime::Basemap *m_darkBasemap = nullptr;
     Esri::ArcGISRuntime::Basemap *m_lightBasemap = nullptr;
     
     // Services
     OpenSkyAuthManager* m_authManager;
-    FlightDataService* m_dataService;
+    FlightDataSource* m_dataService = nullptr;
     FlightRenderer* m_renderer;
+    FlightReplayService* m_replayService;
     
     // Graphics overlays
     Esri::ArcGISRuntime::GraphicsOverlay* m_flightOverlay;
     Esri::ArcGISRuntime::GraphicsOverlay* m_selectionOverlay;
     Esri::ArcGISRuntime::GraphicsOverlay* m_trackOverlay;
+    Esri::ArcGISRuntime::GraphicsOverlay* m_densityOverlay;
+    Esri::ArcGISRuntime::GraphicsOverlay* m_alertOverlay;
+    Esri::ArcGISRuntime::GraphicsOverlay* m_conflictOverlay;
     
     // Selection state
     FlightData m_selectedFlight;
-    Esri::ArcGISRuntime::Popup* m_selectedFlightPopup = nullptr;
+    FlightTrack m_selectedTrack;
+    int m_drawnTrackVertexCount = 0;
+    QPointer<Esri::ArcGISRuntime::Popup> m_selectedFlightPopup;
+    QPointer<GraphicsGeneration> m_popupGeneration;     // owns the popup and its definition
     
-    // Display state
-    QList<FlightData> m_flights;
+    // Display state; the store's flights line up with the flight overlay's graphics by index
+    FlightStore m_store;
     QString m_lastUpdateTime = "Never";
     QDateTime m_lastUpdateDateTime;
     QTimer* m_displayUpdateTimer;
     QTimer* m_flightUpdateTimer;
     QTimer* m_filterUpdateTimer;
     bool m_showTrack = false;
+
+    // Density replaces the aircraft symbols at scales of 1:m_densityMinScale and smaller
+    DensityGrid m_densityGrid;
+    double m_densityMinScale = 15000000.0;
+    bool m_showDensity = false;
+
+    // Alerts from each snapshot's delta; rings are redrawn once per batch of changes
+    AlertEngine* m_alerts = nullptr;
+    QTimer* m_alertHighlightTimer = nullptr;
+
+    // Pairs closer than the separation minima, found over all flights whatever the filter
+    ConflictDetector m_conflictDetector;
+    QVariantList m_conflicts;
     bool m_isDarkTheme = true;
     bool m_devMode = true;  // Set to false for production
+
+    // Replay and recording state
+    bool m_isReplaying = false;
+    QString m_replayArchivePath;
     
     // Filter state
     QVariantMap m_availableCountries;
-    QStringList m_selectedCountries;
+    CountryTreeModel* m_countryTree = nullptr;
+    FlightListModel* m_flightList = nullptr;
     QString m_selectedFlightStatus = "All";
     double m_minAltitudeFilter = 0.0;
     double m_maxAltitudeFilter = 40000.0;
@@ -167,7 +309,32 @@ private:
     QString m_selectedVerticalStatus = "All";
     bool m_isInitialLoad = true;
     bool m_isUpdatingFlights = false;
-    QMap<QString, QString> m_countryToContinentMap;
+
+    // Performance instrumentation
+    PipelineStats m_pipelineStats;
+    QElapsedTimer m_refreshTimer;       // valid while a refresh is in flight
+    bool m_showPerformanceOverlay = false;
+    RollingStats m_frameCost{240};      // ms per frame on the render thread
+    RollingStats m_frameInterval{240};  // ms between consecutive frames while animating
+    QPointer<QQuickWindow> m_frameWindow;
+    QList<QMetaObject::Connection> m_frameConnections;
+    QElapsedTimer m_frameBegin;         // render thread only
+    QElapsedTimer m_lastFrameEnd;       // render thread only
+    QTimer* m_frameStatsTimer;
+    quint64 m_refreshTraceId = 0;       // open "refresh" trace span, 0 when none
+
+    // Warm start from the previous session's snapshot
+    QString m_snapshotCachePath;        // empty when disabled
+    QTimer* m_snapshotCacheTimer;
+    QFuture<void> m_snapshotCacheSave;
+    QDateTime m_snapshotCacheSavedAt;   // update time of the snapshot last saved
+    QList<FlightData> m_lastLiveFlights; // as the source sent them, without the dev-mode test flight
+    bool m_isStale = false;             // the flights shown came from the cache
+    bool m_hasReceivedData = false;     // a source or replay has delivered a snapshot
+
+    // Startup
+    QFuture<CountryRegistry> m_countryMappingsLoad;   // valid until the store takes it
+    double m_startupBudgetMs = 2000.0;
 };
 
 #endif // FLIGHTTRACKER_H
\ No newline at end of file
@@ -52,19 +52,15 @@ exists($$TOOLKIT_PATH) {
     error("ArcGIS Toolkit not found at: $$TOOLKIT_PATH")
 }
 
+include($$PWD/core/FlightTrackerCore.pri)
+
 HEADERS += \
     FlightTracker.h \
-    FlightData.h \
-    OpenSkyAuthManager.h \
-    FlightDataService.h \
     FlightRenderer.h \
     Flight3DViewer.h
 
 SOURCES += \
     FlightTracker.cpp \
-    FlightData.cpp \
-    OpenSkyAuthManager.cpp \
-    FlightDataService.cpp \
     FlightRenderer.cpp \
     Flight3DViewer.cpp \
     main.cpp
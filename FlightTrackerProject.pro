@@ -0,0 +1,41 @@
+#-------------------------------------------------
+#  Builds the core library first, then everything that links it.
+#  Open this file (rather than FlightTracker.pro) in Qt Creator.
+#
+#  On a machine without the ArcGIS SDK, build everything but the
+#  app and its soak with: qmake FlightTrackerProject.pro CONFIG+=headless
+#-------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    core \
+    cli \
+    trafficgen \
+    standin \
+    benchmarks \
+    soak
+
+core.file = core/FlightTrackerCore.pro
+
+!headless {
+    SUBDIRS += app appsoak
+    app.file = FlightTracker.pro
+    app.depends = core
+    appsoak.file = benchmarks/FlightAppSoak.pro
+    appsoak.depends = core
+}
+
+cli.file = tools/FlightTrackerCli/FlightTrackerCli.pro
+cli.depends = core
+
+trafficgen.file = tools/TrafficGen/TrafficGen.pro
+trafficgen.depends = core
+
+standin.file = tools/OpenSkyStandIn/OpenSkyStandIn.pro
+
+benchmarks.file = benchmarks/FlightBenchmarks.pro
+benchmarks.depends = core
+
+soak.file = benchmarks/FlightSoak.pro
+soak.depends = core
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "FlightTracker.h"
+#include "TrafficGenerator.h"
+#include "FlightArchive.h"
+#include "MemoryStats.h"
+#include "SoakSampler.h"
+
+#include <QtTest>
+#include <QGuiApplication>
+#include <QTemporaryDir>
+#include <cstdio>
+
+// Replays a synthetic archive in a loop at full speed through FlightTracker, as the app does with
+// replay.speed 0 and replay.loop, and checks that memory stays flat.
+//
+// Every snapshot takes the app's own refresh path: FlightStore, AlertEngine, ConflictDetector and
+// FlightRenderer::clearGraphics and updateFlightGraphics into ArcGIS graphics overlays. An
+// aircraft is selected a few times a second, so FlightTracker::createFlightPopup builds popups
+// and selection graphics that the next refresh releases.
+//
+// No map view is attached, so nothing is drawn on screen and no basemap is loaded. The config in
+// FlightAppSoak.qrc uses a synthetic source and turns the warm start off, so the soak touches
+// neither the network nor the snapshot cache.
+//
+// FLIGHT_SOAK_MINUTES (default 2), FLIGHT_SOAK_AIRCRAFT (default 10000) and
+// FLIGHT_SOAK_TOLERANCE_MB (default 32) tune the run; FLIGHT_SOAK_CSV writes every sample.
+// The short default is a smoke test; `make soak-long` runs four hours and keeps the samples.
+class FlightAppSoak : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void soak();
+    void cleanupTestCase();
+
+private:
+    void selectFlight();
+
+    QTemporaryDir m_dir;
+    QString m_archivePath;
+    FlightTracker* m_tracker = nullptr;
+    qint64 m_refreshes = 0;
+    qint64 m_selections = 0;
+    int m_aircraft = 10000;
+};
+
+namespace {
+void quietMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    // The tracker logs every refresh and popup, which would swamp the samples
+    if (type == QtDebugMsg) {
+        return;
+    }
+    fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+}
+
+int envInt(const char* name, int fallback)
+{
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok && value > 0 ? value : fallback;
+}
+}
+
+void FlightAppSoak::initTestCase()
+{
+    qInstallMessageHandler(quietMessageHandler);
+    QVERIFY(m_dir.isValid());
+
+    m_aircraft = envInt("FLIGHT_SOAK_AIRCRAFT", 10000);
+
+    // Ten minutes of traffic; the loop replays it for as long as the soak runs
+    TrafficGenerator::Options options;
+    options.seed = 7;
+    options.aircraftCount = m_aircraft;
+    TrafficGenerator generator(options);
+
+    FlightArchiveWriter writer;
+    m_archivePath = m_dir.filePath("soak.ftar");
+    QVERIFY2(writer.open(m_archivePath), qPrintable(writer.errorString()));
+    for (int i = 0; i < 60; ++i) {
+        generator.advance(10);
+        FlightSnapshot snapshot;
+        snapshot.timestamp = generator.currentTime() * 1000;
+        snapshot.flights = generator.flights();
+        QVERIFY2(writer.append(snapshot), qPrintable(writer.errorString()));
+    }
+    writer.close();
+
+    m_tracker = new FlightTracker(this);
+    connect(m_tracker, &FlightTracker::flightsUpdated, this, [this]() { ++m_refreshes; });
+}
+
+void FlightAppSoak::selectFlight()
+{
+    // Spread over the list so the popup is built for different aircraft each time
+    const QList<FlightData>& flights = m_tracker->store().flights();
+    if (flights.isEmpty()) {
+        return;
+    }
+    m_tracker->selectFlight(flights[(m_selections++ * 7919) % flights.size()].icao24());
+}
+
+void FlightAppSoak::soak()
+{
+    const int minutes = envInt("FLIGHT_SOAK_MINUTES", 2);
+    const qint64 toleranceBytes = qint64(envInt("FLIGHT_SOAK_TOLERANCE_MB", 32)) * 1024 * 1024;
+    const int sampleMs = qBound(1000, minutes * 60 * 1000 / 120, 60000);
+
+    if (MemoryStats::residentBytes() < 0) {
+        QSKIP("Resident memory is not reported on this platform");
+    }
+
+    m_tracker->setReplaySpeed(0);
+    QVERIFY(m_tracker->startReplay(m_archivePath));
+
+    SoakSampler sampler([this]() { return m_refreshes; });
+    sampler.setCsvPath(qEnvironmentVariable("FLIGHT_SOAK_CSV"));
+
+    QTimer selector;
+    connect(&selector, &QTimer::timeout, this, &FlightAppSoak::selectFlight);
+
+    QEventLoop loop;
+    QTimer::singleShot(minutes * 60 * 1000, &loop, &QEventLoop::quit);
+    sampler.start(sampleMs);
+    selector.start(250);
+    loop.exec();
+    selector.stop();
+    sampler.stop();
+    m_tracker->pauseReplay();
+
+    const QList<SoakSampler::Sample>& samples = sampler.samples();
+    QVERIFY2(samples.size() >= 8, "Too few samples, lengthen FLIGHT_SOAK_MINUTES");
+    QVERIFY2(m_refreshes > 100, "Too few refreshes to judge");
+    QVERIFY2(m_selections > 0, "No aircraft was selected");
+
+    // The current refresh and the one being released, plus the selection, alert rings and
+    // conflict lines; one popup and the one being released; a generation per overlay and popup
+    for (const SoakSampler::Sample& sample : samples) {
+        QVERIFY(sample.counts["graphics"].toLongLong() <= 3 * (m_aircraft + 1));
+        QVERIFY(sample.counts["popups"].toLongLong() <= 2);
+        QVERIFY(sample.counts["generations"].toLongLong() <= 16);
+    }
+
+    // The first quarter is warm-up (allocator pools, SDK caches); after that the footprint
+    // at the end must be within tolerance of the footprint just after warm-up
+    const qsizetype quarter = samples.size() / 4;
+    const qint64 baseline = sampler.medianResidentBytes(quarter, 2 * quarter);
+    const qint64 last = sampler.medianResidentBytes(samples.size() - quarter, samples.size());
+
+    qInfo("%lld refreshes and %lld selections in %d min, RSS %.1f MB after warm-up, %.1f MB at the end",
+          m_refreshes, m_selections, minutes, baseline / 1048576.0, last / 1048576.0);
+    QVERIFY2(last - baseline <= toleranceBytes,
+             qPrintable(QString("Resident memory grew by %1 MB").arg((last - baseline) / 1048576.0, 0, 'f', 1)));
+}
+
+void FlightAppSoak::cleanupTestCase()
+{
+    delete m_tracker;
+    m_tracker = nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    // Nothing is shown, so the soak also runs on machines without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+    FlightAppSoak soak;
+    return QTest::qExec(&soak, argc, argv);
+}
+
+#include "FlightAppSoak.moc"
\ No newline at end of file
@@ -0,0 +1,50 @@
+#-------------------------------------------------
+#  Memory soak of the app itself: FlightTracker replays a
+#  generated archive in a loop at full speed, drawing each
+#  snapshot with FlightRenderer and opening flight popups,
+#  while the process footprint and live graphics counts are
+#  sampled. Needs the ArcGIS Maps SDK like the app; no window
+#  is shown. FlightSoak.pro is the SDK-free counterpart.
+#
+#  Same environment variables as FlightSoak. `make soak-long`
+#  runs the four-hour soak and writes every sample to
+#  app-soak-long.csv in the build directory.
+#-------------------------------------------------
+
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# additional modules are pulled in via arcgisruntime.pri
+QT += qml quick testlib
+
+TARGET = FlightAppSoak
+
+APP_DIR = $$PWD/..
+
+ARCGIS_RUNTIME_VERSION = 200.8.0
+include($$APP_DIR/arcgisruntime.pri)
+
+include($$APP_DIR/core/FlightTrackerCore.pri)
+
+INCLUDEPATH += $$APP_DIR
+
+HEADERS += \
+    $$APP_DIR/FlightTracker.h \
+    $$APP_DIR/FlightRenderer.h \
+    SoakSampler.h
+
+SOURCES += \
+    FlightAppSoak.cpp \
+    $$APP_DIR/FlightTracker.cpp \
+    $$APP_DIR/FlightRenderer.cpp \
+    SoakSampler.cpp
+
+RESOURCES += \
+    FlightAppSoak.qrc
+
+soak_long.target = soak-long
+soak_long.commands = FLIGHT_SOAK_MINUTES=240 FLIGHT_SOAK_CSV=$$OUT_PWD/app-soak-long.csv ./$(TARGET)
+soak_long.depends = $(TARGET)
+QMAKE_EXTRA_TARGETS += soak_long
\ No newline at end of file
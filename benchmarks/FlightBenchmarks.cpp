@@ -0,0 +1,933 @@
+#include "FlightDataSource.h"
+#include "TrafficGenerator.h"
+#include "FlightTrack.h"
+#include "FlightFilter.h"
+#include "FlightClassifier.h"
+#include "FlightHitTester.h"
+#include "TrafficLod.h"
+#include "FlightStore.h"
+#include "FlightListModel.h"
+#include "DensityGrid.h"
+#include "AlertEngine.h"
+#include "ConflictDetector.h"
+#include "CountryRegistry.h"
+#include "FlightArchive.h"
+#include "SnapshotCodec.h"
+
+#include <QtTest>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Hot paths of the app on recorded and synthetic /states/all payloads.
+//
+// Recorded payloads are the first snapshot of FIXTURES_DIR and of FLIGHT_BENCH_FIXTURES, if set
+// (e.g. a directory written by TrafficGen or captured from OpenSky). Synthetic sizes default to
+// 1k, 10k and 100k aircraft and can be overridden with FLIGHT_BENCH_SIZES=1000,200000.
+class FlightBenchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void decodeStates_data();
+    void decodeStates();
+    void constructFlightData_data();
+    void constructFlightData();
+    void applyFilters_data();
+    void applyFilters();
+    void categoryFromCallsign_data();
+    void categoryFromCallsign();
+    void countryContinent_data();
+    void countryContinent();
+    void hitTestIndex_data();
+    void hitTestIndex();
+    void hitTest_data();
+    void hitTest();
+
+    void trafficLevels_data();
+    void trafficLevels();
+
+    void flightListUpdate_data();
+    void flightListUpdate();
+
+    void densityGrid_data();
+    void densityGrid();
+
+    void trafficStats_data();
+    void trafficStats();
+
+    void alertEngine_data();
+    void alertEngine();
+
+    void conflictDetector_data();
+    void conflictDetector();
+    void conflictDetectorMatchesAllPairs();
+
+    void archiveSeek_data();
+    void archiveSeek();
+    void archiveSeekWorstCase();
+    void snapshotCodec();
+
+    void trackFromJson_data();
+    void trackFromJson();
+    void trackSimplify_data();
+    void trackSimplify();
+    void trackVertices_data();
+    void trackVertices();
+
+private:
+    struct Payload
+    {
+        QString name;
+        QByteArray json;
+        QList<FlightData> flights;
+    };
+
+    void addRecordedPayload(const QString& fixtureDir);
+    void addPayloadRows();
+    const Payload& currentPayload() const;
+    bool buildSeekArchive();
+    QString seekArchivePath() const { return m_archiveDir.filePath("seek.ftar"); }
+
+    QList<Payload> m_payloads;
+    QTemporaryDir m_archiveDir;
+    QList<qint64> m_archiveTimes;   // snapshot timestamps of the seek archive
+    QList<QPair<QString, QByteArray>> m_trackJson;
+    CountryRegistry m_countries;
+};
+
+namespace {
+void quietMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    // decodeStates logs every call, which would swamp the results
+    if (type == QtDebugMsg) {
+        return;
+    }
+    fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+}
+
+// Seek archive: 10k aircraft every 10 s for a little over 40 minutes, a keyframe every 30 snapshots
+constexpr int SeekArchiveAircraft = 10000;
+constexpr int SeekArchiveSnapshots = 250;
+constexpr int SeekKeyframeInterval = 30;
+
+double greatCircleNm(const FlightData& a, const FlightData& b)
+{
+    const double lat1 = qDegreesToRadians(a.latitude());
+    const double lat2 = qDegreesToRadians(b.latitude());
+    const double sinLat = std::sin((lat2 - lat1) / 2.0);
+    const double sinLon = std::sin(qDegreesToRadians(b.longitude() - a.longitude()) / 2.0);
+    const double h = sinLat * sinLat + std::cos(lat1) * std::cos(lat2) * sinLon * sinLon;
+    return 2.0 * ConflictDetector::EarthRadiusNm * std::asin(std::min(1.0, std::sqrt(h)));
+}
+
+int envInt(const char* name, int defaultValue)
+{
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok && value > 0 ? value : defaultValue;
+}
+
+QList<int> syntheticSizes()
+{
+    QList<int> sizes;
+    const QByteArray env = qgetenv("FLIGHT_BENCH_SIZES");
+    for (const QByteArray& size : env.split(',')) {
+        if (size.toInt() > 0) {
+            sizes.append(size.toInt());
+        }
+    }
+    return sizes.isEmpty() ? QList<int>{1000, 10000, 100000} : sizes;
+}
+
+// Dense raw ADS-B style track: one position per second with a wandering heading
+QList<FlightTrack::Waypoint> randomWalkTrack(int count, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QList<FlightTrack::Waypoint> waypoints;
+    waypoints.reserve(count);
+
+    double lon = -30.0, lat = 45.0, heading = 80.0;
+    for (int i = 0; i < count; ++i) {
+        waypoints.append({lon, lat, 11000.0});
+        heading += (random.generateDouble() - 0.5) * 2.0;
+        const double meters = 250.0;
+        lat += meters * std::cos(qDegreesToRadians(heading)) / 111320.0;
+        lon += meters * std::sin(qDegreesToRadians(heading)) / (111320.0 * std::cos(qDegreesToRadians(lat)));
+    }
+    return waypoints;
+}
+}
+
+void FlightBenchmarks::initTestCase()
+{
+    qInstallMessageHandler(quietMessageHandler);
+
+    QVERIFY2(m_countries.load(COUNTRIES_JSON), "countries.json not found");
+
+    addRecordedPayload(FIXTURES_DIR);
+    const QString extraFixtures = qEnvironmentVariable("FLIGHT_BENCH_FIXTURES");
+    if (!extraFixtures.isEmpty()) {
+        addRecordedPayload(extraFixtures);
+    }
+
+    for (int size : syntheticSizes()) {
+        TrafficGenerator::Options options;
+        options.seed = 42;
+        options.aircraftCount = size;
+        TrafficGenerator generator(options);
+        generator.advance(600);
+
+        Payload synthetic;
+        synthetic.name = QString("synthetic/%1").arg(size);
+        synthetic.json = generator.statesJson();
+        synthetic.flights = FlightDataSource::decodeStates(synthetic.json);
+        m_payloads.append(synthetic);
+
+        // Longest current leg among the first aircraft
+        if (size == syntheticSizes().first()) {
+            QByteArray longest;
+            for (int i = 0; i < generator.aircraftCount(); ++i) {
+                const QByteArray track = generator.trackJson(generator.icao24At(i));
+                if (track.size() > longest.size()) {
+                    longest = track;
+                }
+            }
+            m_trackJson.append({QString("synthetic/longest"), longest});
+        }
+    }
+
+    QDir tracksDir(QDir(FIXTURES_DIR).filePath("tracks"));
+    for (const QString& name : tracksDir.entryList({"*.json"}, QDir::Files, QDir::Name)) {
+        QFile file(tracksDir.filePath(name));
+        if (file.open(QIODevice::ReadOnly)) {
+            m_trackJson.append({QString("recorded/%1").arg(name), file.readAll()});
+        }
+    }
+}
+
+void FlightBenchmarks::addRecordedPayload(const QString& fixtureDir)
+{
+    QDir statesDir(QDir(fixtureDir).filePath("states"));
+    const QStringList files = statesDir.entryList({"*.json"}, QDir::Files, QDir::Name);
+    if (files.isEmpty()) {
+        qWarning() << "No state fixtures in" << statesDir.path();
+        return;
+    }
+
+    QFile file(statesDir.filePath(files.first()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    Payload recorded;
+    recorded.json = file.readAll();
+    recorded.flights = FlightDataSource::decodeStates(recorded.json);
+    recorded.name = QString("recorded/%1/%2").arg(QDir(fixtureDir).dirName()).arg(recorded.flights.size());
+    m_payloads.append(recorded);
+}
+
+void FlightBenchmarks::addPayloadRows()
+{
+    QTest::addColumn<int>("payload");
+    for (int i = 0; i < m_payloads.size(); ++i) {
+        QTest::newRow(qPrintable(m_payloads[i].name)) << i;
+    }
+}
+
+const FlightBenchmarks::Payload& FlightBenchmarks::currentPayload() const
+{
+    QFETCH(int, payload);
+    return m_payloads.at(payload);
+}
+
+// Decoding
+
+void FlightBenchmarks::decodeStates_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::decodeStates()
+{
+    const Payload& input = currentPayload();
+
+    QList<FlightData> flights;
+    QBENCHMARK {
+        flights = FlightDataSource::decodeStates(input.json);
+    }
+    QCOMPARE(flights.size(), input.flights.size());
+}
+
+void FlightBenchmarks::constructFlightData_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::constructFlightData()
+{
+    const QJsonArray states = QJsonDocument::fromJson(currentPayload().json).object()["states"].toArray();
+
+    int valid = 0;
+    QBENCHMARK {
+        valid = 0;
+        for (const QJsonValue& value : states) {
+            valid += FlightData(value.toArray()).isValid();
+        }
+    }
+    QVERIFY(valid > 0);
+}
+
+// Filtering and classification
+
+void FlightBenchmarks::applyFilters_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::applyFilters()
+{
+    const Payload& input = currentPayload();
+
+    // Half of the countries, airborne only, a typical altitude band
+    QSet<QString> countrySet;
+    for (const FlightData& flight : input.flights) {
+        countrySet.insert(flight.country().trimmed());
+    }
+    QStringList countries = countrySet.values();
+    std::sort(countries.begin(), countries.end());
+
+    // Country ids and selection bits, as the filter panel's tree hands them over
+    QHash<QString, int> ids;
+    QBitArray selected(countries.size());
+    for (int i = 0; i < countries.size(); ++i) {
+        ids.insert(countries[i], i);
+        selected.setBit(i, i % 2 == 0);
+    }
+
+    FlightFilter filter;
+    filter.setCountrySelection(ids, selected);
+    filter.setStatus("Airborne");
+    filter.setAltitudeRange(10000.0, 40000.0);
+    filter.setSpeedRange(0.0, 600.0);
+    filter.setVerticalStatus("All");
+
+    int visible = 0;
+    QBENCHMARK {
+        visible = 0;
+        for (const FlightData& flight : input.flights) {
+            visible += filter.matches(flight);
+        }
+    }
+    QVERIFY(visible <= input.flights.size());
+}
+
+void FlightBenchmarks::categoryFromCallsign_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::categoryFromCallsign()
+{
+    const Payload& input = currentPayload();
+
+    int total = 0;
+    QBENCHMARK {
+        total = 0;
+        for (const FlightData& flight : input.flights) {
+            total += FlightClassifier::categoryFromCallsign(flight.callsign());
+        }
+    }
+    QVERIFY(total >= input.flights.size());
+}
+
+void FlightBenchmarks::countryContinent_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::countryContinent()
+{
+    const Payload& input = currentPayload();
+
+    int other = 0;
+    QBENCHMARK {
+        other = 0;
+        for (const FlightData& flight : input.flights) {
+            other += m_countries.continentFor(flight.country()) == "Other";
+        }
+    }
+    QVERIFY(other <= input.flights.size());
+}
+
+// Hit testing
+
+void FlightBenchmarks::hitTestIndex_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::hitTestIndex()
+{
+    const Payload& input = currentPayload();
+
+    FlightHitTester tester;
+    QBENCHMARK {
+        tester.setFlights(input.flights);
+    }
+}
+
+void FlightBenchmarks::hitTest_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::hitTest()
+{
+    const Payload& input = currentPayload();
+
+    FlightHitTester tester;
+    tester.setFlights(input.flights);
+    const QList<bool> visible(input.flights.size(), true);
+
+    // Clicks near aircraft and on empty map, 15 px at ~150 m per pixel
+    QRandomGenerator random(7);
+    QList<QPointF> clicks;
+    for (int i = 0; i < 256; ++i) {
+        if (i % 2 == 0 && !input.flights.isEmpty()) {
+            const FlightData& flight = input.flights.at(int(random.bounded(int(input.flights.size()))));
+            clicks.append(QPointF(flight.longitude() + (random.generateDouble() - 0.5) * 0.04,
+                                  flight.latitude() + (random.generateDouble() - 0.5) * 0.04));
+        } else {
+            clicks.append(QPointF(random.generateDouble() * 360.0 - 180.0, random.generateDouble() * 160.0 - 80.0));
+        }
+    }
+    const double toleranceMeters = 15.0 * 150.0;
+
+    int hits = 0;
+    QBENCHMARK {
+        hits = 0;
+        for (const QPointF& click : clicks) {
+            hits += tester.hitTest(click.x(), click.y(), toleranceMeters, visible) >= 0;
+        }
+    }
+    QVERIFY(hits <= clicks.size());
+}
+
+// 3D traffic
+
+void FlightBenchmarks::trafficLevels_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::trafficLevels()
+{
+    const Payload& input = currentPayload();
+    if (input.flights.isEmpty()) {
+        QSKIP("No flights");
+    }
+
+    TrafficLod lod;
+    lod.setFlights(input.flights);
+
+    // One orbit around an aircraft, as the 3D view recomputes levels while the camera moves
+    const FlightData& target = input.flights.at(input.flights.size() / 2);
+    QList<QPointF> cameras;
+    for (int i = 0; i < 64; ++i) {
+        const double angle = 2.0 * M_PI * i / 64;
+        cameras.append(QPointF(target.longitude() + 0.05 * std::cos(angle), target.latitude() + 0.05 * std::sin(angle)));
+    }
+
+    QBENCHMARK {
+        for (const QPointF& camera : cameras) {
+            lod.update(camera.x(), camera.y(), target.altitude() + 2000.0);
+        }
+    }
+    QVERIFY(lod.count(TrafficLod::Model) <= lod.options().maxModels);
+}
+
+// Flight list
+
+void FlightBenchmarks::flightListUpdate_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::flightListUpdate()
+{
+    const Payload& input = currentPayload();
+
+    // The next refresh: every tenth aircraft climbs, the last one lands and a new one appears
+    QList<FlightData> next;
+    next.reserve(input.flights.size() + 1);
+    for (qsizetype i = 0; i + 1 < input.flights.size(); ++i) {
+        const FlightData& f = input.flights[i];
+        next.append(i % 10 != 0 ? f : FlightData(f.icao24(), f.callsign(), f.country(), f.longitude(), f.latitude(),
+                                                 f.altitude() + 150.0, f.velocity(), f.heading(), 2.5,
+                                                 f.onGround(), f.squawk()));
+    }
+    next.append(FlightData("benchnew", "BENCH1", "Testland", 0.0, 0.0, 9000.0, 230.0, 90.0, 0.0, false, "7000"));
+
+    FlightStore current;
+    FlightStore refreshed;
+    current.ingest(input.flights);
+    refreshed.ingest(next);
+
+    // Sorted by altitude, so the climbing aircraft change rows
+    FlightListModel model;
+    model.sort(FlightListModel::Altitude, Qt::DescendingOrder);
+    model.update(current);
+
+    QBENCHMARK {
+        model.update(refreshed);
+        model.update(current);
+    }
+    QCOMPARE(model.count(), int(current.visibleCount()));
+}
+
+// Density view
+
+void FlightBenchmarks::densityGrid_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::densityGrid()
+{
+    const Payload& input = currentPayload();
+    const QList<bool> visible(input.flights.size(), true);
+
+    DensityGrid grid;
+    QBENCHMARK {
+        grid.build(input.flights, visible);
+    }
+    QCOMPARE(grid.flightCount(), int(input.flights.size()));
+}
+
+// Filter counts
+
+void FlightBenchmarks::trafficStats_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::trafficStats()
+{
+    const Payload& input = currentPayload();
+
+    // A refresh in which every tenth aircraft climbs into the next band and a tenth of the rest leave
+    QList<FlightData> next;
+    for (qsizetype i = 0; i < input.flights.size(); ++i) {
+        const FlightData& f = input.flights[i];
+        if (i % 10 == 5) {
+            continue;
+        }
+        next.append(i % 10 != 0 ? f : FlightData(f.icao24(), f.callsign(), f.country(), f.longitude(), f.latitude(),
+                                                 f.altitude() + 1600.0, f.velocity(), f.heading(), 8.0,
+                                                 f.onGround(), f.squawk()));
+    }
+
+    FlightSnapshotState state;
+    state.reset(input.flights);
+    const FlightSnapshotDelta forward = state.diff(next);
+    state.reset(next);
+    const FlightSnapshotDelta back = state.diff(input.flights);
+
+    TrafficStats stats;
+    stats.apply(FlightSnapshotState().diff(input.flights));
+    const int total = stats.total();
+
+    QBENCHMARK {
+        stats.apply(forward);
+        stats.apply(back);
+    }
+    QCOMPARE(stats.total(), total);
+}
+
+void FlightBenchmarks::alertEngine_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::alertEngine()
+{
+    const Payload& input = currentPayload();
+
+    // A refresh in which every hundredth aircraft squawks 7700 and dives, every tenth climbs
+    // and a tenth of the rest leave; alerts are raised going forward and cleared coming back
+    QList<FlightData> next;
+    for (qsizetype i = 0; i < input.flights.size(); ++i) {
+        const FlightData& f = input.flights[i];
+        if (i % 10 == 5) {
+            continue;
+        }
+        if (i % 100 == 0) {
+            next.append(FlightData(f.icao24(), f.callsign(), f.country(), f.longitude(), f.latitude(),
+                                   f.altitude() - 600.0, f.velocity(), f.heading(), -40.0, false, "7700"));
+        } else {
+            next.append(i % 10 != 0 ? f : FlightData(f.icao24(), f.callsign(), f.country(), f.longitude(),
+                                                     f.latitude(), f.altitude() + 1600.0, f.velocity(), f.heading(),
+                                                     8.0, f.onGround(), f.squawk()));
+        }
+    }
+
+    FlightSnapshotState state;
+    state.reset(input.flights);
+    const FlightSnapshotDelta forward = state.diff(next);
+    state.reset(next);
+    const FlightSnapshotDelta back = state.diff(input.flights);
+
+    AlertEngine alerts;
+    AlertEngine::Options options;
+    options.squawkReports = 1;
+    options.descentReports = 1;
+    options.clearReports = 1;
+    alerts.setOptions(options);
+
+    qint64 timestamp = 1000;
+    alerts.process(FlightSnapshotState().diff(input.flights), timestamp);
+    const int active = alerts.activeCount();
+
+    QBENCHMARK {
+        alerts.process(forward, timestamp += 10000);
+        alerts.process(back, timestamp += 10000);
+    }
+    QCOMPARE(alerts.activeCount(), active);
+}
+
+void FlightBenchmarks::conflictDetector_data()
+{
+    addPayloadRows();
+}
+
+void FlightBenchmarks::conflictDetector()
+{
+    const Payload& input = currentPayload();
+
+    ConflictDetector detector;
+    QBENCHMARK {
+        detector.detect(input.flights);
+    }
+
+    // Every reported pair is airborne and inside both minima
+    const ConflictDetector::Options& options = detector.options();
+    for (const ConflictDetector::Conflict& conflict : detector.conflicts()) {
+        QVERIFY(!input.flights[conflict.first].onGround() && !input.flights[conflict.second].onGround());
+        QVERIFY(conflict.distanceNm < options.horizontalNm + 0.01);
+        QVERIFY(conflict.verticalFeet < options.verticalFeet);
+    }
+}
+
+void FlightBenchmarks::conflictDetectorMatchesAllPairs()
+{
+    // Aircraft spread over the world plus dense clusters at both poles and either side of the
+    // antimeridian, where neighbouring cells are easiest to miss
+    QRandomGenerator random(50);
+    QList<FlightData> flights;
+    const auto addAircraft = [&](double longitude, double latitude) {
+        const int n = int(flights.size());
+        const double altitude = 800.0 + random.bounded(800.0);  // metres, some under the minimum
+        flights.append(FlightData(QString("%1").arg(n, 6, 16, QChar('0')), QString(), QString(), longitude, latitude,
+                                  altitude, 100.0 + random.bounded(150.0), random.bounded(360.0), 0.0, n % 50 == 0,
+                                  QString()));
+    };
+    for (int i = 0; i < 1500; ++i) {
+        addAircraft(-180.0 + random.bounded(360.0), -85.0 + random.bounded(170.0));
+    }
+    for (int i = 0; i < 400; ++i) {
+        addAircraft(-180.0 + random.bounded(360.0), 90.0 - random.bounded(0.25));
+        addAircraft(-180.0 + random.bounded(360.0), -90.0 + random.bounded(0.25));
+    }
+    for (const double latitude : {10.0, 65.0}) {
+        for (int i = 0; i < 400; ++i) {
+            const double longitude = 179.8 + random.bounded(0.4);
+            addAircraft(longitude > 180.0 ? longitude - 360.0 : longitude, latitude + random.bounded(0.3));
+        }
+    }
+
+    ConflictDetector detector;
+    detector.detect(flights);
+    const ConflictDetector::Options& options = detector.options();
+
+    const auto eligible = [&](const FlightData& flight) {
+        return !flight.onGround() && flight.altitude() * 3.28084 >= options.minAltitudeFeet;
+    };
+    // Pairs within a hair of either minimum may land on either side through rounding
+    const auto borderline = [&](double distanceNm, double verticalFeet) {
+        return std::abs(distanceNm - options.horizontalNm) < 1e-3
+               || std::abs(verticalFeet - options.verticalFeet) < 0.1;
+    };
+
+    QSet<QPair<int, int>> found;
+    for (const ConflictDetector::Conflict& conflict : detector.conflicts()) {
+        QVERIFY(conflict.first < conflict.second);
+        QVERIFY(eligible(flights[conflict.first]) && eligible(flights[conflict.second]));
+        QVERIFY(!found.contains({conflict.first, conflict.second}));
+        const double distanceNm = greatCircleNm(flights[conflict.first], flights[conflict.second]);
+        QVERIFY(std::abs(conflict.distanceNm - distanceNm) < 1e-3);
+        found.insert({conflict.first, conflict.second});
+    }
+
+    int expected = 0;
+    for (int i = 0; i < flights.size(); ++i) {
+        if (!eligible(flights[i])) {
+            continue;
+        }
+        for (int j = i + 1; j < flights.size(); ++j) {
+            if (!eligible(flights[j])) {
+                continue;
+            }
+            const double distanceNm = greatCircleNm(flights[i], flights[j]);
+            const double verticalFeet = std::abs(flights[i].altitude() - flights[j].altitude()) * 3.28084;
+            const bool conflict = distanceNm < options.horizontalNm && verticalFeet < options.verticalFeet;
+            expected += conflict;
+            if (conflict != found.contains({i, j})) {
+                QVERIFY2(borderline(distanceNm, verticalFeet),
+                         qPrintable(QString("%1 and %2: %3 NM, %4 ft").arg(i).arg(j).arg(distanceNm).arg(verticalFeet)));
+            }
+        }
+    }
+    QVERIFY(expected > 0);
+    qInfo("%d aircraft, %d pairs in conflict, %d found", int(flights.size()), expected, int(found.size()));
+}
+
+// Archives
+
+bool FlightBenchmarks::buildSeekArchive()
+{
+    if (!m_archiveTimes.isEmpty()) {
+        return true;
+    }
+
+    TrafficGenerator::Options options;
+    options.seed = 7;
+    options.aircraftCount = SeekArchiveAircraft;
+    TrafficGenerator generator(options);
+
+    FlightArchiveWriter writer;
+    writer.setKeyframeInterval(SeekKeyframeInterval);
+    if (!m_archiveDir.isValid() || !writer.open(seekArchivePath())) {
+        return false;
+    }
+    for (int i = 0; i < SeekArchiveSnapshots; ++i) {
+        FlightSnapshot snapshot;
+        snapshot.timestamp = generator.currentTime() * 1000;
+        snapshot.flights = generator.flights();
+        if (!writer.append(snapshot)) {
+            return false;
+        }
+        m_archiveTimes.append(snapshot.timestamp);
+        generator.advance(10);
+    }
+    writer.close();
+    return true;
+}
+
+void FlightBenchmarks::archiveSeek_data()
+{
+    // The cost is the deltas rolled forward from the keyframe, so the row just before a
+    // keyframe is the bound
+    QTest::addColumn<int>("snapshot");
+    QTest::newRow("start") << 0;
+    QTest::newRow("middle") << SeekArchiveSnapshots / 2;
+    QTest::newRow("before keyframe")
+        << (SeekArchiveSnapshots / 2 / SeekKeyframeInterval + 1) * SeekKeyframeInterval - 1;
+    QTest::newRow("end") << SeekArchiveSnapshots - 1;
+}
+
+void FlightBenchmarks::archiveSeek()
+{
+    QFETCH(int, snapshot);
+    QVERIFY2(buildSeekArchive(), "Could not write the seek archive");
+
+    FlightArchiveReader reader;
+    QVERIFY2(reader.open(seekArchivePath()), qPrintable(reader.errorString()));
+    const qint64 target = m_archiveTimes[snapshot];
+
+    QBENCHMARK {
+        QVERIFY(reader.seek(target));
+    }
+
+    FlightSnapshot next;
+    QVERIFY(reader.readNext(next));
+    QCOMPARE(next.timestamp, target);
+}
+
+void FlightBenchmarks::archiveSeekWorstCase()
+{
+    QVERIFY2(buildSeekArchive(), "Could not write the seek archive");
+
+    FlightArchiveReader reader;
+    QVERIFY2(reader.open(seekArchivePath()), qPrintable(reader.errorString()));
+
+    // Every snapshot in the archive, best of three each so one scheduler hiccup is not the result
+    QList<double> seekMs;
+    for (int snapshot = 0; snapshot < m_archiveTimes.size(); ++snapshot) {
+        double best = 0.0;
+        for (int run = 0; run < 3; ++run) {
+            QElapsedTimer timer;
+            timer.start();
+            QVERIFY(reader.seek(m_archiveTimes[snapshot]));
+            const double ms = timer.nsecsElapsed() / 1e6;
+            best = run == 0 ? ms : std::min(best, ms);
+        }
+        FlightSnapshot next;
+        QVERIFY(reader.readNext(next));
+        QCOMPARE(next.timestamp, m_archiveTimes[snapshot]);
+        seekMs.append(best);
+    }
+
+    const qsizetype worst = std::max_element(seekMs.cbegin(), seekMs.cend()) - seekMs.cbegin();
+    QList<double> sorted = seekMs;
+    std::sort(sorted.begin(), sorted.end());
+    qInfo("Seek over %d snapshots of %d aircraft, keyframe every %d: median %.2f ms, worst %.2f ms "
+          "at snapshot %lld (%lld deltas after its keyframe)",
+          SeekArchiveSnapshots, SeekArchiveAircraft, SeekKeyframeInterval, sorted[sorted.size() / 2], seekMs[worst],
+          qint64(worst), qint64(worst % SeekKeyframeInterval));
+}
+
+void FlightBenchmarks::snapshotCodec()
+{
+    // A generated day at the app's 10 s refresh, encoded as the archive writer does. Size it with
+    // FLIGHT_BENCH_CODEC_AIRCRAFT and FLIGHT_BENCH_CODEC_HOURS.
+    TrafficGenerator::Options options;
+    options.seed = 11;
+    options.aircraftCount = envInt("FLIGHT_BENCH_CODEC_AIRCRAFT", 1000);
+    const int snapshots = envInt("FLIGHT_BENCH_CODEC_HOURS", 24) * 360;
+    TrafficGenerator generator(options);
+    const int keyframeInterval = FlightArchiveWriter().keyframeInterval();
+
+    SnapshotEncoder encoder;
+    QList<QByteArray> frames;
+    frames.reserve(snapshots);
+    qint64 rawBytes = 0;
+    qint64 encodedBytes = 0;
+    qint64 encodeNs = 0;
+    for (int i = 0; i < snapshots; ++i) {
+        rawBytes += generator.statesJson().size();
+        const QList<FlightData> flights = generator.flights();
+
+        QElapsedTimer timer;
+        timer.start();
+        frames.append(i % keyframeInterval == 0 ? encoder.encodeKeyframe(flights) : encoder.encodeDelta(flights));
+        encodeNs += timer.nsecsElapsed();
+
+        encodedBytes += frames.last().size();
+        generator.advance(10);
+    }
+
+    SnapshotDecoder decoder;
+    auto decodeAll = [&]() {
+        for (int i = 0; i < frames.size(); ++i) {
+            if (i % keyframeInterval == 0) {
+                decoder.reset();
+            }
+            FlightSnapshotDelta delta;
+            if (!decoder.decode(frames[i], delta)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(decodeAll());
+    const qint64 decodeNs = timer.nsecsElapsed();
+
+    // Throughput is in raw JSON megabytes, the data the archive stands in for
+    const double rawMB = rawBytes / (1024.0 * 1024.0);
+    qInfo("Codec over %d snapshots of %d aircraft, keyframe every %d: %lld bytes per snapshot against %lld of "
+          "JSON (%.1f:1); encode %.0f MB/s, decode %.0f MB/s",
+          snapshots, options.aircraftCount, keyframeInterval, encodedBytes / snapshots, rawBytes / snapshots,
+          double(rawBytes) / std::max<qint64>(1, encodedBytes), rawMB / std::max(1e-9, encodeNs / 1e9),
+          rawMB / std::max(1e-9, decodeNs / 1e9));
+
+    QBENCHMARK {
+        QVERIFY(decodeAll());
+    }
+}
+
+// Tracks
+
+void FlightBenchmarks::trackFromJson_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    for (const auto& track : m_trackJson) {
+        QTest::newRow(qPrintable(track.first)) << track.second;
+    }
+}
+
+void FlightBenchmarks::trackFromJson()
+{
+    QFETCH(QByteArray, json);
+
+    FlightTrack track;
+    QBENCHMARK {
+        track = FlightTrack::fromJson(QJsonDocument::fromJson(json).object());
+    }
+    QVERIFY(!track.isEmpty());
+}
+
+void FlightBenchmarks::trackSimplify_data()
+{
+    QTest::addColumn<int>("waypoints");
+    QTest::newRow("waypoints/1000") << 1000;
+    QTest::newRow("waypoints/10000") << 10000;
+    QTest::newRow("waypoints/100000") << 100000;
+}
+
+void FlightBenchmarks::trackSimplify()
+{
+    QFETCH(int, waypoints);
+    const QList<FlightTrack::Waypoint> path = randomWalkTrack(waypoints, 3);
+
+    FlightTrack track;
+    QBENCHMARK {
+        track = FlightTrack(path);
+    }
+    QCOMPARE(track.waypoints().size(), path.size());
+}
+
+void FlightBenchmarks::trackVertices_data()
+{
+    trackSimplify_data();
+}
+
+void FlightBenchmarks::trackVertices()
+{
+    QFETCH(int, waypoints);
+    const FlightTrack track(randomWalkTrack(waypoints, 3));
+
+    // One pass through the zoom levels, as onMapScaleChanged does while zooming
+    QList<double> tolerances;
+    for (double tolerance = 0.3; tolerance < 40000.0; tolerance *= 2.0) {
+        tolerances.append(tolerance);
+    }
+
+    qsizetype drawn = 0;
+    QBENCHMARK {
+        drawn = 0;
+        for (double tolerance : tolerances) {
+            if (track.vertexCountForTolerance(tolerance) > 1) {
+                drawn += track.verticesForTolerance(tolerance).size();
+            }
+        }
+    }
+    QVERIFY(drawn > 0);
+}
+
+QTEST_GUILESS_MAIN(FlightBenchmarks)
+
+#include "FlightBenchmarks.moc"
\ No newline at end of file
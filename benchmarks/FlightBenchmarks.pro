@@ -0,0 +1,27 @@
+#-------------------------------------------------
+#  Qt Test benchmarks for the app's hot paths.
+#  Only needs Qt Core and Qt Test: the benchmarked code is the
+#  ArcGIS-independent part of the app, linked from FlightTrackerCore.
+#
+#  Run with e.g. -o results.xml,xml or -o results.csv,csv for
+#  machine-readable output.
+#-------------------------------------------------
+
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+QT = core testlib
+
+TARGET = FlightBenchmarks
+
+APP_DIR = $$PWD/..
+include($$APP_DIR/core/FlightTrackerCore.pri)
+
+DEFINES += \
+    FIXTURES_DIR=\\\"$$APP_DIR/fixtures/opensky\\\" \
+    COUNTRIES_JSON=\\\"$$APP_DIR/qml/countries.json\\\"
+
+SOURCES += \
+    FlightBenchmarks.cpp
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "TrafficGenerator.h"
+#include "FlightArchive.h"
+#include "FlightReplayService.h"
+#include "FlightFilter.h"
+#include "FlightHitTester.h"
+#include "GraphicsGeneration.h"
+#include "MemoryStats.h"
+#include "SoakSampler.h"
+
+#include <QtTest>
+#include <QPointer>
+#include <QTemporaryDir>
+#include <cstdio>
+
+// Replays a synthetic archive in a loop at full speed through the core pipeline and a stand-in
+// for the drawing, and checks that memory stays flat. Needs no ArcGIS SDK, so it runs anywhere.
+//
+// Each refresh retires the previous GraphicsGeneration and fills a new one with one plain QObject
+// per graphic and per symbol, the way FlightRenderer fills its generations. Filtering, hit-test
+// indexing and an occasional stand-in popup run on every snapshot. This covers the core pipeline
+// and GraphicsGeneration's ownership, not the renderer or the popups themselves; FlightAppSoak
+// runs those through FlightTracker with the SDK.
+//
+// FLIGHT_SOAK_MINUTES (default 2), FLIGHT_SOAK_AIRCRAFT (default 10000) and
+// FLIGHT_SOAK_TOLERANCE_MB (default 16) tune the run; FLIGHT_SOAK_CSV writes every sample.
+// The short default is a smoke test; `make soak-long` runs four hours and keeps the samples.
+class FlightSoak : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void soak();
+
+private:
+    void processSnapshot(const QList<FlightData>& flights);
+
+    QTemporaryDir m_dir;
+    QString m_archivePath;
+    FlightFilter m_filter;
+    FlightHitTester m_hitTester;
+    QPointer<GraphicsGeneration> m_generation;
+    qint64 m_refreshes = 0;
+    int m_aircraft = 10000;
+};
+
+namespace {
+void quietMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    // The replay logs every snapshot, which would swamp the samples
+    if (type == QtDebugMsg) {
+        return;
+    }
+    fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+}
+
+int envInt(const char* name, int fallback)
+{
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok && value > 0 ? value : fallback;
+}
+}
+
+void FlightSoak::initTestCase()
+{
+    qInstallMessageHandler(quietMessageHandler);
+    QVERIFY(m_dir.isValid());
+
+    m_aircraft = envInt("FLIGHT_SOAK_AIRCRAFT", 10000);
+
+    // Ten minutes of traffic; the loop replays it for as long as the soak runs
+    TrafficGenerator::Options options;
+    options.seed = 7;
+    options.aircraftCount = m_aircraft;
+    TrafficGenerator generator(options);
+
+    FlightArchiveWriter writer;
+    m_archivePath = m_dir.filePath("soak.ftar");
+    QVERIFY2(writer.open(m_archivePath), qPrintable(writer.errorString()));
+    for (int i = 0; i < 60; ++i) {
+        generator.advance(10);
+        FlightSnapshot snapshot;
+        snapshot.timestamp = generator.currentTime() * 1000;
+        snapshot.flights = generator.flights();
+        QVERIFY2(writer.append(snapshot), qPrintable(writer.errorString()));
+    }
+    writer.close();
+
+    m_filter.setStatus("Airborne");
+    m_filter.setAltitudeRange(1000, 45000);
+}
+
+void FlightSoak::processSnapshot(const QList<FlightData>& flights)
+{
+    // Same order as FlightTracker: release the last refresh, then build the next
+    if (m_generation) {
+        m_generation->deleteLater();
+    }
+    m_generation = new GraphicsGeneration(this);
+
+    for (const FlightData& flight : flights) {
+        QObject* symbol = new QObject(m_generation);
+        QObject* graphic = new QObject(m_generation);
+        graphic->setProperty("visible", m_filter.matches(flight));
+        Q_UNUSED(symbol)
+    }
+    m_generation->track(GraphicsGeneration::Symbols, flights.size());
+    m_generation->track(GraphicsGeneration::Graphics, flights.size());
+
+    m_hitTester.setFlights(flights);
+
+    // A selection every few refreshes, owned by the generation of the graphic it shows
+    if (m_refreshes % 8 == 0 && !flights.isEmpty()) {
+        GraphicsGeneration* popupOwner = new GraphicsGeneration(m_generation);
+        new QObject(popupOwner);
+        popupOwner->track(GraphicsGeneration::Popups);
+    }
+
+    ++m_refreshes;
+}
+
+void FlightSoak::soak()
+{
+    const int minutes = envInt("FLIGHT_SOAK_MINUTES", 2);
+    const qint64 toleranceBytes = qint64(envInt("FLIGHT_SOAK_TOLERANCE_MB", 16)) * 1024 * 1024;
+    const int sampleMs = qBound(1000, minutes * 60 * 1000 / 120, 60000);
+
+    if (MemoryStats::residentBytes() < 0) {
+        QSKIP("Resident memory is not reported on this platform");
+    }
+
+    FlightReplayService replay;
+    QVERIFY(replay.open(m_archivePath));
+    replay.setSpeed(0);
+    replay.setLoop(true);
+
+    connect(&replay, &FlightReplayService::flightDataReceived, this, [this, &replay](const QList<FlightData>& flights) {
+        processSnapshot(flights);
+        // Acknowledged from the event loop so retired generations are deleted between refreshes
+        QTimer::singleShot(0, &replay, &FlightReplayService::acknowledgeSnapshot);
+    });
+
+    SoakSampler sampler([this]() { return m_refreshes; });
+    sampler.setCsvPath(qEnvironmentVariable("FLIGHT_SOAK_CSV"));
+
+    QEventLoop loop;
+    QTimer::singleShot(minutes * 60 * 1000, &loop, &QEventLoop::quit);
+    sampler.start(sampleMs);
+    replay.start();
+    loop.exec();
+    sampler.stop();
+    replay.close();
+
+    const QList<SoakSampler::Sample>& samples = sampler.samples();
+    QVERIFY2(samples.size() >= 8, "Too few samples, lengthen FLIGHT_SOAK_MINUTES");
+    QVERIFY2(m_refreshes > 100, "Too few refreshes to judge");
+
+    // Live objects never exceed the current refresh plus the one being released
+    for (const SoakSampler::Sample& sample : samples) {
+        QVERIFY(sample.counts["graphics"].toLongLong() <= 2 * m_aircraft);
+        QVERIFY(sample.counts["generations"].toLongLong() <= 4);
+    }
+
+    // The first quarter is warm-up (allocator pools, hash growth); after that the footprint
+    // at the end must be within tolerance of the footprint just after warm-up
+    const qsizetype quarter = samples.size() / 4;
+    const qint64 baseline = sampler.medianResidentBytes(quarter, 2 * quarter);
+    const qint64 last = sampler.medianResidentBytes(samples.size() - quarter, samples.size());
+
+    qInfo("%lld refreshes in %d min, RSS %.1f MB after warm-up, %.1f MB at the end",
+          m_refreshes, minutes, baseline / 1048576.0, last / 1048576.0);
+    QVERIFY2(last - baseline <= toleranceBytes,
+             qPrintable(QString("Resident memory grew by %1 MB").arg((last - baseline) / 1048576.0, 0, 'f', 1)));
+}
+
+QTEST_GUILESS_MAIN(FlightSoak)
+
+#include "FlightSoak.moc"
\ No newline at end of file
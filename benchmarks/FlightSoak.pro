@@ -0,0 +1,34 @@
+#-------------------------------------------------
+#  Memory soak of the core refresh pipeline: a generated archive
+#  is replayed in a loop as fast as it can be processed while
+#  the process footprint and live graphics counts are sampled.
+#  Only needs Qt Core and Qt Test; plain objects stand in for
+#  the ArcGIS graphics. FlightAppSoak.pro soaks the real app.
+#
+#  FLIGHT_SOAK_MINUTES sets the duration (default 2, a smoke
+#  test). `make soak-long` runs the four-hour soak and writes
+#  every sample to soak-long.csv in the build directory.
+#-------------------------------------------------
+
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+QT = core testlib
+
+TARGET = FlightSoak
+
+include($$PWD/../core/FlightTrackerCore.pri)
+
+HEADERS += \
+    SoakSampler.h
+
+SOURCES += \
+    FlightSoak.cpp \
+    SoakSampler.cpp
+
+soak_long.target = soak-long
+soak_long.commands = FLIGHT_SOAK_MINUTES=240 FLIGHT_SOAK_CSV=$$OUT_PWD/soak-long.csv ./$(TARGET)
+soak_long.depends = $(TARGET)
+QMAKE_EXTRA_TARGETS += soak_long
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "SoakSampler.h"
+#include "GraphicsGeneration.h"
+#include "MemoryStats.h"
+#include <algorithm>
+
+SoakSampler::SoakSampler(std::function<qint64()> refreshes)
+    : m_refreshes(std::move(refreshes))
+{
+    QObject::connect(&m_timer, &QTimer::timeout, [this]() { sample(); });
+}
+
+void SoakSampler::setCsvPath(const QString& path)
+{
+    m_csv.close();
+    m_csv.setFileName(path);
+    if (!path.isEmpty() && m_csv.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_csv.write("minutes,refreshes,resident_bytes,graphics,symbols,popups,generations\n");
+    }
+}
+
+void SoakSampler::start(int intervalMs)
+{
+    m_samples.clear();
+    m_clock.start();
+    m_timer.start(intervalMs);
+}
+
+void SoakSampler::stop()
+{
+    m_timer.stop();
+}
+
+void SoakSampler::sample()
+{
+    const Sample sample{m_clock.elapsed() / 60000.0, m_refreshes(), MemoryStats::residentBytes(),
+                        GraphicsGeneration::liveCounts()};
+    m_samples.append(sample);
+
+    if (m_csv.isOpen()) {
+        m_csv.write(QString("%1,%2,%3,%4,%5,%6,%7\n")
+                        .arg(sample.minutes, 0, 'f', 2).arg(sample.refreshes).arg(sample.residentBytes)
+                        .arg(sample.counts["graphics"].toLongLong()).arg(sample.counts["symbols"].toLongLong())
+                        .arg(sample.counts["popups"].toLongLong()).arg(sample.counts["generations"].toLongLong())
+                        .toUtf8());
+        m_csv.flush();
+    }
+}
+
+qint64 SoakSampler::medianResidentBytes(qsizetype from, qsizetype to) const
+{
+    QList<qint64> values;
+    for (qsizetype i = from; i < to; ++i) {
+        values.append(m_samples[i].residentBytes);
+    }
+    if (values.isEmpty()) {
+        return -1;
+    }
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef SOAKSAMPLER_H
+#define SOAKSAMPLER_H
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QTimer>
+#include <QVariantMap>
+#include <functional>
+
+// Samples the process footprint and GraphicsGeneration's live counts on a timer for the soak
+// tests, and optionally writes every sample to a CSV file as it is taken.
+class SoakSampler
+{
+public:
+    struct Sample
+    {
+        double minutes = 0.0;
+        qint64 refreshes = 0;
+        qint64 residentBytes = 0;
+        QVariantMap counts;
+    };
+
+    // refreshes reports how many refreshes have run so far
+    explicit SoakSampler(std::function<qint64()> refreshes);
+
+    // An empty path writes nothing
+    void setCsvPath(const QString& path);
+
+    void start(int intervalMs);
+    void stop();
+
+    const QList<Sample>& samples() const { return m_samples; }
+    // Median resident bytes of the samples in [from, to)
+    qint64 medianResidentBytes(qsizetype from, qsizetype to) const;
+
+private:
+    void sample();
+
+    std::function<qint64()> m_refreshes;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QFile m_csv;
+    QList<Sample> m_samples;
+};
+
+#endif // SOAKSAMPLER_H
\ No newline at end of file
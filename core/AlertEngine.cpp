@@ -0,0 +1,311 @@
+#include "AlertEngine.h"
+#include "TraceRecorder.h"
+#include <QDateTime>
+
+AlertEngine::AlertEngine(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int AlertEngine::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : int(m_alerts.size());
+}
+
+QVariant AlertEngine::data(const QModelIndex& index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return QVariant();
+    }
+
+    const Alert& alert = m_alerts[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+    case MessageRole: return alert.message;
+    case KindRole: return int(alert.kind);
+    case KindNameRole: return kindName(alert.kind);
+    case Icao24Role: return alert.icao24;
+    case CallsignRole: return alert.callsign;
+    case TimeRole: return QDateTime::fromMSecsSinceEpoch(alert.time);
+    case ActiveRole: return alert.active;
+    case LongitudeRole: return alert.longitude;
+    case LatitudeRole: return alert.latitude;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> AlertEngine::roleNames() const
+{
+    return {
+        {KindRole, "kind"},
+        {KindNameRole, "kindName"},
+        {Icao24Role, "icao24"},
+        {CallsignRole, "callsign"},
+        {MessageRole, "message"},
+        {TimeRole, "time"},
+        {ActiveRole, "active"},
+        {LongitudeRole, "longitude"},
+        {LatitudeRole, "latitude"}
+    };
+}
+
+QString AlertEngine::kindName(Kind kind)
+{
+    switch (kind) {
+    case Hijack: return "Hijack";
+    case RadioFailure: return "Radio failure";
+    case Emergency: return "Emergency";
+    case RapidDescent: return "Rapid descent";
+    case Silent: return "Lost contact";
+    }
+    return QString();
+}
+
+void AlertEngine::process(const FlightSnapshotDelta& delta, qint64 timestamp)
+{
+    TraceScope trace("alerts", "pipeline", QString::number(delta.upserted.size() + delta.removed.size()));
+
+    // After an outage, a seek or a warm start everything missing looks silent, so only a
+    // snapshot that follows the previous one closely can raise silence alerts
+    const bool continuous = m_lastTimestamp > 0 && qAbs(timestamp - m_lastTimestamp) <= m_options.silentMaxGapMs;
+    m_lastTimestamp = timestamp;
+    expireSilences(timestamp);
+
+    for (const QString& icao24 : delta.removed) {
+        const auto it = m_aircraft.constFind(icao24);
+        if (it == m_aircraft.cend()) {
+            continue;
+        }
+
+        // Alerts of an aircraft that left end with it; silence takes over if it was flying
+        for (int rule = 0; rule < RuleCount; ++rule) {
+            if (it->alert[rule] != 0) {
+                clearAlert(it->alert[rule]);
+            }
+        }
+        if (continuous && !it->onGround && it->altitudeFeet >= m_options.silentMinAltitudeFeet
+            && isInsideArea(*it) && !m_silent.contains(icao24)) {
+            const QString message = QString("Lost contact at %1 ft").arg(qRound(it->altitudeFeet));
+            Silence silence;
+            silence.since = timestamp;
+            silence.alert = raise(Silent, icao24, *it, message, timestamp);
+            m_silent.insert(icao24, silence);
+        }
+        m_aircraft.erase(it);
+    }
+
+    for (const FlightData& flight : delta.upserted) {
+        // Back in the feed
+        if (!m_silent.isEmpty()) {
+            const auto silent = m_silent.constFind(flight.icao24());
+            if (silent != m_silent.cend()) {
+                clearAlert(silent->alert);
+                m_silent.erase(silent);
+            }
+        }
+        evaluate(m_aircraft[flight.icao24()], flight, timestamp);
+    }
+}
+
+bool AlertEngine::isInsideArea(const Aircraft& aircraft) const
+{
+    if (m_area.isNull()) {
+        return true;
+    }
+    const double margin = m_options.silentEdgeMarginDegrees;
+    return m_area.adjusted(margin, margin, -margin, -margin).contains(aircraft.longitude, aircraft.latitude);
+}
+
+void AlertEngine::expireSilences(qint64 timestamp)
+{
+    if (m_options.silentExpiryMs <= 0 || m_silent.isEmpty()) {
+        return;
+    }
+    for (auto it = m_silent.begin(); it != m_silent.end();) {
+        if (timestamp - it->since >= m_options.silentExpiryMs) {
+            clearAlert(it->alert);
+            it = m_silent.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AlertEngine::evaluate(Aircraft& aircraft, const FlightData& flight, qint64 timestamp)
+{
+    aircraft.callsign = flight.callsign().trimmed();
+    aircraft.longitude = float(flight.longitude());
+    aircraft.latitude = float(flight.latitude());
+    aircraft.altitudeFeet = float(flight.altitude() * 3.28084);
+    aircraft.onGround = flight.onGround();
+
+    Kind squawkKind = Emergency;
+    bool squawking = true;
+    const QString squawk = flight.squawk().trimmed();
+    if (squawk == QLatin1String("7500")) {
+        squawkKind = Hijack;
+    } else if (squawk == QLatin1String("7600")) {
+        squawkKind = RadioFailure;
+    } else if (squawk != QLatin1String("7700")) {
+        squawking = false;
+    }
+
+    // A change from one emergency code to another replaces the alert straight away
+    if (squawking && aircraft.alert[SquawkRule] != 0) {
+        const int row = rowOf(aircraft.alert[SquawkRule]);
+        if (row >= 0 && m_alerts[row].kind != squawkKind) {
+            clearAlert(aircraft.alert[SquawkRule]);
+            aircraft.alert[SquawkRule] = 0;
+        }
+    }
+    if (confirm(aircraft, SquawkRule, squawking, m_options.squawkReports)) {
+        const QString message = QString("Squawking %1 (%2)").arg(squawk, kindName(squawkKind).toLower());
+        aircraft.alert[SquawkRule] = raise(squawkKind, flight.icao24(), aircraft, message, timestamp);
+    }
+
+    const double feetPerMinute = flight.verticalRate() * 196.85;
+    const bool descending = !flight.onGround() && feetPerMinute <= -m_options.descentFeetPerMinute;
+    if (confirm(aircraft, DescentRule, descending, m_options.descentReports)) {
+        const QString message = QString("Descending at %1 ft/min through %2 ft")
+                                    .arg(qRound(-feetPerMinute)).arg(qRound(aircraft.altitudeFeet));
+        aircraft.alert[DescentRule] = raise(RapidDescent, flight.icao24(), aircraft, message, timestamp);
+    }
+}
+
+bool AlertEngine::confirm(Aircraft& aircraft, Rule rule, bool condition, int reports)
+{
+    if (condition) {
+        aircraft.misses[rule] = 0;
+        if (aircraft.hits[rule] < 255) {
+            ++aircraft.hits[rule];
+        }
+        return aircraft.alert[rule] == 0 && aircraft.hits[rule] >= reports;
+    }
+
+    aircraft.hits[rule] = 0;
+    if (aircraft.alert[rule] != 0 && ++aircraft.misses[rule] >= m_options.clearReports) {
+        clearAlert(aircraft.alert[rule]);
+        aircraft.alert[rule] = 0;
+        aircraft.misses[rule] = 0;
+    }
+    return false;
+}
+
+quint64 AlertEngine::raise(Kind kind, const QString& icao24, const Aircraft& aircraft, const QString& message,
+                           qint64 timestamp)
+{
+    Alert alert;
+    alert.id = m_nextId++;
+    alert.kind = kind;
+    alert.icao24 = icao24;
+    alert.callsign = aircraft.callsign;
+    alert.message = message;
+    alert.time = timestamp;
+    alert.longitude = aircraft.longitude;
+    alert.latitude = aircraft.latitude;
+
+    beginInsertRows(QModelIndex(), 0, 0);
+    m_alerts.prepend(alert);
+    endInsertRows();
+
+    // The oldest alerts make room, inactive or not
+    while (m_alerts.size() > qMax(1, m_options.maxAlerts)) {
+        removeRow(int(m_alerts.size()) - 1);
+    }
+    emit countChanged();
+
+    setAlerting(icao24, 1);
+    emit alertRaised(kind, icao24, message);
+    return alert.id;
+}
+
+void AlertEngine::clearAlert(quint64 id)
+{
+    // Dismissed or pushed out alerts are no longer listed and have nothing left to clear
+    const int row = rowOf(id);
+    if (row < 0 || !m_alerts[row].active) {
+        return;
+    }
+
+    Alert& alert = m_alerts[row];
+    alert.active = false;
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {ActiveRole});
+
+    setAlerting(alert.icao24, -1);
+    emit alertCleared(alert.kind, alert.icao24);
+}
+
+void AlertEngine::setAlerting(const QString& icao24, int change)
+{
+    int& alerts = m_activeAircraft[icao24];
+    alerts += change;
+    if (alerts <= 0) {
+        m_activeAircraft.remove(icao24);
+    }
+    emit activeAircraftChanged();
+}
+
+int AlertEngine::rowOf(quint64 id) const
+{
+    for (int row = 0; row < m_alerts.size(); ++row) {
+        if (m_alerts[row].id == id) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+void AlertEngine::removeRow(int row)
+{
+    const bool active = m_alerts[row].active;
+    const QString icao24 = m_alerts[row].icao24;
+
+    // A silence is only tracked while its alert is listed
+    if (m_alerts[row].kind == Silent) {
+        const auto silent = m_silent.constFind(icao24);
+        if (silent != m_silent.cend() && silent->alert == m_alerts[row].id) {
+            m_silent.erase(silent);
+        }
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_alerts.removeAt(row);
+    endRemoveRows();
+
+    if (active) {
+        setAlerting(icao24, -1);
+    }
+}
+
+void AlertEngine::dismiss(int row)
+{
+    if (row < 0 || row >= m_alerts.size()) {
+        return;
+    }
+    // The aircraft keeps its rule state, so a dismissed alert is not raised again until its
+    // condition has cleared and returned
+    removeRow(row);
+    emit countChanged();
+}
+
+void AlertEngine::dismissAll()
+{
+    if (m_alerts.isEmpty()) {
+        return;
+    }
+    beginResetModel();
+    m_alerts.clear();
+    endResetModel();
+    m_activeAircraft.clear();
+    m_silent.clear();
+    emit countChanged();
+    emit activeAircraftChanged();
+}
+
+void AlertEngine::reset()
+{
+    dismissAll();
+    m_aircraft.clear();
+    m_lastTimestamp = 0;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef ALERTENGINE_H
+#define ALERTENGINE_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QRectF>
+#include <QStringList>
+#include "FlightData.h"
+#include "FlightSnapshot.h"
+
+// Watches snapshot deltas for emergency squawks (7500, 7600, 7700), rapid descents and
+// airborne aircraft that drop out of the feed. Only the aircraft in a delta are evaluated.
+// Each aircraft keeps a little state so one odd report does not raise an alert and an alert
+// is not raised again while it is still active.
+//
+// The alerts are also a list model for QML, newest first. An alert stays listed once it
+// clears, marked inactive, until it is dismissed or pushed out by newer ones.
+class AlertEngine : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int activeCount READ activeCount NOTIFY activeAircraftChanged)
+
+public:
+    enum Kind {
+        Hijack,             // squawk 7500
+        RadioFailure,       // squawk 7600
+        Emergency,          // squawk 7700
+        RapidDescent,
+        Silent
+    };
+    Q_ENUM(Kind)
+
+    enum Roles {
+        KindRole = Qt::UserRole + 1,
+        KindNameRole,
+        Icao24Role,
+        CallsignRole,
+        MessageRole,
+        TimeRole,
+        ActiveRole,
+        LongitudeRole,
+        LatitudeRole
+    };
+
+    struct Options
+    {
+        int squawkReports = 2;              // consecutive reports before a squawk alert
+        double descentFeetPerMinute = 6000.0;
+        int descentReports = 2;
+        int clearReports = 3;               // consecutive normal reports before an alert clears
+        double silentMinAltitudeFeet = 5000.0;
+        qint64 silentMaxGapMs = 120000;     // longer gaps between snapshots are outages, not silence
+        qint64 silentExpiryMs = 1800000;    // a lost contact alert clears after this, 0 never
+        double silentEdgeMarginDegrees = 0.5;   // aircraft this close to the area's edge just left it
+        int maxAlerts = 100;
+    };
+
+    explicit AlertEngine(QObject* parent = nullptr);
+
+    void setOptions(const Options& options) { m_options = options; }
+    const Options& options() const { return m_options; }
+
+    // Area the feed covers, longitude on x and latitude on y. Aircraft that vanish near its
+    // edge have flown out of it rather than gone silent. Null, the default, is the whole world.
+    void setArea(const QRectF& area) { m_area = area; }
+    QRectF area() const { return m_area; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Evaluates the aircraft in delta, taken at timestamp (msecs since epoch)
+    void process(const FlightSnapshotDelta& delta, qint64 timestamp);
+    // Forgets every aircraft and alert, e.g. when switching between live data and a replay
+    void reset();
+
+    int count() const { return int(m_alerts.size()); }
+    int activeCount() const { return int(m_activeAircraft.size()); }
+    // Aircraft with an active alert, for highlighting
+    QStringList activeAircraft() const { return m_activeAircraft.keys(); }
+    bool isAlerting(const QString& icao24) const { return m_activeAircraft.contains(icao24); }
+
+    Q_INVOKABLE void dismiss(int row);
+    Q_INVOKABLE void dismissAll();
+
+    static QString kindName(Kind kind);
+
+signals:
+    void alertRaised(AlertEngine::Kind kind, const QString& icao24, const QString& message);
+    void alertCleared(AlertEngine::Kind kind, const QString& icao24);
+    void countChanged();
+    void activeAircraftChanged();
+
+private:
+    enum Rule { SquawkRule, DescentRule, RuleCount };
+
+    struct Alert
+    {
+        quint64 id = 0;
+        Kind kind = Emergency;
+        QString icao24;
+        QString callsign;
+        QString message;
+        qint64 time = 0;
+        double longitude = 0.0;
+        double latitude = 0.0;
+        bool active = true;
+    };
+
+    // Per aircraft: the last report's facts the silence rule needs, and per rule the run of
+    // reports that met (hits) or missed (misses) its condition and the alert it raised
+    struct Aircraft
+    {
+        QString callsign;
+        float longitude = 0.0f;
+        float latitude = 0.0f;
+        float altitudeFeet = 0.0f;
+        bool onGround = true;
+        quint8 hits[RuleCount] = {};
+        quint8 misses[RuleCount] = {};
+        quint64 alert[RuleCount] = {};
+    };
+
+    struct Silence
+    {
+        quint64 alert = 0;
+        qint64 since = 0;
+    };
+
+    bool isInsideArea(const Aircraft& aircraft) const;
+    void expireSilences(qint64 timestamp);
+    void evaluate(Aircraft& aircraft, const FlightData& flight, qint64 timestamp);
+    bool confirm(Aircraft& aircraft, Rule rule, bool condition, int reports);
+    quint64 raise(Kind kind, const QString& icao24, const Aircraft& aircraft, const QString& message,
+                  qint64 timestamp);
+    void clearAlert(quint64 id);
+    void setAlerting(const QString& icao24, int change);
+    int rowOf(quint64 id) const;
+    void removeRow(int row);
+
+    Options m_options;
+    QRectF m_area;
+    QHash<QString, Aircraft> m_aircraft;        // by icao24
+    QHash<QString, Silence> m_silent;           // icao24 -> listed silence alert
+    QHash<QString, int> m_activeAircraft;       // icao24 -> active alerts
+    QList<Alert> m_alerts;                      // newest first
+    quint64 m_nextId = 1;
+    qint64 m_lastTimestamp = 0;
+};
+
+#endif // ALERTENGINE_H
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "ConflictDetector.h"
+#include "TraceRecorder.h"
+#include <QThread>
+#include <QtMath>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Flights per task when placing them, occupied cells per task when searching
+constexpr qsizetype PlaceChunk = 8192;
+constexpr qsizetype SearchChunk = 2048;
+
+// Smaller cells only add lookups; the exact distance is checked per pair anyway
+constexpr double MinCellNm = 0.5;
+
+// Cell coordinates take 21 bits each, offset so they are never negative
+constexpr int CellBits = 21;
+constexpr qint64 CellOffset = qint64(1) << (CellBits - 1);
+
+quint64 cellKey(qint64 x, qint64 y, qint64 z)
+{
+    return (quint64(x + CellOffset) << (2 * CellBits)) | (quint64(y + CellOffset) << CellBits)
+           | quint64(z + CellOffset);
+}
+
+// Key steps to the 13 neighbouring cells that sort after a cell. Searching only these, and later
+// points in the cell itself, visits each pair of neighbouring cells once.
+QList<qint64> forwardNeighbours()
+{
+    QList<qint64> steps;
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dz = -1; dz <= 1; ++dz) {
+                const qint64 step = (qint64(dx) << (2 * CellBits)) + (qint64(dy) << CellBits) + dz;
+                if (step > 0) {
+                    steps.append(step);
+                }
+            }
+        }
+    }
+    return steps;
+}
+
+template <typename Function>
+void forEachChunk(qsizetype count, qsizetype chunkSize, Function function)
+{
+    QList<qsizetype> chunks;
+    for (qsizetype first = 0; first < count; first += chunkSize) {
+        chunks.append(first);
+    }
+    if (chunks.size() > 1 && QThread::idealThreadCount() > 1) {
+        QtConcurrent::blockingMap(chunks, function);
+    } else {
+        for (qsizetype first : std::as_const(chunks)) {
+            function(first);
+        }
+    }
+}
+}
+
+void ConflictDetector::clear()
+{
+    m_points.clear();
+    m_cellStarts.clear();
+    m_cellIndex.clear();
+    m_conflicts.clear();
+}
+
+void ConflictDetector::detect(const QList<FlightData>& flights)
+{
+    TraceScope trace("conflicts", "pipeline", QString::number(flights.size()));
+    clear();
+    if (m_options.horizontalNm <= 0.0) {
+        return;
+    }
+
+    const double cellSize = std::max(m_options.horizontalNm, MinCellNm);
+    m_points.resize(flights.size());
+
+    forEachChunk(flights.size(), PlaceChunk, [&](qsizetype first) {
+        const qsizetype last = std::min(first + PlaceChunk, flights.size());
+        for (qsizetype i = first; i < last; ++i) {
+            const FlightData& flight = flights[i];
+            Point& point = m_points[i];
+            const double altitudeFeet = flight.altitude() * 3.28084;
+            if (!flight.isValid() || flight.onGround() || altitudeFeet < m_options.minAltitudeFeet) {
+                point.flight = -1;
+                continue;
+            }
+
+            const double lon = qDegreesToRadians(flight.longitude());
+            const double lat = qDegreesToRadians(flight.latitude());
+            const double sinLon = std::sin(lon), cosLon = std::cos(lon);
+            const double sinLat = std::sin(lat), cosLat = std::cos(lat);
+            point.x = EarthRadiusNm * cosLat * cosLon;
+            point.y = EarthRadiusNm * cosLat * sinLon;
+            point.z = EarthRadiusNm * sinLat;
+
+            // Heading and speed in the local east/north plane, turned into the same frame
+            const double knots = flight.velocity() * 1.94384;
+            const double east = knots * std::sin(qDegreesToRadians(flight.heading()));
+            const double north = knots * std::cos(qDegreesToRadians(flight.heading()));
+            point.vx = float(-sinLon * east - sinLat * cosLon * north);
+            point.vy = float(cosLon * east - sinLat * sinLon * north);
+            point.vz = float(cosLat * north);
+
+            point.altitudeFeet = float(altitudeFeet);
+            point.flight = int(i);
+            point.cell = cellKey(qint64(std::floor(point.x / cellSize)), qint64(std::floor(point.y / cellSize)),
+                                 qint64(std::floor(point.z / cellSize)));
+        }
+    });
+
+    m_points.removeIf([](const Point& point) { return point.flight < 0; });
+    std::sort(m_points.begin(), m_points.end(), [](const Point& a, const Point& b) {
+        return a.cell != b.cell ? a.cell < b.cell : a.flight < b.flight;
+    });
+
+    for (qsizetype i = 0; i < m_points.size(); ++i) {
+        if (i == 0 || m_points[i].cell != m_points[i - 1].cell) {
+            m_cellIndex.insert(m_points[i].cell, m_cellStarts.size());
+            m_cellStarts.append(i);
+        }
+    }
+    const qsizetype cellCount = m_cellStarts.size();
+    m_cellStarts.append(m_points.size());
+
+    // Each task collects its own pairs; they are merged afterwards
+    QList<QList<Conflict>> found((cellCount + SearchChunk - 1) / SearchChunk);
+    forEachChunk(cellCount, SearchChunk, [&](qsizetype first) {
+        searchCells(first, std::min(first + SearchChunk, cellCount), &found[first / SearchChunk]);
+    });
+
+    for (const QList<Conflict>& conflicts : std::as_const(found)) {
+        m_conflicts.append(conflicts);
+    }
+    std::sort(m_conflicts.begin(), m_conflicts.end(), [](const Conflict& a, const Conflict& b) {
+        if (a.distanceNm != b.distanceNm) {
+            return a.distanceNm < b.distanceNm;
+        }
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+}
+
+void ConflictDetector::searchCells(qsizetype firstCell, qsizetype lastCell, QList<Conflict>* found) const
+{
+    static const QList<qint64> neighbours = forwardNeighbours();
+
+    for (qsizetype cell = firstCell; cell < lastCell; ++cell) {
+        const qsizetype begin = m_cellStarts[cell];
+        const qsizetype end = m_cellStarts[cell + 1];
+
+        for (qsizetype i = begin; i < end; ++i) {
+            for (qsizetype j = i + 1; j < end; ++j) {
+                compare(m_points[i], m_points[j], found);
+            }
+        }
+
+        const quint64 key = m_points[begin].cell;
+        for (qint64 step : neighbours) {
+            const auto other = m_cellIndex.constFind(key + quint64(step));
+            if (other == m_cellIndex.cend()) {
+                continue;
+            }
+            const qsizetype otherBegin = m_cellStarts[*other];
+            const qsizetype otherEnd = m_cellStarts[*other + 1];
+            for (qsizetype i = begin; i < end; ++i) {
+                for (qsizetype j = otherBegin; j < otherEnd; ++j) {
+                    compare(m_points[i], m_points[j], found);
+                }
+            }
+        }
+    }
+}
+
+void ConflictDetector::compare(const Point& a, const Point& b, QList<Conflict>* found) const
+{
+    const double verticalFeet = std::abs(double(b.altitudeFeet) - a.altitudeFeet);
+    if (verticalFeet >= m_options.verticalFeet) {
+        return;
+    }
+
+    // The chord is within a hair of the arc at these distances
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double dz = b.z - a.z;
+    const double chordSquared = dx * dx + dy * dy + dz * dz;
+    if (chordSquared >= m_options.horizontalNm * m_options.horizontalNm) {
+        return;
+    }
+
+    Conflict conflict;
+    conflict.first = std::min(a.flight, b.flight);
+    conflict.second = std::max(a.flight, b.flight);
+    const double chord = std::sqrt(chordSquared);
+    conflict.distanceNm = 2.0 * EarthRadiusNm * std::asin(std::min(1.0, chord / (2.0 * EarthRadiusNm)));
+    conflict.verticalFeet = verticalFeet;
+    if (chord > 0.0) {
+        const double wx = double(b.vx) - a.vx;
+        const double wy = double(b.vy) - a.vy;
+        const double wz = double(b.vz) - a.vz;
+        conflict.closureKnots = -(dx * wx + dy * wy + dz * wz) / chord;
+    }
+    found->append(conflict);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef CONFLICTDETECTOR_H
+#define CONFLICTDETECTOR_H
+
+#include <QHash>
+#include <QList>
+#include "FlightData.h"
+
+// Finds pairs of airborne aircraft closer than the separation minima, e.g. 5 NM and 1000 ft.
+// Positions are placed on a sphere in nautical miles and hashed into cubes one horizontal
+// minimum wide, so each aircraft is only compared with those in its own and the neighbouring
+// cubes. This works the same at the poles and across the antimeridian, and the cost grows with
+// the traffic rather than with its square. Positions are found and cubes searched in parallel.
+class ConflictDetector
+{
+public:
+    struct Options
+    {
+        double horizontalNm = 5.0;          // 0 turns detection off
+        double verticalFeet = 1000.0;
+        double minAltitudeFeet = 3000.0;    // approaches to parallel runways are closer than this
+    };
+
+    struct Conflict
+    {
+        int first = -1;             // indexes into the flights passed to detect()
+        int second = -1;
+        double distanceNm = 0.0;
+        double verticalFeet = 0.0;
+        double closureKnots = 0.0;  // rate the horizontal distance shrinks at, negative when diverging
+    };
+
+    static constexpr double EarthRadiusNm = 3440.065;
+
+    void setOptions(const Options& options) { m_options = options; }
+    const Options& options() const { return m_options; }
+
+    // Replaces the conflicts with those among flights, nearest first
+    void detect(const QList<FlightData>& flights);
+    void clear();
+
+    const QList<Conflict>& conflicts() const { return m_conflicts; }
+
+private:
+    struct Point
+    {
+        double x = 0.0;         // on the sphere, nautical miles
+        double y = 0.0;
+        double z = 0.0;
+        float vx = 0.0f;        // ground velocity, knots
+        float vy = 0.0f;
+        float vz = 0.0f;
+        float altitudeFeet = 0.0f;
+        int flight = -1;
+        quint64 cell = 0;
+    };
+
+    void searchCells(qsizetype firstCell, qsizetype lastCell, QList<Conflict>* found) const;
+    void compare(const Point& a, const Point& b, QList<Conflict>* found) const;
+
+    Options m_options;
+    QList<Point> m_points;                  // airborne flights, sorted by cell
+    QList<qsizetype> m_cellStarts;          // first point of each occupied cell, then the end
+    QHash<quint64, qsizetype> m_cellIndex;  // cell -> position in m_cellStarts
+    QList<Conflict> m_conflicts;
+};
+
+#endif // CONFLICTDETECTOR_H
\ No newline at end of file
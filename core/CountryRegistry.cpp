@@ -0,0 +1,76 @@
+#include "CountryRegistry.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+bool CountryRegistry::load(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    loadFromJson(file.readAll());
+    return true;
+}
+
+void CountryRegistry::loadFromJson(const QByteArray& json)
+{
+    const QJsonArray countries = QJsonDocument::fromJson(json).array();
+
+    for (const QJsonValue& value : countries) {
+        QJsonObject country = value.toObject();
+        QString countryName = country["country"].toString();
+
+        QJsonValue continentValue = country["continent"];
+        QString continent;
+
+        if (continentValue.isArray()) {
+            QJsonArray continentArray = continentValue.toArray();
+            if (!continentArray.isEmpty()) {
+                continent = continentArray[0].toString();
+            }
+        } else {
+            continent = continentValue.toString();
+        }
+
+        if (!countryName.isEmpty() && !continent.isEmpty()) {
+            m_countryToContinent[countryName] = continent;
+        }
+    }
+}
+
+QString CountryRegistry::continentFor(const QString& country) const
+{
+    QString exactMatch = m_countryToContinent.value(country, QString());
+    if (!exactMatch.isEmpty()) {
+        return exactMatch;
+    }
+
+    QString lowerCountry = country.toLower();
+
+    if (lowerCountry == "republic of korea") {
+        return m_countryToContinent.value("South Korea", "Asia");
+    }
+
+    for (auto it = m_countryToContinent.begin(); it != m_countryToContinent.end(); ++it) {
+        QString jsonCountryName = it.key().toLower();
+        QString continent = it.value();
+
+        if (lowerCountry.contains(jsonCountryName) || jsonCountryName.contains(lowerCountry)) {
+            return continent;
+        }
+    }
+
+    // Handle common name variations
+    if (lowerCountry.contains("republic of korea")) return "Asia";
+    if (lowerCountry.contains("democratic people's republic of korea")) return "Asia";
+    if (lowerCountry.contains("netherlands")) return "Europe";
+    if (lowerCountry.contains("korea")) return "Asia";
+    if (lowerCountry.contains("moldova")) return "Europe";
+    if (lowerCountry.contains("russia")) return "Europe";
+    if (lowerCountry.contains("vietnam") || lowerCountry.contains("viet nam")) return "Asia";
+
+    return "Other";
+}
\ No newline at end of file
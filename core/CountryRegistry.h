@@ -0,0 +1,22 @@
+#ifndef COUNTRYREGISTRY_H
+#define COUNTRYREGISTRY_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+
+// Country to continent lookup backed by countries.json, tolerant of the name variants OpenSky reports
+class CountryRegistry
+{
+public:
+    bool load(const QString& path);
+    void loadFromJson(const QByteArray& json);
+
+    int size() const { return int(m_countryToContinent.size()); }
+    QString continentFor(const QString& country) const;
+
+private:
+    QMap<QString, QString> m_countryToContinent;
+};
+
+#endif // COUNTRYREGISTRY_H
\ No newline at end of file
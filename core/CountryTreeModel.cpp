@@ -0,0 +1,359 @@
+#include "CountryTreeModel.h"
+#include <QSet>
+#include <algorithm>
+
+CountryTreeModel::CountryTreeModel(QObject* parent)
+    : QAbstractItemModel(parent)
+{
+}
+
+QModelIndex CountryTreeModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (column != 0 || row < 0) {
+        return QModelIndex();
+    }
+
+    // Countries carry their continent's row + 1, continents carry 0
+    if (!parent.isValid()) {
+        return row < m_continents.size() ? createIndex(row, 0, ContinentNode) : QModelIndex();
+    }
+    if (isContinent(parent) && row < m_continents[parent.row()].count) {
+        return createIndex(row, 0, quintptr(parent.row()) + 1);
+    }
+    return QModelIndex();
+}
+
+QModelIndex CountryTreeModel::parent(const QModelIndex& child) const
+{
+    if (!child.isValid() || isContinent(child)) {
+        return QModelIndex();
+    }
+    return createIndex(int(child.internalId() - 1), 0, ContinentNode);
+}
+
+int CountryTreeModel::rowCount(const QModelIndex& parent) const
+{
+    if (!parent.isValid()) {
+        return int(m_continents.size());
+    }
+    return isContinent(parent) ? m_continents[parent.row()].count : 0;
+}
+
+int CountryTreeModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return 1;
+}
+
+int CountryTreeModel::countryId(const QModelIndex& index) const
+{
+    return m_continents[int(index.internalId() - 1)].first + index.row();
+}
+
+Qt::CheckState CountryTreeModel::checkState(int selected, int count)
+{
+    if (selected == 0) {
+        return Qt::Unchecked;
+    }
+    return selected == count ? Qt::Checked : Qt::PartiallyChecked;
+}
+
+QVariant CountryTreeModel::data(const QModelIndex& index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid)) {
+        return QVariant();
+    }
+
+    if (isContinent(index)) {
+        const Continent& continent = m_continents[index.row()];
+        switch (role) {
+        case Qt::DisplayRole:
+        case NameRole: return continent.name;
+        case Qt::CheckStateRole: return int(checkState(continent.selected, continent.count));
+        case FlightCountRole: return continent.flights;
+        case SelectedCountRole: return continent.selected;
+        case CountryCountRole: return continent.count;
+        case IsContinentRole: return true;
+        default: return QVariant();
+        }
+    }
+
+    const int id = countryId(index);
+    const Country& country = m_countries[id];
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole: return country.name;
+    case Qt::CheckStateRole: return int(m_selection.testBit(id) ? Qt::Checked : Qt::Unchecked);
+    case FlightCountRole: return country.flights;
+    case SelectedCountRole: return m_selection.testBit(id) ? 1 : 0;
+    case CountryCountRole: return 1;
+    case IsContinentRole: return false;
+    default: return QVariant();
+    }
+}
+
+bool CountryTreeModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (role != Qt::CheckStateRole || !checkIndex(index, CheckIndexOption::IndexIsValid)) {
+        return false;
+    }
+
+    // Partially checked from a click means "select the rest"
+    const bool selected = value.toInt() != Qt::Unchecked;
+    if (isContinent(index)) {
+        setContinentSelected(index.row(), selected);
+    } else {
+        setCountrySelected(countryId(index), selected);
+    }
+    return true;
+}
+
+Qt::ItemFlags CountryTreeModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    const Qt::ItemFlags flags = Qt::ItemIsEnabled | Qt::ItemIsUserCheckable;
+    return isContinent(index) ? flags | Qt::ItemIsAutoTristate : flags | Qt::ItemNeverHasChildren;
+}
+
+QHash<int, QByteArray> CountryTreeModel::roleNames() const
+{
+    return {
+        {NameRole, "name"},
+        {Qt::CheckStateRole, "checkState"},
+        {FlightCountRole, "flightCount"},
+        {SelectedCountRole, "selectedCount"},
+        {CountryCountRole, "countryCount"},
+        {IsContinentRole, "isContinent"}
+    };
+}
+
+void CountryTreeModel::setCountries(const QMap<QString, QStringList>& countriesByContinent)
+{
+    QSet<QString> deselected;
+    for (int id = 0; id < m_countries.size(); ++id) {
+        if (!m_selection.testBit(id)) {
+            deselected.insert(m_countries[id].name);
+        }
+    }
+
+    beginResetModel();
+    m_continents.clear();
+    m_countries.clear();
+    m_ids.clear();
+
+    for (auto it = countriesByContinent.cbegin(); it != countriesByContinent.cend(); ++it) {
+        Continent continent;
+        continent.name = it.key();
+        continent.first = int(m_countries.size());
+        for (const QString& name : it.value()) {
+            if (m_ids.contains(name)) {
+                continue;
+            }
+            m_ids.insert(name, int(m_countries.size()));
+            m_countries.append(Country{name, int(m_continents.size()), 0, -1});
+        }
+        continent.count = int(m_countries.size()) - continent.first;
+        m_continents.append(continent);
+    }
+
+    m_selection = QBitArray(m_countries.size(), true);
+    m_selectedCount = int(m_countries.size());
+    for (const QString& name : std::as_const(deselected)) {
+        const int id = m_ids.value(name, -1);
+        if (id >= 0) {
+            m_selection.clearBit(id);
+            --m_selectedCount;
+        }
+    }
+    for (Continent& continent : m_continents) {
+        continent.selected = 0;
+        for (int id = continent.first; id < continent.first + continent.count; ++id) {
+            continent.selected += m_selection.testBit(id);
+        }
+    }
+    m_flightCount = 0;
+    m_mappedStatsCountries = 0;
+    endResetModel();
+
+    emit countriesChanged();
+    emit selectionChanged();
+    emit flightCountsChanged();
+}
+
+int CountryTreeModel::allCheckState() const
+{
+    return int(checkState(m_selectedCount, int(m_countries.size())));
+}
+
+QStringList CountryTreeModel::selectedCountries() const
+{
+    QStringList selected;
+    selected.reserve(m_selectedCount);
+    for (int id = 0; id < m_countries.size(); ++id) {
+        if (m_selection.testBit(id)) {
+            selected.append(m_countries[id].name);
+        }
+    }
+    std::sort(selected.begin(), selected.end());
+    return selected;
+}
+
+void CountryTreeModel::setSelectedCountries(const QStringList& countries)
+{
+    QBitArray selection(m_countries.size());
+    for (const QString& name : countries) {
+        const int id = m_ids.value(name, -1);
+        if (id >= 0) {
+            selection.setBit(id);
+        }
+    }
+    if (selection == m_selection) {
+        return;
+    }
+
+    m_selection = selection;
+    m_selectedCount = int(m_selection.count(true));
+    for (Continent& continent : m_continents) {
+        continent.selected = 0;
+        for (int id = continent.first; id < continent.first + continent.count; ++id) {
+            continent.selected += m_selection.testBit(id);
+        }
+    }
+    emitSelectionReset();
+}
+
+void CountryTreeModel::setCountrySelected(int id, bool selected)
+{
+    if (id < 0 || id >= m_countries.size() || m_selection.testBit(id) == selected) {
+        return;
+    }
+
+    m_selection.setBit(id, selected);
+    const int delta = selected ? 1 : -1;
+    m_selectedCount += delta;
+
+    const int row = m_countries[id].continent;
+    Continent& continent = m_continents[row];
+    continent.selected += delta;
+
+    const QModelIndex country = index(id - continent.first, 0, index(row, 0));
+    emit dataChanged(country, country, {Qt::CheckStateRole, SelectedCountRole});
+    emitContinentChanged(row, {Qt::CheckStateRole, SelectedCountRole});
+    emit selectionChanged();
+}
+
+void CountryTreeModel::setContinentSelected(int row, bool selected)
+{
+    if (row < 0 || row >= m_continents.size()) {
+        return;
+    }
+
+    Continent& continent = m_continents[row];
+    const int target = selected ? continent.count : 0;
+    if (continent.selected == target) {
+        return;
+    }
+
+    m_selection.fill(selected, continent.first, continent.first + continent.count);
+    m_selectedCount += target - continent.selected;
+    continent.selected = target;
+
+    const QModelIndex parent = index(row, 0);
+    if (continent.count > 0) {
+        emit dataChanged(index(0, 0, parent), index(continent.count - 1, 0, parent),
+                         {Qt::CheckStateRole, SelectedCountRole});
+    }
+    emitContinentChanged(row, {Qt::CheckStateRole, SelectedCountRole});
+    emit selectionChanged();
+}
+
+void CountryTreeModel::setAllSelected(bool selected)
+{
+    const int target = selected ? int(m_countries.size()) : 0;
+    if (m_selectedCount == target) {
+        return;
+    }
+
+    m_selection.fill(selected);
+    m_selectedCount = target;
+    for (Continent& continent : m_continents) {
+        continent.selected = selected ? continent.count : 0;
+    }
+    emitSelectionReset();
+}
+
+void CountryTreeModel::mapStatsIds(const TrafficStats& stats)
+{
+    // The stats only add countries until they are cleared, so only new ones are looked up
+    const QStringList& names = stats.countries();
+    if (names.size() < m_mappedStatsCountries) {
+        for (Country& country : m_countries) {
+            country.statsId = -1;
+        }
+        m_mappedStatsCountries = 0;
+    }
+    for (int statsId = m_mappedStatsCountries; statsId < names.size(); ++statsId) {
+        const int id = m_ids.value(names[statsId], -1);
+        if (id >= 0) {
+            m_countries[id].statsId = statsId;
+        }
+    }
+    m_mappedStatsCountries = int(names.size());
+}
+
+void CountryTreeModel::updateFlightCounts(const TrafficStats& stats)
+{
+    mapStatsIds(stats);
+
+    int total = 0;
+    for (int row = 0; row < m_continents.size(); ++row) {
+        Continent& continent = m_continents[row];
+        const QModelIndex parent = index(row, 0);
+        for (int i = 0; i < continent.count; ++i) {
+            Country& country = m_countries[continent.first + i];
+            const int flights = country.statsId >= 0 ? stats.countryCount(country.statsId) : 0;
+            total += flights;
+            if (country.flights != flights) {
+                country.flights = flights;
+                const QModelIndex changed = index(i, 0, parent);
+                emit dataChanged(changed, changed, {FlightCountRole});
+            }
+        }
+
+        // A handful of continents, so finding each by name costs nothing
+        const int statsContinent = int(stats.continents().indexOf(continent.name));
+        const int flights = statsContinent >= 0 ? stats.continentCount(statsContinent) : 0;
+        if (continent.flights != flights) {
+            continent.flights = flights;
+            emitContinentChanged(row, {FlightCountRole});
+        }
+    }
+
+    if (m_flightCount != total) {
+        m_flightCount = total;
+        emit flightCountsChanged();
+    }
+}
+
+void CountryTreeModel::emitContinentChanged(int row, const QList<int>& roles)
+{
+    const QModelIndex continent = index(row, 0);
+    emit dataChanged(continent, continent, roles);
+}
+
+void CountryTreeModel::emitSelectionReset()
+{
+    for (int row = 0; row < m_continents.size(); ++row) {
+        const QModelIndex parent = index(row, 0);
+        if (m_continents[row].count > 0) {
+            emit dataChanged(index(0, 0, parent), index(m_continents[row].count - 1, 0, parent),
+                             {Qt::CheckStateRole, SelectedCountRole});
+        }
+    }
+    if (!m_continents.isEmpty()) {
+        emit dataChanged(index(0, 0), index(int(m_continents.size()) - 1, 0), {Qt::CheckStateRole, SelectedCountRole});
+    }
+    emit selectionChanged();
+}
\ No newline at end of file
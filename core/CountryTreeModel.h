@@ -0,0 +1,112 @@
+#ifndef COUNTRYTREEMODEL_H
+#define COUNTRYTREEMODEL_H
+
+#include <QAbstractItemModel>
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QStringList>
+#include "TrafficStats.h"
+
+// The filter panel's continent/country tree. Each country has an id, and countries are stored
+// contiguously by continent, so a continent is a range of ids. Selection is one bit per country.
+// Toggling a country flips one bit and bumps its continent's counter. A continent's check state
+// comes from that counter without walking its countries. FlightFilter reads the bits directly.
+//
+// Continents are the top-level rows and countries their children. Every node also carries the
+// number of current flights it covers.
+class CountryTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int countryCount READ countryCount NOTIFY countriesChanged)
+    Q_PROPERTY(int selectedCount READ selectedCount NOTIFY selectionChanged)
+    Q_PROPERTY(int allCheckState READ allCheckState NOTIFY selectionChanged)
+    Q_PROPERTY(int flightCount READ flightCount NOTIFY flightCountsChanged)
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        FlightCountRole,
+        SelectedCountRole,
+        CountryCountRole,
+        IsContinentRole
+    };
+
+    explicit CountryTreeModel(QObject* parent = nullptr);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Replaces the tree. Countries that were deselected stay deselected; new ones are selected.
+    void setCountries(const QMap<QString, QStringList>& countriesByContinent);
+
+    int countryCount() const { return int(m_countries.size()); }
+    int selectedCount() const { return m_selectedCount; }
+    int allCheckState() const;
+    int flightCount() const { return m_flightCount; }
+
+    // Ids index selection(); names not in countryIds() are not in the tree
+    const QHash<QString, int>& countryIds() const { return m_ids; }
+    const QBitArray& selection() const { return m_selection; }
+
+    QStringList selectedCountries() const;
+    void setSelectedCountries(const QStringList& countries);
+
+    Q_INVOKABLE void setCountrySelected(int id, bool selected);
+    Q_INVOKABLE void setContinentSelected(int row, bool selected);
+    Q_INVOKABLE void setAllSelected(bool selected);
+
+    // Takes the per-country and per-continent counts from stats by their ids there; only nodes
+    // whose count changed are reported
+    void updateFlightCounts(const TrafficStats& stats);
+
+signals:
+    void countriesChanged();
+    void selectionChanged();
+    void flightCountsChanged();
+
+private:
+    struct Continent
+    {
+        QString name;
+        int first = 0;
+        int count = 0;
+        int selected = 0;
+        int flights = 0;
+    };
+
+    struct Country
+    {
+        QString name;
+        int continent = 0;
+        int flights = 0;
+        int statsId = -1;   // id in TrafficStats, -1 until the stats have seen it
+    };
+
+    static constexpr quintptr ContinentNode = 0;
+
+    bool isContinent(const QModelIndex& index) const { return index.internalId() == ContinentNode; }
+    int countryId(const QModelIndex& index) const;
+    static Qt::CheckState checkState(int selected, int count);
+    void emitContinentChanged(int row, const QList<int>& roles);
+    void emitSelectionReset();
+    void mapStatsIds(const TrafficStats& stats);
+
+    QList<Continent> m_continents;
+    QList<Country> m_countries;
+    QHash<QString, int> m_ids;
+    QBitArray m_selection;
+    int m_selectedCount = 0;
+    int m_flightCount = 0;
+    int m_mappedStatsCountries = 0;     // stats countries already given a statsId
+};
+
+#endif // COUNTRYTREEMODEL_H
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "DensityGrid.h"
+#include "TraceRecorder.h"
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+// Flights per task; below this the threads cost more than they save
+constexpr qsizetype BinChunk = 8192;
+
+// Row n of Pascal's triangle, normalized, as a discrete Gaussian
+QList<float> binomialKernel(int radius)
+{
+    QList<float> kernel(2 * radius + 1, 0.0f);
+    kernel[0] = 1.0f;
+    for (int n = 1; n < kernel.size(); ++n) {
+        for (int k = n; k > 0; --k) {
+            kernel[k] += kernel[k - 1];
+        }
+    }
+    float sum = 0.0f;
+    for (float weight : std::as_const(kernel)) {
+        sum += weight;
+    }
+    for (float& weight : kernel) {
+        weight /= sum;
+    }
+    return kernel;
+}
+}
+
+DensityGrid::DensityGrid(const Options& options)
+{
+    setOptions(options);
+}
+
+void DensityGrid::setOptions(const Options& options)
+{
+    m_options = options;
+    m_options.size = std::max(1, m_options.size);
+    m_options.blurRadius = std::clamp(m_options.blurRadius, 0, m_options.size / 2);
+    clear();
+}
+
+void DensityGrid::clear()
+{
+    m_values.fill(0.0f, qsizetype(m_options.size) * m_options.size);
+    m_maxValue = 0.0f;
+    m_flightCount = 0;
+}
+
+void DensityGrid::build(const QList<FlightData>& flights, const QList<bool>& visible)
+{
+    TraceScope trace("density", "pipeline", QString::number(flights.size()));
+    clear();
+
+    // Projection dominates, so cells are found in parallel and counted afterwards
+    const int size = m_options.size;
+    const double cellsPerMeter = size / (2.0 * HalfExtent);
+    m_cells.resize(flights.size());
+
+    auto binRange = [&](qsizetype first) {
+        const qsizetype last = std::min(first + BinChunk, flights.size());
+        for (qsizetype i = first; i < last; ++i) {
+            if (i >= visible.size() || !visible[i]) {
+                m_cells[i] = -1;
+                continue;
+            }
+            const QPointF p = WebMercator::project(flights[i].longitude(), flights[i].latitude());
+            const int column = std::clamp(int((p.x() + HalfExtent) * cellsPerMeter), 0, size - 1);
+            const int row = std::clamp(int((HalfExtent - p.y()) * cellsPerMeter), 0, size - 1);
+            m_cells[i] = row * size + column;
+        }
+    };
+
+    QList<qsizetype> chunks;
+    for (qsizetype first = 0; first < flights.size(); first += BinChunk) {
+        chunks.append(first);
+    }
+    if (chunks.size() > 1 && QThread::idealThreadCount() > 1) {
+        QtConcurrent::blockingMap(chunks, binRange);
+    } else {
+        for (qsizetype first : std::as_const(chunks)) {
+            binRange(first);
+        }
+    }
+
+    for (int cell : std::as_const(m_cells)) {
+        if (cell >= 0) {
+            m_values[cell] += 1.0f;
+            ++m_flightCount;
+        }
+    }
+
+    blur();
+    m_maxValue = m_values.isEmpty() ? 0.0f : *std::max_element(m_values.cbegin(), m_values.cend());
+}
+
+void DensityGrid::blur()
+{
+    const int radius = m_options.blurRadius;
+    if (radius == 0 || m_flightCount == 0) {
+        return;
+    }
+
+    const int size = m_options.size;
+    const QList<float> kernel = binomialKernel(radius);
+    m_scratch.resize(m_values.size());
+
+    // Horizontal then vertical; edges clamp so nothing leaks off the map
+    for (int row = 0; row < size; ++row) {
+        const float* in = m_values.constData() + qsizetype(row) * size;
+        float* out = m_scratch.data() + qsizetype(row) * size;
+        for (int column = 0; column < size; ++column) {
+            float sum = 0.0f;
+            for (int k = -radius; k <= radius; ++k) {
+                sum += kernel[k + radius] * in[std::clamp(column + k, 0, size - 1)];
+            }
+            out[column] = sum;
+        }
+    }
+    for (int row = 0; row < size; ++row) {
+        float* out = m_values.data() + qsizetype(row) * size;
+        for (int column = 0; column < size; ++column) {
+            float sum = 0.0f;
+            for (int k = -radius; k <= radius; ++k) {
+                sum += kernel[k + radius] * m_scratch[qsizetype(std::clamp(row + k, 0, size - 1)) * size + column];
+            }
+            out[column] = sum;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef DENSITYGRID_H
+#define DENSITYGRID_H
+
+#include <QList>
+#include "FlightData.h"
+#include "WebMercator.h"
+
+// Traffic density over the whole Web Mercator square, for drawing as one image when aircraft
+// are too small to tell apart. Positions are projected and binned into cells in parallel, then
+// blurred with a small separable kernel so sparse traffic still reads as a patch.
+// Row 0 is the northern edge, so the values lay out like an image.
+class DensityGrid
+{
+public:
+    struct Options
+    {
+        int size = 512;         // cells along each side
+        int blurRadius = 2;     // binomial kernel of 2 * radius + 1 taps, 0 for none
+    };
+
+    // Half the width of the square the grid covers, in Web Mercator meters
+    static constexpr double HalfExtent = M_PI * WebMercator::EarthRadiusMeters;
+
+    DensityGrid() = default;
+    explicit DensityGrid(const Options& options);
+
+    void setOptions(const Options& options);
+    const Options& options() const { return m_options; }
+
+    // Replaces the grid with the flights whose visible flag is set
+    void build(const QList<FlightData>& flights, const QList<bool>& visible);
+    void clear();
+
+    int size() const { return m_options.size; }
+    const QList<float>& values() const { return m_values; }
+    float value(int column, int row) const { return m_values[row * m_options.size + column]; }
+    float maxValue() const { return m_maxValue; }
+    int flightCount() const { return m_flightCount; }
+
+private:
+    void blur();
+
+    Options m_options;
+    QList<float> m_values;
+    QList<float> m_scratch;
+    QList<int> m_cells;
+    float m_maxValue = 0.0f;
+    int m_flightCount = 0;
+};
+
+#endif // DENSITYGRID_H
\ No newline at end of file
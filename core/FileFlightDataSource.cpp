@@ -0,0 +1,68 @@
+#include "FileFlightDataSource.h"
+#include "TraceRecorder.h"
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QDebug>
+
+FileFlightDataSource::FileFlightDataSource(const QString& rootPath, QObject *parent)
+    : FlightDataSource(parent)
+    , m_rootPath(rootPath)
+{
+    QDir statesDir(QDir(rootPath).filePath("states"));
+    for (const QString& name : statesDir.entryList({"*.json"}, QDir::Files, QDir::Name)) {
+        m_stateFiles.append(statesDir.filePath(name));
+    }
+
+    qDebug() << "File data source:" << m_stateFiles.size() << "snapshots in" << rootPath;
+}
+
+void FileFlightDataSource::fetchFlightData()
+{
+    if (m_stateFiles.isEmpty()) {
+        // Delivered asynchronously like a network reply
+        QTimer::singleShot(0, this, [this]() {
+            emit dataFetchFailed(QString("No state fixtures in %1/states").arg(m_rootPath));
+        });
+        return;
+    }
+
+    const QString path = m_stateFiles[m_nextState];
+    m_nextState = (m_nextState + 1) % m_stateFiles.size();
+
+    QTimer::singleShot(0, this, [this, path]() {
+        TraceScope trace("fetch states", "source", path);
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            emit dataFetchFailed(QString("Could not read %1: %2").arg(path, file.errorString()));
+            return;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        const QByteArray data = file.readAll();
+        m_lastFetchTiming.fetchMs = timer.nsecsElapsed() / 1e6;
+
+        timer.restart();
+        QList<FlightData> flights = decodeStates(data);
+        m_lastFetchTiming.decodeMs = timer.nsecsElapsed() / 1e6;
+
+        emit flightDataReceived(flights);
+    });
+}
+
+void FileFlightDataSource::fetchFlightTrack(const QString& icao24)
+{
+    const QString path = QDir(m_rootPath).filePath(QString("tracks/%1.json").arg(icao24.toLower()));
+
+    QTimer::singleShot(0, this, [this, icao24, path]() {
+        TraceScope trace("fetch track", "track", icao24);
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            emit dataFetchFailed(QString("No track fixture for %1").arg(icao24));
+            return;
+        }
+        emit trackDataReceived(icao24, QJsonDocument::fromJson(file.readAll()).object());
+    });
+}
\ No newline at end of file
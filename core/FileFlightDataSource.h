@@ -0,0 +1,32 @@
+#ifndef FILEFLIGHTDATASOURCE_H
+#define FILEFLIGHTDATASOURCE_H
+
+#include <QStringList>
+#include "FlightDataSource.h"
+
+// Serves flight data from fixture files, no network or credentials needed.
+//
+// Directory layout (shared with the OpenSky stand-in server):
+//   <root>/states/*.json        /states/all responses, one per refresh, cycled in name order
+//   <root>/tracks/<icao24>.json /tracks/all responses
+class FileFlightDataSource : public FlightDataSource
+{
+    Q_OBJECT
+
+public:
+    explicit FileFlightDataSource(const QString& rootPath, QObject *parent = nullptr);
+
+    bool requiresAuthentication() const override { return false; }
+    void fetchFlightData() override;
+    void fetchFlightTrack(const QString& icao24) override;
+
+    QString rootPath() const { return m_rootPath; }
+    int snapshotCount() const { return int(m_stateFiles.size()); }
+
+private:
+    QString m_rootPath;
+    QStringList m_stateFiles;
+    int m_nextState = 0;
+};
+
+#endif // FILEFLIGHTDATASOURCE_H
\ No newline at end of file
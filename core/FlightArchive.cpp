@@ -0,0 +1,415 @@
+#include "FlightArchive.h"
+#include <QFileInfo>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+constexpr quint32 ArchiveMagic = 0x46544152; // "FTAR"
+constexpr quint16 ArchiveVersion = 3;
+constexpr quint32 IndexMagic = 0x46544958;   // "FTIX"
+constexpr quint16 IndexVersion = 1;
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_5;
+
+// type + timestamp + payload size
+constexpr qint64 FrameHeaderSize = sizeof(quint8) + sizeof(qint64) + sizeof(quint32);
+
+enum FrameType : quint8 {
+    KeyframeFrame = 1,
+    DeltaFrame = 2
+};
+}
+
+// FlightArchiveIndex
+
+QString FlightArchiveIndex::indexPathFor(const QString& archivePath)
+{
+    return archivePath + ".idx";
+}
+
+bool FlightArchiveIndex::writeHeader(QDataStream& out)
+{
+    out << IndexMagic << IndexVersion;
+    return out.status() == QDataStream::Ok;
+}
+
+bool FlightArchiveIndex::readHeader(QDataStream& in)
+{
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    return in.status() == QDataStream::Ok && magic == IndexMagic && version == IndexVersion;
+}
+
+void FlightArchiveIndex::writeEntry(QDataStream& out, const Entry& entry)
+{
+    out << entry.timestamp << entry.offset;
+}
+
+bool FlightArchiveIndex::load(const QString& path)
+{
+    m_entries.clear();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(StreamVersion);
+    if (!readHeader(in)) {
+        return false;
+    }
+
+    m_entries.reserve((file.size() - file.pos()) / qint64(2 * sizeof(qint64)));
+    while (!file.atEnd()) {
+        Entry entry;
+        in >> entry.timestamp >> entry.offset;
+        if (in.status() != QDataStream::Ok) {
+            // Drop a partially written trailing entry
+            break;
+        }
+        m_entries.append(entry);
+    }
+    return true;
+}
+
+bool FlightArchiveIndex::save(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(StreamVersion);
+    writeHeader(out);
+    for (const Entry& entry : m_entries) {
+        writeEntry(out, entry);
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+const FlightArchiveIndex::Entry* FlightArchiveIndex::keyframeFor(qint64 timestamp) const
+{
+    if (m_entries.isEmpty()) {
+        return nullptr;
+    }
+
+    auto it = std::upper_bound(m_entries.cbegin(), m_entries.cend(), timestamp,
+                               [](qint64 value, const Entry& entry) { return value < entry.timestamp; });
+    if (it == m_entries.cbegin()) {
+        return &m_entries.first();
+    }
+    return &*(it - 1);
+}
+
+// FlightArchiveWriter
+
+FlightArchiveWriter::~FlightArchiveWriter()
+{
+    close();
+}
+
+bool FlightArchiveWriter::open(const QString& path)
+{
+    close();
+
+    // Appending is only allowed onto an archive of the same format
+    if (QFileInfo(path).size() > 0) {
+        QFile existing(path);
+        if (existing.open(QIODevice::ReadOnly)) {
+            QDataStream in(&existing);
+            in.setVersion(StreamVersion);
+            quint32 magic = 0;
+            quint16 version = 0;
+            in >> magic >> version;
+            if (magic != ArchiveMagic || version != ArchiveVersion) {
+                m_error = QString("Cannot append to %1: not a version %2 flight archive").arg(path).arg(ArchiveVersion);
+                return false;
+            }
+        }
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        m_error = QString("Could not open archive %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(StreamVersion);
+
+    // Appending to an existing recording keeps its header
+    if (m_file.size() == 0) {
+        m_stream << ArchiveMagic << ArchiveVersion;
+        m_file.flush();
+    }
+
+    m_indexFile.setFileName(FlightArchiveIndex::indexPathFor(path));
+    if (m_indexFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        m_indexStream.setDevice(&m_indexFile);
+        m_indexStream.setVersion(StreamVersion);
+        if (m_indexFile.size() == 0) {
+            FlightArchiveIndex::writeHeader(m_indexStream);
+        }
+    } else {
+        // The reader rebuilds a missing index by scanning frame headers
+        qWarning() << "Could not open archive index" << m_indexFile.fileName();
+    }
+
+    // Every recording session starts with a keyframe
+    m_encoder.reset();
+    m_sinceKeyframe = 0;
+    m_bytesWritten = 0;
+
+    return m_stream.status() == QDataStream::Ok;
+}
+
+void FlightArchiveWriter::close()
+{
+    if (m_file.isOpen()) {
+        m_file.flush();
+        m_file.close();
+    }
+    if (m_indexFile.isOpen()) {
+        m_indexFile.flush();
+        m_indexFile.close();
+    }
+    m_stream.setDevice(nullptr);
+    m_indexStream.setDevice(nullptr);
+}
+
+bool FlightArchiveWriter::append(const FlightSnapshot& snapshot)
+{
+    if (!m_file.isOpen()) {
+        m_error = "Archive is not open";
+        return false;
+    }
+
+    const bool keyframe = m_sinceKeyframe == 0;
+
+    const QByteArray payload = keyframe ? m_encoder.encodeKeyframe(snapshot.flights)
+                                        : m_encoder.encodeDelta(snapshot.flights);
+
+    const qint64 offset = m_file.size();
+    m_stream << quint8(keyframe ? KeyframeFrame : DeltaFrame) << snapshot.timestamp << quint32(payload.size());
+    m_stream.writeRawData(payload.constData(), int(payload.size()));
+    m_file.flush();
+
+    if (m_stream.status() != QDataStream::Ok) {
+        m_error = QString("Failed writing snapshot: %1").arg(m_file.errorString());
+        return false;
+    }
+
+    m_bytesWritten += FrameHeaderSize + payload.size();
+
+    if (keyframe && m_indexFile.isOpen()) {
+        FlightArchiveIndex::writeEntry(m_indexStream, {snapshot.timestamp, offset});
+        m_indexFile.flush();
+    }
+
+    m_sinceKeyframe = (m_sinceKeyframe + 1) % m_keyframeInterval;
+    return true;
+}
+
+// FlightArchiveReader
+
+bool FlightArchiveReader::open(const QString& path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QString("Could not open archive %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(StreamVersion);
+
+    if (!readHeader()) {
+        close();
+        return false;
+    }
+
+    loadIndex(path);
+    rewind();
+    return true;
+}
+
+void FlightArchiveReader::close()
+{
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_stream.setDevice(nullptr);
+    m_index.clear();
+    m_decoder.reset();
+    m_state.reset({});
+    m_dataStart = 0;
+}
+
+bool FlightArchiveReader::readHeader()
+{
+    quint32 magic = 0;
+    m_version = 0;
+    m_stream >> magic >> m_version;
+
+    if (magic != ArchiveMagic) {
+        m_error = "Not a flight archive";
+        return false;
+    }
+    if (m_version != ArchiveVersion) {
+        m_error = QString("Unsupported archive version %1").arg(m_version);
+        return false;
+    }
+
+    m_dataStart = m_file.pos();
+    return true;
+}
+
+void FlightArchiveReader::loadIndex(const QString& path)
+{
+    const QString indexPath = FlightArchiveIndex::indexPathFor(path);
+
+    // Trust the sidecar only if it starts at the first frame and points inside the archive
+    qint64 scanFrom = m_dataStart;
+    if (m_index.load(indexPath) && !m_index.isEmpty()
+        && m_index.entries().first().offset == m_dataStart
+        && m_index.entries().last().offset < m_file.size()) {
+        scanFrom = m_index.entries().last().offset;
+    } else {
+        m_index.clear();
+    }
+
+    // Pick up keyframes written after the sidecar was last flushed
+    const qsizetype indexedCount = m_index.entries().size();
+    m_file.seek(scanFrom);
+    m_stream.resetStatus();
+
+    FrameHeader header;
+    qint64 frameStart = m_file.pos();
+    while (readFrameHeader(header)) {
+        const bool alreadyIndexed = !m_index.isEmpty() && m_index.entries().last().offset == frameStart;
+        if (header.type == KeyframeFrame && !alreadyIndexed) {
+            m_index.append({header.timestamp, frameStart});
+        }
+        frameStart += FrameHeaderSize + header.size;
+        m_file.seek(frameStart);
+    }
+
+    if (m_index.entries().size() != indexedCount) {
+        qDebug() << "FlightArchiveReader: indexed" << m_index.entries().size() - indexedCount << "keyframes";
+        m_index.save(indexPath); // best effort, the archive may be on read-only storage
+    }
+}
+
+bool FlightArchiveReader::readFrameHeader(FrameHeader& header)
+{
+    if (atEnd()) {
+        return false;
+    }
+
+    const qint64 start = m_file.pos();
+    m_stream >> header.type >> header.timestamp >> header.size;
+
+    if (m_stream.status() != QDataStream::Ok || start + FrameHeaderSize + header.size > m_file.size()) {
+        // A recording cut off mid-write ends at the last complete snapshot
+        qDebug() << "FlightArchiveReader: truncated frame at offset" << start;
+        m_stream.resetStatus();
+        m_file.seek(m_file.size());
+        return false;
+    }
+    return true;
+}
+
+bool FlightArchiveReader::applyFrame(const FrameHeader& header, const QByteArray& payload)
+{
+    if (header.type != KeyframeFrame && header.type != DeltaFrame) {
+        m_error = QString("Unknown frame type %1").arg(header.type);
+        return false;
+    }
+
+    // Keyframes start a fresh dictionary and state
+    if (header.type == KeyframeFrame) {
+        m_decoder.reset();
+        m_state.reset({});
+    }
+
+    FlightSnapshotDelta delta;
+    if (!m_decoder.decode(payload, delta)) {
+        m_error = "Corrupt snapshot payload";
+        return false;
+    }
+
+    m_state.apply(delta);
+    return true;
+}
+
+bool FlightArchiveReader::atEnd() const
+{
+    return !m_file.isOpen() || m_file.atEnd();
+}
+
+bool FlightArchiveReader::readNext(FlightSnapshot& snapshot)
+{
+    FrameHeader header;
+    if (!readFrameHeader(header)) {
+        return false;
+    }
+
+    QByteArray payload(header.size, Qt::Uninitialized);
+    if (m_stream.readRawData(payload.data(), int(header.size)) != int(header.size)
+        || !applyFrame(header, payload)) {
+        qDebug() << "FlightArchiveReader:" << m_error;
+        m_file.seek(m_file.size());
+        return false;
+    }
+
+    snapshot.timestamp = header.timestamp;
+    snapshot.flights = m_state.flights();
+    return true;
+}
+
+void FlightArchiveReader::rewind()
+{
+    if (m_file.isOpen()) {
+        m_file.seek(m_dataStart);
+        m_stream.resetStatus();
+    }
+    m_decoder.reset();
+    m_state.reset({});
+}
+
+bool FlightArchiveReader::seek(qint64 timestamp)
+{
+    const FlightArchiveIndex::Entry* keyframe = m_index.keyframeFor(timestamp);
+    if (!m_file.isOpen() || !keyframe) {
+        return false;
+    }
+
+    m_file.seek(keyframe->offset);
+    m_stream.resetStatus();
+    m_decoder.reset();
+    m_state.reset({});
+
+    // Roll the keyframe forward through deltas that precede the target
+    while (true) {
+        const qint64 frameStart = m_file.pos();
+        FrameHeader header;
+        if (!readFrameHeader(header)) {
+            return false;
+        }
+
+        if (header.timestamp >= timestamp) {
+            m_file.seek(frameStart);
+            return true;
+        }
+
+        QByteArray payload(header.size, Qt::Uninitialized);
+        if (m_stream.readRawData(payload.data(), int(header.size)) != int(header.size)
+            || !applyFrame(header, payload)) {
+            return false;
+        }
+    }
+}
\ No newline at end of file
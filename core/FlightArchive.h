@@ -0,0 +1,120 @@
+#ifndef FLIGHTARCHIVE_H
+#define FLIGHTARCHIVE_H
+
+#include <QString>
+#include <QList>
+#include <QFile>
+#include <QDataStream>
+#include "FlightSnapshot.h"
+#include "SnapshotCodec.h"
+
+// Sparse time index kept beside an archive: one entry per keyframe
+class FlightArchiveIndex
+{
+public:
+    struct Entry
+    {
+        qint64 timestamp = 0;
+        qint64 offset = 0;
+    };
+
+    static QString indexPathFor(const QString& archivePath);
+
+    bool load(const QString& path);
+    bool save(const QString& path) const;
+    void clear() { m_entries.clear(); }
+
+    void append(const Entry& entry) { m_entries.append(entry); }
+    const QList<Entry>& entries() const { return m_entries; }
+    bool isEmpty() const { return m_entries.isEmpty(); }
+
+    // Latest keyframe at or before timestamp, or the first keyframe when timestamp precedes the archive
+    const Entry* keyframeFor(qint64 timestamp) const;
+
+    static void writeEntry(QDataStream& out, const Entry& entry);
+    static bool writeHeader(QDataStream& out);
+    static bool readHeader(QDataStream& in);
+
+private:
+    QList<Entry> m_entries;
+};
+
+// Appends snapshots to a recording file that FlightArchiveReader can play back.
+// Every keyframeInterval snapshots a full keyframe is written; the rest are deltas.
+// Frame payloads use SnapshotEncoder.
+class FlightArchiveWriter
+{
+public:
+    FlightArchiveWriter() = default;
+    ~FlightArchiveWriter();
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_error; }
+
+    void setKeyframeInterval(int snapshots) { m_keyframeInterval = qMax(1, snapshots); }
+    int keyframeInterval() const { return m_keyframeInterval; }
+
+    bool append(const FlightSnapshot& snapshot);
+
+    // Encoded frame bytes written since open()
+    qint64 bytesWritten() const { return m_bytesWritten; }
+
+private:
+    QFile m_file;
+    QDataStream m_stream;
+    QFile m_indexFile;
+    QDataStream m_indexStream;
+    SnapshotEncoder m_encoder;
+    qint64 m_bytesWritten = 0;
+    int m_keyframeInterval = 30;
+    int m_sinceKeyframe = 0;
+    QString m_error;
+};
+
+// Reader over a recording written by FlightArchiveWriter that reconstructs full snapshots
+class FlightArchiveReader
+{
+public:
+    FlightArchiveReader() = default;
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_error; }
+
+    bool atEnd() const;
+    bool readNext(FlightSnapshot& snapshot);
+
+    // Positions the reader so the next snapshot read is the first one at or after timestamp.
+    // Starts from the nearest keyframe, so cost is bounded by the writer's keyframe interval.
+    bool seek(qint64 timestamp);
+    void rewind();
+
+    const FlightArchiveIndex& index() const { return m_index; }
+
+private:
+    struct FrameHeader
+    {
+        quint8 type = 0;
+        qint64 timestamp = 0;
+        quint32 size = 0;
+    };
+
+    bool readHeader();
+    bool readFrameHeader(FrameHeader& header);
+    bool applyFrame(const FrameHeader& header, const QByteArray& payload);
+    void loadIndex(const QString& path);
+
+    QFile m_file;
+    QDataStream m_stream;
+    FlightArchiveIndex m_index;
+    SnapshotDecoder m_decoder;
+    FlightSnapshotState m_state;
+    qint64 m_dataStart = 0;
+    quint16 m_version = 0;
+    QString m_error;
+};
+
+#endif // FLIGHTARCHIVE_H
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "FlightClassifier.h"
+
+int FlightClassifier::categoryFromCallsign(const QString& callsign)
+{
+    if (callsign.isEmpty()) return 1;
+
+    QString trimmed = callsign.trimmed();
+    int length = trimmed.length();
+    int digitCount = 0;
+
+    for (QChar c : trimmed) {
+        if (c.isDigit()) digitCount++;
+    }
+
+    // US N-number pattern
+    if (trimmed.startsWith('N') && digitCount >= 2) return 2;
+
+    // Cargo indicators
+    if (trimmed.contains("FDX") || trimmed.contains("UPS") ||
+        trimmed.contains("CARGO") || trimmed.contains("ABX")) return 6;
+
+    // Emergency/helicopter indicators
+    if (trimmed.contains("MED") || trimmed.contains("RESCUE") ||
+        trimmed.contains("LIFE") || trimmed.contains("HELI")) return 8;
+
+    // Size-based categorization
+    if (length <= 5) return 3;
+    else if (length <= 7) return 4;
+    else return 3;
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef FLIGHTCLASSIFIER_H
+#define FLIGHTCLASSIFIER_H
+
+#include <QString>
+
+// Aircraft category guessed from a callsign, used to pick a flight icon:
+// 1 unknown, 2 general aviation, 3 small, 4 airliner, 6 cargo, 8 emergency/helicopter
+class FlightClassifier
+{
+public:
+    static int categoryFromCallsign(const QString& callsign);
+};
+
+#endif // FLIGHTCLASSIFIER_H
\ No newline at end of file
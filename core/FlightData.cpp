@@ -0,0 +1,59 @@
+#include "FlightData.h"
+#include <QJsonArray>
+#include <cmath>
+
+FlightData::FlightData(const QJsonArray& data)
+{
+    if (data.size() >= 17) {
+        m_icao24 = data[0].toString();
+        m_callsign = data[1].toString().trimmed();
+        m_country = data[2].toString();
+        m_longitude = data[5].toDouble();
+        m_latitude = data[6].toDouble();
+        m_altitude = data[7].toDouble();
+        m_onGround = data[8].toBool();
+        m_velocity = data[9].toDouble();
+        m_heading = data[10].toDouble();
+        m_verticalRate = data[11].toDouble();
+        m_squawk = data[14].toString();
+
+        // Valid if we have basic coordinate data
+        m_valid = (m_longitude != 0.0 || m_latitude != 0.0) && !m_icao24.isEmpty();
+    }
+}
+
+FlightData::FlightData(const QString& icao24, const QString& callsign, const QString& country,
+                       double longitude, double latitude, double altitude,
+                       double velocity, double heading, double verticalRate,
+                       bool onGround, const QString& squawk)
+    : m_icao24(icao24)
+    , m_callsign(callsign)
+    , m_country(country)
+    , m_longitude(longitude)
+    , m_latitude(latitude)
+    , m_altitude(altitude)
+    , m_velocity(velocity)
+    , m_heading(heading)
+    , m_verticalRate(verticalRate)
+    , m_onGround(onGround)
+    , m_squawk(squawk)
+{
+    m_valid = (m_longitude != 0.0 || m_latitude != 0.0) && !m_icao24.isEmpty();
+}
+
+bool FlightData::isValid() const
+{
+    return m_valid;
+}
+
+bool FlightData::operator==(const FlightData& other) const
+{
+    // NaN fields compare equal to NaN so unchanged aircraft with missing data aren't reported as changed
+    auto same = [](double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+
+    return m_icao24 == other.m_icao24 && m_callsign == other.m_callsign && m_country == other.m_country
+        && same(m_longitude, other.m_longitude) && same(m_latitude, other.m_latitude)
+        && same(m_altitude, other.m_altitude) && same(m_velocity, other.m_velocity)
+        && same(m_heading, other.m_heading) && same(m_verticalRate, other.m_verticalRate)
+        && m_onGround == other.m_onGround && m_squawk == other.m_squawk && m_valid == other.m_valid;
+}
\ No newline at end of file
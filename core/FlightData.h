@@ -10,8 +10,15 @@ class FlightData
 public:
     FlightData() = default;
     explicit FlightData(const QJsonArray& data);
+    FlightData(const QString& icao24, const QString& callsign, const QString& country,
+               double longitude, double latitude, double altitude,
+               double velocity, double heading, double verticalRate,
+               bool onGround, const QString& squawk);
 
     bool isValid() const;
+
+    bool operator==(const FlightData& other) const;
+    bool operator!=(const FlightData& other) const { return !(*this == other); }
     
     QString icao24() const { return m_icao24; }
     QString callsign() const { return m_callsign; }
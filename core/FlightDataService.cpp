@@ -0,0 +1,387 @@
+#include "FlightDataService.h"
+#include "FlightShards.h"
+#include "TraceRecorder.h"
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+FlightDataService::FlightDataService(QObject *parent)
+    : FlightDataSource(parent)
+    , m_networkManager(new QNetworkAccessManager(this))
+    , m_apiUrl(defaultApiUrl())
+    , m_area(FlightShards::world())
+{
+    m_clock.start();
+}
+
+QUrl FlightDataService::defaultApiUrl()
+{
+    return QUrl("https://opensky-network.org/api");
+}
+
+QUrl FlightDataService::endpoint(const QString& path) const
+{
+    QUrl url = m_apiUrl;
+    QString basePath = url.path();
+    if (basePath.endsWith('/')) {
+        basePath.chop(1);
+    }
+    url.setPath(basePath + path);
+    return url;
+}
+
+void FlightDataService::setAccessToken(const QString& token)
+{
+    m_accessToken = token;
+    if (m_awaitingToken && !token.isEmpty()) {
+        replayHeldRequests();
+    }
+}
+
+void FlightDataService::fetchFlightData()
+{
+    if (m_accessToken.isEmpty()) {
+        emit dataFetchFailed("No access token available");
+        return;
+    }
+
+    // The current token was rejected; the refresh replays this once it arrives
+    if (m_awaitingToken) {
+        m_heldStatesFetch = true;
+        return;
+    }
+
+    sendStatesRequests(false);
+}
+
+void FlightDataService::sendStatesRequests(bool replayed)
+{
+    const QList<QRectF> boxes = FlightShards::split(m_area, m_shardCount);
+    if (boxes.size() > 1) {
+        qDebug() << "Fetching flight data in" << boxes.size() << "shards...";
+    } else {
+        qDebug() << "Fetching flight data...";
+    }
+
+    // A new refresh supersedes whatever is still outstanding from the previous one
+    abortStatesRequests();
+    m_fetch = ShardedFetch();
+    m_fetch.id = ++m_nextFetchId;
+    m_fetch.results.resize(boxes.size());
+    m_fetch.priority.fill(false, boxes.size());
+    m_fetch.pending = int(boxes.size());
+    m_fetch.startedNs = m_clock.nsecsElapsed();
+
+    // Shards over the priority area are requested first so they tend to arrive first
+    QList<int> order(boxes.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (boxes.size() > 1 && !m_priorityArea.isEmpty()) {
+        for (int i = 0; i < boxes.size(); ++i) {
+            m_fetch.priority[i] = boxes[i].intersects(m_priorityArea);
+        }
+        std::stable_partition(order.begin(), order.end(), [this](int i) { return m_fetch.priority[i]; });
+
+        // Sending ahead only helps when part of the snapshot is left to wait for
+        const int priorityCount = int(m_fetch.priority.count(true));
+        m_fetch.priorityPending = priorityCount < boxes.size() ? priorityCount : 0;
+    }
+
+    for (int shard : std::as_const(order)) {
+        QUrl url = endpoint("/states/all");
+        const QRectF& box = boxes[shard];
+        if (box != FlightShards::world()) {
+            QUrlQuery query;
+            query.addQueryItem("lamin", QString::number(box.top()));
+            query.addQueryItem("lomin", QString::number(box.left()));
+            query.addQueryItem("lamax", QString::number(box.bottom()));
+            query.addQueryItem("lomax", QString::number(box.right()));
+            url.setQuery(query);
+        }
+
+        QNetworkReply *reply = sendAuthorized(QNetworkRequest(url), replayed);
+        m_fetch.replies.append(reply);
+        reply->setProperty("fetchId", m_fetch.id);
+        reply->setProperty("shard", shard);
+        traceRequest(reply, "fetch states",
+                     boxes.size() > 1 ? QString("shard %1/%2").arg(shard + 1).arg(boxes.size()) : QString());
+        connect(reply, &QNetworkReply::finished, this, &FlightDataService::onFlightDataReply);
+    }
+}
+
+void FlightDataService::abortStatesRequests()
+{
+    const QList<QNetworkReply*> replies = std::exchange(m_fetch.replies, {});
+    if (!replies.isEmpty()) {
+        qDebug() << "Cancelling" << replies.size() << "outstanding flight data requests";
+    }
+
+    for (QNetworkReply *reply : replies) {
+        // abort() finishes the reply synchronously, so it is disconnected first
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        traceReply(reply, "fetch states");
+        reply->deleteLater();
+    }
+}
+
+void FlightDataService::fetchFlightTrack(const QString& icao24)
+{
+    if (m_accessToken.isEmpty() || icao24.isEmpty()) {
+        emit dataFetchFailed("Missing access token or ICAO24");
+        return;
+    }
+
+    // Clicking through aircraft abandons the earlier selections; their replies are never read
+    cancelTracksExcept(icao24);
+
+    if (m_trackReplies.contains(icao24)) {
+        qDebug() << "Track for" << icao24 << "already requested";
+        return;
+    }
+
+    if (m_awaitingToken) {
+        m_heldTrack = icao24;
+        return;
+    }
+
+    sendTrackRequest(icao24, false);
+}
+
+void FlightDataService::cancelTracksExcept(const QString& icao24)
+{
+    if (m_heldTrack != icao24) {
+        m_heldTrack.clear();
+    }
+
+    for (auto it = m_trackReplies.begin(); it != m_trackReplies.end();) {
+        if (it.key() == icao24) {
+            ++it;
+            continue;
+        }
+
+        qDebug() << "Cancelling track request for" << it.key();
+        QNetworkReply *reply = it.value();
+        it = m_trackReplies.erase(it);
+
+        // abort() finishes the reply synchronously, so it is disconnected first
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        traceReply(reply, "fetch track");
+        reply->deleteLater();
+    }
+}
+
+void FlightDataService::sendTrackRequest(const QString& icao24, bool replayed)
+{
+    qDebug() << "Fetching track for aircraft:" << icao24;
+
+    qint64 timestamp = m_lastUpdateTime.toSecsSinceEpoch();
+    QUrl trackUrl = endpoint("/tracks/all");
+    QUrlQuery query;
+    query.addQueryItem("icao24", icao24.toLower());
+    query.addQueryItem("time", QString::number(timestamp));
+    trackUrl.setQuery(query);
+
+    QNetworkRequest request(trackUrl);
+    request.setRawHeader("X-ICAO24", icao24.toUtf8()); // Store ICAO24 for the reply
+
+    QNetworkReply *reply = sendAuthorized(request, replayed);
+    m_trackReplies.insert(icao24, reply);
+    traceRequest(reply, "fetch track", icao24);
+    connect(reply, &QNetworkReply::finished, this, &FlightDataService::onTrackDataReply);
+}
+
+void FlightDataService::onFlightDataReply()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) {
+        return;
+    }
+
+    reply->deleteLater();
+    traceReply(reply, "fetch states");
+    m_fetch.replies.removeOne(reply);
+
+    // Shards of a superseded refresh, or of one that has already failed
+    const quint64 fetchId = reply->property("fetchId").toULongLong();
+    if (fetchId != m_fetch.id || m_fetch.failed) {
+        return;
+    }
+
+    if (isRetryableRejection(reply)) {
+        // The whole snapshot is fetched again with the new token, so the other shards are dropped
+        m_fetch.failed = true;
+        m_heldStatesFetch = true;
+        abortStatesRequests();
+        awaitToken(reply->property("accessToken").toString());
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        // A snapshot with a shard missing would read as aircraft disappearing, so drop it whole
+        m_fetch.failed = true;
+        abortStatesRequests();
+        emit dataFetchFailed(QString("Flight data request failed: %1").arg(reply->errorString()));
+        return;
+    }
+
+    m_lastUpdateTime = QDateTime::currentDateTime();
+    m_fetch.lastReplyNs = m_clock.nsecsElapsed();
+
+    // Each shard decodes on the thread pool while the others are still downloading
+    const int shard = reply->property("shard").toInt();
+    auto *watcher = new QFutureWatcher<QList<FlightData>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, fetchId, shard]() {
+        watcher->deleteLater();
+        onShardDecoded(fetchId, shard, watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run(&FlightDataSource::decodeStates, reply->readAll()));
+}
+
+void FlightDataService::onShardDecoded(quint64 fetchId, int shard, const QList<FlightData>& flights)
+{
+    if (fetchId != m_fetch.id || m_fetch.failed) {
+        return;
+    }
+
+    m_fetch.results[shard] = flights;
+    --m_fetch.pending;
+
+    if (m_fetch.pending == 0) {
+        QList<FlightData> merged = FlightShards::merge(m_fetch.results);
+        m_fetch.results.clear();
+
+        // Fetch runs until the last reply; decode is the part not hidden behind other downloads
+        m_lastFetchTiming.fetchMs = (m_fetch.lastReplyNs - m_fetch.startedNs) / 1e6;
+        m_lastFetchTiming.decodeMs = (m_clock.nsecsElapsed() - m_fetch.lastReplyNs) / 1e6;
+
+        emit flightDataReceived(merged);
+        return;
+    }
+
+    if (m_fetch.priority[shard] && m_fetch.priorityPending > 0 && --m_fetch.priorityPending == 0) {
+        QList<QList<FlightData>> visible;
+        for (int i = 0; i < m_fetch.results.size(); ++i) {
+            if (m_fetch.priority[i]) {
+                visible.append(m_fetch.results[i]);
+            }
+        }
+        emit partialFlightDataReceived(FlightShards::merge(visible));
+    }
+}
+
+void FlightDataService::onTrackDataReply()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) {
+        return;
+    }
+
+    QString icao24 = reply->request().rawHeader("X-ICAO24");
+    reply->deleteLater();
+    traceReply(reply, "fetch track");
+
+    // Only the outstanding request for an aircraft is read
+    if (m_trackReplies.value(icao24) != reply) {
+        return;
+    }
+    m_trackReplies.remove(icao24);
+
+    if (isRetryableRejection(reply)) {
+        m_heldTrack = icao24;
+        awaitToken(reply->property("accessToken").toString());
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        emit dataFetchFailed(QString("Track data request failed: %1").arg(reply->errorString()));
+        return;
+    }
+
+    QByteArray data = reply->readAll();
+    TraceScope trace("parse track", "track", icao24);
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    QJsonObject trackObj = doc.object();
+
+    emit trackDataReceived(icao24, trackObj);
+}
+
+QNetworkReply* FlightDataService::sendAuthorized(QNetworkRequest request, bool replayed)
+{
+    request.setRawHeader("Authorization", QString("Bearer %1").arg(m_accessToken).toUtf8());
+
+    QNetworkReply *reply = m_networkManager->get(request);
+    // The token it carried tells a rejection of the current token from one already replaced
+    reply->setProperty("accessToken", m_accessToken);
+    reply->setProperty("replayed", replayed);
+    return reply;
+}
+
+bool FlightDataService::isRetryableRejection(QNetworkReply* reply) const
+{
+    // A replayed request that is rejected again fails like any other error
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 401
+        && !reply->property("replayed").toBool();
+}
+
+void FlightDataService::awaitToken(const QString& rejectedToken)
+{
+    // A background refresh already replaced the token this request carried
+    if (!m_awaitingToken && rejectedToken != m_accessToken) {
+        replayHeldRequests();
+        return;
+    }
+
+    // Every 401 until the new token arrives shares one refresh
+    if (!m_awaitingToken) {
+        m_awaitingToken = true;
+        qDebug() << "Access token rejected, holding requests until it is refreshed";
+        emit accessTokenRejected();
+    }
+}
+
+void FlightDataService::replayHeldRequests()
+{
+    m_awaitingToken = false;
+
+    if (std::exchange(m_heldStatesFetch, false)) {
+        sendStatesRequests(true);
+    }
+
+    const QString track = std::exchange(m_heldTrack, QString());
+    if (!track.isEmpty()) {
+        sendTrackRequest(track, true);
+    }
+}
+
+void FlightDataService::traceRequest(QNetworkReply* reply, const char* name, const QString& detail)
+{
+    if (!TraceRecorder::isEnabled()) {
+        return;
+    }
+
+    const quint64 traceId = TraceRecorder::nextId();
+    reply->setProperty("traceId", traceId);
+    TraceRecorder::instance().asyncBegin(name, "network", traceId, detail);
+}
+
+void FlightDataService::traceReply(QNetworkReply* reply, const char* name)
+{
+    // Requests sent before tracing started have no id
+    if (!TraceRecorder::isEnabled() || !reply->property("traceId").isValid()) {
+        return;
+    }
+
+    const QString status = reply->error() == QNetworkReply::NoError
+        ? QString::number(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())
+        : reply->errorString();
+    TraceRecorder::instance().asyncEnd(name, "network", reply->property("traceId").toULongLong(), status);
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef FLIGHTDATASERVICE_H
+#define FLIGHTDATASERVICE_H
+
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QUrl>
+#include <QHash>
+#include <QRectF>
+#include "FlightDataSource.h"
+
+// Fetches flight data over HTTP from OpenSky, or from any server that serves its API.
+// A snapshot can be split into bounding-box shards that download and decode in parallel
+// and are merged back into one list before flightDataReceived.
+// Requests rejected with 401 are held, accessTokenRejected asks for a new token, and they
+// are sent again once setAccessToken delivers it.
+class FlightDataService : public FlightDataSource
+{
+    Q_OBJECT
+
+public:
+    explicit FlightDataService(QObject *parent = nullptr);
+
+    static QUrl defaultApiUrl();
+
+    // Base of the REST API, e.g. https://opensky-network.org/api
+    void setApiUrl(const QUrl& url) { m_apiUrl = url; }
+    QUrl apiUrl() const { return m_apiUrl; }
+
+    // Number of bounding boxes /states/all is split into; 1 fetches the area in one request
+    void setShardCount(int count) { m_shardCount = qMax(1, count); }
+    int shardCount() const { return m_shardCount; }
+
+    // Area to fetch, longitude on x and latitude on y; the whole world by default
+    void setArea(const QRectF& area) { m_area = area; }
+    QRectF area() const { return m_area; }
+
+    void setAccessToken(const QString& token) override;
+    void setPriorityArea(const QRectF& area) override { m_priorityArea = area; }
+    void fetchFlightData() override;
+    void fetchFlightTrack(const QString& icao24) override;
+    void cancelFlightTracks() override { cancelTracksExcept(QString()); }
+
+private slots:
+    void onFlightDataReply();
+    void onTrackDataReply();
+
+private:
+    // The shards of one /states/all refresh
+    struct ShardedFetch
+    {
+        quint64 id = 0;
+        QList<QList<FlightData>> results;
+        QList<bool> priority;
+        QList<QNetworkReply*> replies;  // still downloading
+        int pending = 0;
+        int priorityPending = 0;    // 0 once the priority shards have been sent ahead
+        qint64 startedNs = 0;
+        qint64 lastReplyNs = 0;
+        bool failed = false;
+    };
+
+    void sendStatesRequests(bool replayed);
+    void abortStatesRequests();
+    void sendTrackRequest(const QString& icao24, bool replayed);
+    void cancelTracksExcept(const QString& icao24);
+    QNetworkReply* sendAuthorized(QNetworkRequest request, bool replayed);
+    bool isRetryableRejection(QNetworkReply* reply) const;
+    void awaitToken(const QString& rejectedToken);
+    void replayHeldRequests();
+    void onShardDecoded(quint64 fetchId, int shard, const QList<FlightData>& flights);
+    QUrl endpoint(const QString& path) const;
+    void traceRequest(QNetworkReply* reply, const char* name, const QString& detail = QString());
+    void traceReply(QNetworkReply* reply, const char* name);
+
+    QNetworkAccessManager* m_networkManager;
+    QUrl m_apiUrl;
+    QString m_accessToken;
+    bool m_awaitingToken = false;
+    bool m_heldStatesFetch = false;
+    QString m_heldTrack;
+    QHash<QString, QNetworkReply*> m_trackReplies;  // icao24 -> outstanding request
+    int m_shardCount = 1;
+    QRectF m_area;
+    QRectF m_priorityArea;
+    ShardedFetch m_fetch;
+    quint64 m_nextFetchId = 0;
+    QDateTime m_lastUpdateTime;
+    QElapsedTimer m_clock;
+};
+
+#endif // FLIGHTDATASERVICE_H
\ No newline at end of file
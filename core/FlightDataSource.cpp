@@ -0,0 +1,37 @@
+#include "FlightDataSource.h"
+#include "TraceRecorder.h"
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDebug>
+
+FlightDataSource::FlightDataSource(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QList<FlightData> FlightDataSource::decodeStates(const QByteArray& json)
+{
+    TraceScope trace("decode", "pipeline");
+
+    QJsonDocument doc = QJsonDocument::fromJson(json);
+    QJsonObject obj = doc.object();
+
+    QList<FlightData> flights;
+
+    if (obj.contains("states")) {
+        QJsonArray states = obj["states"].toArray();
+        qDebug() << "Processing" << states.size() << "flights";
+
+        flights.reserve(states.size());
+        for (const QJsonValue& value : states) {
+            QJsonArray flightArray = value.toArray();
+            FlightData flight(flightArray);
+
+            if (flight.isValid()) {
+                flights.append(flight);
+            }
+        }
+    }
+
+    return flights;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef FLIGHTDATASOURCE_H
+#define FLIGHTDATASOURCE_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QRectF>
+#include "FlightData.h"
+
+// Where FlightTracker gets /states/all and /tracks/all data from.
+// FlightDataService talks to OpenSky or any server speaking its API (such as the bundled
+// stand-in server); FileFlightDataSource reads fixture files without any network.
+class FlightDataSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FlightDataSource(QObject *parent = nullptr);
+
+    virtual bool requiresAuthentication() const { return true; }
+    virtual void setAccessToken(const QString& token) { Q_UNUSED(token) }
+    // Area the user is looking at (longitude on x, latitude on y); sources that fetch in parts
+    // fetch it first and send it ahead as partialFlightDataReceived
+    virtual void setPriorityArea(const QRectF& area) { Q_UNUSED(area) }
+    virtual void fetchFlightData() = 0;
+    // A track request supersedes any still outstanding for other aircraft
+    virtual void fetchFlightTrack(const QString& icao24) = 0;
+    // Drops outstanding track requests, e.g. when the selection is cleared
+    virtual void cancelFlightTracks() {}
+
+    // Decodes a /states/all response body into the valid flights it contains
+    static QList<FlightData> decodeStates(const QByteArray& json);
+
+    // Durations behind the most recent flightDataReceived, in ms
+    struct FetchTiming
+    {
+        double fetchMs = 0.0;
+        double decodeMs = 0.0;
+    };
+    FetchTiming lastFetchTiming() const { return m_lastFetchTiming; }
+
+signals:
+    void flightDataReceived(const QList<FlightData>& flights);
+    // Flights over the priority area only, while the rest of the snapshot is still on its way
+    void partialFlightDataReceived(const QList<FlightData>& flights);
+    void trackDataReceived(const QString& icao24, const QJsonObject& trackData);
+    void dataFetchFailed(const QString& error);
+    // The API refused the access token; the source waits for setAccessToken with a new one
+    void accessTokenRejected();
+
+protected:
+    FetchTiming m_lastFetchTiming;
+};
+
+#endif // FLIGHTDATASOURCE_H
\ No newline at end of file
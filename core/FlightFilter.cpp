@@ -0,0 +1,103 @@
+#include "FlightFilter.h"
+
+void FlightFilter::setCountries(const QStringList& selected, qsizetype availableCount)
+{
+    m_countries = QSet<QString>(selected.cbegin(), selected.cend());
+    m_hideAll = selected.isEmpty();
+    m_filterCountries = !m_hideAll && selected.size() != availableCount;
+    m_useCountryIds = false;
+}
+
+void FlightFilter::setCountrySelection(const QHash<QString, int>& ids, const QBitArray& selected)
+{
+    const qsizetype selectedCount = selected.count(true);
+    m_countryIds = ids;
+    m_countrySelection = selected;
+    m_hideAll = selectedCount == 0;
+    m_filterCountries = !m_hideAll && selectedCount != selected.size();
+    m_useCountryIds = true;
+}
+
+void FlightFilter::setStatus(const QString& status)
+{
+    if (status == "Airborne") {
+        m_status = Status::Airborne;
+    } else if (status == "OnGround") {
+        m_status = Status::OnGround;
+    } else {
+        m_status = Status::All;
+    }
+}
+
+void FlightFilter::setAltitudeRange(double minFeet, double maxFeet)
+{
+    m_minAltitudeFeet = minFeet;
+    m_maxAltitudeFeet = maxFeet;
+}
+
+void FlightFilter::setSpeedRange(double minKnots, double maxKnots)
+{
+    m_minSpeedKnots = minKnots;
+    m_maxSpeedKnots = maxKnots;
+}
+
+void FlightFilter::setVerticalStatus(const QString& status)
+{
+    if (status == "Climbing") {
+        m_vertical = Vertical::Climbing;
+    } else if (status == "Descending") {
+        m_vertical = Vertical::Descending;
+    } else if (status == "Level") {
+        m_vertical = Vertical::Level;
+    } else {
+        m_vertical = Vertical::All;
+    }
+}
+
+bool FlightFilter::matches(const FlightData& flight) const
+{
+    if (m_hideAll) {
+        return false;
+    }
+
+    // Flights without a country are never hidden by the country filter
+    if (m_filterCountries) {
+        const QString country = flight.country().trimmed();
+        if (!country.isEmpty()) {
+            bool selected = false;
+            if (m_useCountryIds) {
+                const int id = m_countryIds.value(country, -1);
+                selected = id >= 0 && m_countrySelection.testBit(id);
+            } else {
+                selected = m_countries.contains(country);
+            }
+            if (!selected) {
+                return false;
+            }
+        }
+    }
+
+    if (m_status == Status::Airborne && flight.onGround()) return false;
+    if (m_status == Status::OnGround && !flight.onGround()) return false;
+
+    // Only filter if altitude is valid
+    const double altitudeFeet = flight.altitude() * 3.28084;
+    if (altitudeFeet >= 0 && (altitudeFeet < m_minAltitudeFeet || altitudeFeet > m_maxAltitudeFeet)) {
+        return false;
+    }
+
+    // Only filter if speed is valid
+    const double speedKnots = flight.velocity() * 1.94384;
+    if (speedKnots >= 0 && (speedKnots < m_minSpeedKnots || speedKnots > m_maxSpeedKnots)) {
+        return false;
+    }
+
+    const double verticalRate = flight.verticalRate();
+    switch (m_vertical) {
+    case Vertical::Climbing: return verticalRate > 0.5;
+    case Vertical::Descending: return verticalRate < -0.5;
+    case Vertical::Level: return verticalRate >= -0.5 && verticalRate <= 0.5;
+    case Vertical::All: break;
+    }
+    return true;
+}
\ No newline at end of file
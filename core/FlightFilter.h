@@ -0,0 +1,45 @@
+#ifndef FLIGHTFILTER_H
+#define FLIGHTFILTER_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include "FlightData.h"
+
+// The filter panel's criteria, evaluated per flight
+class FlightFilter
+{
+public:
+    // Nothing selected hides every flight; selecting every available country disables the country check
+    void setCountries(const QStringList& selected, qsizetype availableCount);
+    // Selection as kept by CountryTreeModel: ids maps country names to bits of selected, and names
+    // missing from ids are hidden. Both are implicitly shared, so nothing is copied.
+    void setCountrySelection(const QHash<QString, int>& ids, const QBitArray& selected);
+    void setStatus(const QString& status);                  // "All", "Airborne" or "OnGround"
+    void setAltitudeRange(double minFeet, double maxFeet);
+    void setSpeedRange(double minKnots, double maxKnots);
+    void setVerticalStatus(const QString& status);          // "All", "Climbing", "Descending" or "Level"
+
+    bool matches(const FlightData& flight) const;
+
+private:
+    enum class Status { All, Airborne, OnGround };
+    enum class Vertical { All, Climbing, Descending, Level };
+
+    QSet<QString> m_countries;
+    QHash<QString, int> m_countryIds;
+    QBitArray m_countrySelection;
+    bool m_useCountryIds = false;
+    bool m_hideAll = false;
+    bool m_filterCountries = false;
+    Status m_status = Status::All;
+    double m_minAltitudeFeet = 0.0;
+    double m_maxAltitudeFeet = 40000.0;
+    double m_minSpeedKnots = 0.0;
+    double m_maxSpeedKnots = 600.0;
+    Vertical m_vertical = Vertical::All;
+};
+
+#endif // FLIGHTFILTER_H
\ No newline at end of file
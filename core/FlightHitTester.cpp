@@ -0,0 +1,30 @@
+#include "FlightHitTester.h"
+#include "WebMercator.h"
+
+void FlightHitTester::setFlights(const QList<FlightData>& flights)
+{
+    m_projected.resize(flights.size());
+    for (qsizetype i = 0; i < flights.size(); ++i) {
+        m_projected[i] = WebMercator::project(flights[i].longitude(), flights[i].latitude());
+    }
+}
+
+int FlightHitTester::hitTest(double longitude, double latitude, double toleranceMeters, const QList<bool>& visible) const
+{
+    const QPointF target = WebMercator::project(longitude, latitude);
+    const double toleranceSquared = toleranceMeters * toleranceMeters;
+    const qsizetype count = qMin(m_projected.size(), visible.size());
+
+    for (qsizetype i = 0; i < count; ++i) {
+        if (!visible[i]) {
+            continue;
+        }
+
+        const double dx = m_projected[i].x() - target.x();
+        const double dy = m_projected[i].y() - target.y();
+        if (dx * dx + dy * dy <= toleranceSquared) {
+            return int(i);
+        }
+    }
+    return -1;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef FLIGHTHITTESTER_H
+#define FLIGHTHITTESTER_H
+
+#include <QList>
+#include <QPointF>
+#include "FlightData.h"
+
+// Finds the flight under a map click. Positions are projected to Web Mercator once per snapshot,
+// so a click costs one screen-to-map conversion instead of one map-to-screen per flight.
+class FlightHitTester
+{
+public:
+    void setFlights(const QList<FlightData>& flights);
+    void clear() { m_projected.clear(); }
+
+    // Index of the first flight whose visible flag is set within toleranceMeters of the location,
+    // or -1. Flights past the end of visible are not hit.
+    int hitTest(double longitude, double latitude, double toleranceMeters, const QList<bool>& visible) const;
+
+private:
+    QList<QPointF> m_projected;
+};
+
+#endif // FLIGHTHITTESTER_H
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include "FlightListModel.h"
+#include "FlightStore.h"
+#include <algorithm>
+
+namespace {
+template <typename T>
+int compareValues(const T& a, const T& b)
+{
+    return (b < a) - (a < b);
+}
+}
+
+FlightListModel::FlightListModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int FlightListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : int(m_rows.size());
+}
+
+QVariant FlightListModel::data(const QModelIndex& index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return QVariant();
+    }
+
+    const int id = m_rows[index.row()];
+    const FlightData& flight = m_entries[id].flight;
+    switch (role) {
+    case Qt::DisplayRole:
+    case CallsignRole: return flight.callsign().trimmed();
+    case Icao24Role: return flight.icao24();
+    case CountryRole: return flight.country();
+    case AltitudeRole: return flight.altitude() * 3.28084;
+    case SpeedRole: return flight.velocity() * 1.94384;
+    case HeadingRole: return flight.heading();
+    case VerticalRateRole: return flight.verticalRate() * 196.85;
+    case OnGroundRole: return flight.onGround();
+    case SquawkRole: return flight.squawk();
+    case FlightIdRole: return id;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> FlightListModel::roleNames() const
+{
+    return {
+        {Icao24Role, "icao24"},
+        {CallsignRole, "callsign"},
+        {CountryRole, "country"},
+        {AltitudeRole, "altitude"},
+        {SpeedRole, "speed"},
+        {HeadingRole, "heading"},
+        {VerticalRateRole, "verticalRate"},
+        {OnGroundRole, "onGround"},
+        {SquawkRole, "squawk"},
+        {FlightIdRole, "flightId"}
+    };
+}
+
+void FlightListModel::sort(int column, Qt::SortOrder order)
+{
+    if (column < Callsign || column > Squawk) {
+        return;
+    }
+    if (column == m_sortColumn && order == m_sortOrder) {
+        return;
+    }
+    m_sortColumn = Column(column);
+    m_sortOrder = order;
+    sortRows();
+    emit sortChanged();
+}
+
+int FlightListModel::rowOf(const QString& icao24) const
+{
+    const int id = m_ids.value(icao24, -1);
+    return id >= 0 ? m_rowOfId[id] : -1;
+}
+
+QString FlightListModel::icao24At(int row) const
+{
+    return row >= 0 && row < m_rows.size() ? m_entries[m_rows[row]].flight.icao24() : QString();
+}
+
+bool FlightListModel::lessThan(int id, int otherId) const
+{
+    const FlightData& a = m_entries[id].flight;
+    const FlightData& b = m_entries[otherId].flight;
+
+    int order = 0;
+    switch (m_sortColumn) {
+    case Callsign: order = a.callsign().compare(b.callsign(), Qt::CaseInsensitive); break;
+    case Icao24: break;
+    case Country: order = a.country().compare(b.country()); break;
+    case Altitude: order = compareValues(a.altitude(), b.altitude()); break;
+    case Speed: order = compareValues(a.velocity(), b.velocity()); break;
+    case Heading: order = compareValues(a.heading(), b.heading()); break;
+    case VerticalRate: order = compareValues(a.verticalRate(), b.verticalRate()); break;
+    case Squawk: order = a.squawk().compare(b.squawk()); break;
+    }
+
+    // icao24 breaks ties in either direction, so the order is total and rows never swap places
+    // between refreshes without a reason
+    if (order == 0) {
+        order = a.icao24().compare(b.icao24());
+        return m_sortColumn == Icao24 && m_sortOrder == Qt::DescendingOrder ? order > 0 : order < 0;
+    }
+    return m_sortOrder == Qt::AscendingOrder ? order < 0 : order > 0;
+}
+
+bool FlightListModel::isInOrder(int row) const
+{
+    const int id = m_rows[row];
+    if (row > 0 && lessThan(id, m_rows[row - 1])) {
+        return false;
+    }
+    return row + 1 >= m_rows.size() || !lessThan(m_rows[row + 1], id);
+}
+
+int FlightListModel::allocate(const FlightData& flight)
+{
+    int id;
+    if (!m_freeIds.isEmpty()) {
+        id = m_freeIds.takeLast();
+        m_entries[id].flight = flight;
+    } else {
+        id = int(m_entries.size());
+        m_entries.append(Entry{flight, 0});
+        m_rowOfId.append(-1);
+    }
+    m_entries[id].generation = m_generation;
+    m_ids.insert(flight.icao24(), id);
+    return id;
+}
+
+void FlightListModel::update(const FlightStore& store)
+{
+    const QList<FlightData>& flights = store.flights();
+    const QList<bool>& visibility = store.visibility();
+    const int countBefore = count();
+    ++m_generation;
+
+    // Mark the listed aircraft, note which changed and give new ones an id
+    QList<int> changed;
+    QList<int> added;
+    for (qsizetype i = 0; i < flights.size(); ++i) {
+        if (i >= visibility.size() || !visibility[i]) {
+            continue;
+        }
+        const FlightData& flight = flights[i];
+        const auto it = m_ids.constFind(flight.icao24());
+        if (it == m_ids.cend()) {
+            added.append(allocate(flight));
+            continue;
+        }
+
+        Entry& entry = m_entries[*it];
+        if (entry.generation == m_generation) {
+            continue;
+        }
+        entry.generation = m_generation;
+        if (entry.flight != flight) {
+            entry.flight = flight;
+            if (m_rowOfId[*it] >= 0) {
+                changed.append(*it);
+            }
+        }
+    }
+
+    removeStaleRows();
+    emitChangedRows(changed);
+
+    // Only changed rows can be out of place; the rest were in order after the last refresh
+    QList<int> misplaced;
+    for (int id : std::as_const(changed)) {
+        if (!isInOrder(m_rowOfId[id])) {
+            misplaced.append(id);
+        }
+    }
+
+    if (misplaced.size() + added.size() > MaxIncrementalRows) {
+        if (!added.isEmpty()) {
+            const int first = count();
+            beginInsertRows(QModelIndex(), first, first + int(added.size()) - 1);
+            m_rows.append(added);
+            reindexRows(first);
+            endInsertRows();
+        }
+        sortRows();
+    } else {
+        for (int id : std::as_const(misplaced)) {
+            moveToSortedRow(id);
+        }
+        // A row moved past another misplaced one can land out of order
+        if (!misplaced.isEmpty() && !std::is_sorted(m_rows.cbegin(), m_rows.cend(),
+                                                    [this](int a, int b) { return lessThan(a, b); })) {
+            sortRows();
+        }
+        for (int id : std::as_const(added)) {
+            insertSorted(id);
+        }
+    }
+
+    if (count() != countBefore) {
+        emit countChanged();
+    }
+}
+
+void FlightListModel::clear()
+{
+    beginResetModel();
+    m_entries.clear();
+    m_freeIds.clear();
+    m_ids.clear();
+    m_rows.clear();
+    m_rowOfId.clear();
+    endResetModel();
+    emit countChanged();
+}
+
+void FlightListModel::removeStaleRows()
+{
+    // Runs from the bottom up, so the rows above a run keep their numbers
+    int lowest = -1;
+    for (int last = int(m_rows.size()) - 1; last >= 0; --last) {
+        if (m_entries[m_rows[last]].generation == m_generation) {
+            continue;
+        }
+        int first = last;
+        while (first > 0 && m_entries[m_rows[first - 1]].generation != m_generation) {
+            --first;
+        }
+
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = first; row <= last; ++row) {
+            const int id = m_rows[row];
+            m_ids.remove(m_entries[id].flight.icao24());
+            m_entries[id].flight = FlightData();
+            m_rowOfId[id] = -1;
+            m_freeIds.append(id);
+        }
+        m_rows.remove(first, last - first + 1);
+        endRemoveRows();
+
+        lowest = first;
+        last = first;
+    }
+
+    if (lowest >= 0) {
+        reindexRows(lowest);
+    }
+}
+
+void FlightListModel::emitChangedRows(const QList<int>& ids)
+{
+    QList<int> rows;
+    rows.reserve(ids.size());
+    for (int id : ids) {
+        rows.append(m_rowOfId[id]);
+    }
+    std::sort(rows.begin(), rows.end());
+
+    // One signal per contiguous range rather than one per aircraft
+    for (qsizetype i = 0; i < rows.size();) {
+        qsizetype j = i + 1;
+        while (j < rows.size() && rows[j] == rows[j - 1] + 1) {
+            ++j;
+        }
+        emit dataChanged(index(rows[i]), index(rows[j - 1]));
+        i = j;
+    }
+}
+
+void FlightListModel::moveToSortedRow(int id)
+{
+    const int from = m_rowOfId[id];
+    if (isInOrder(from)) {
+        return;
+    }
+
+    auto less = [this](int a, int b) { return lessThan(a, b); };
+    if (from > 0 && lessThan(id, m_rows[from - 1])) {
+        const int to = int(std::upper_bound(m_rows.cbegin(), m_rows.cbegin() + from, id, less) - m_rows.cbegin());
+        beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+        m_rows.move(from, to);
+        reindexRows(to, from);
+    } else {
+        // Qt counts the destination before the move, so it is one past the row the aircraft ends up in
+        const int to = int(std::lower_bound(m_rows.cbegin() + from + 1, m_rows.cend(), id, less) - m_rows.cbegin());
+        beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+        m_rows.move(from, to - 1);
+        reindexRows(from, to - 1);
+    }
+    endMoveRows();
+}
+
+void FlightListModel::insertSorted(int id)
+{
+    const int row = int(std::lower_bound(m_rows.cbegin(), m_rows.cend(), id,
+                                         [this](int a, int b) { return lessThan(a, b); }) - m_rows.cbegin());
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.insert(row, id);
+    reindexRows(row);
+    endInsertRows();
+}
+
+void FlightListModel::sortRows()
+{
+    if (m_rows.size() < 2) {
+        return;
+    }
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    // Persistent indexes (the view's current item, for one) follow their aircraft
+    const QModelIndexList before = persistentIndexList();
+    QList<int> ids;
+    ids.reserve(before.size());
+    for (const QModelIndex& index : before) {
+        ids.append(m_rows[index.row()]);
+    }
+
+    std::sort(m_rows.begin(), m_rows.end(), [this](int a, int b) { return lessThan(a, b); });
+    reindexRows(0);
+
+    QModelIndexList after;
+    after.reserve(before.size());
+    for (int id : std::as_const(ids)) {
+        after.append(index(m_rowOfId[id]));
+    }
+    changePersistentIndexList(before, after);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void FlightListModel::reindexRows(int first, int last)
+{
+    if (last < 0 || last >= m_rows.size()) {
+        last = int(m_rows.size()) - 1;
+    }
+    for (int row = first; row <= last; ++row) {
+        m_rowOfId[m_rows[row]] = row;
+    }
+}
\ No newline at end of file
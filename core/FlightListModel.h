@@ -0,0 +1,105 @@
+#ifndef FLIGHTLISTMODEL_H
+#define FLIGHTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include "FlightData.h"
+
+class FlightStore;
+
+// The visible flights as a sortable table for a ListView. Each aircraft keeps an id for as long
+// as it stays in the list, and rows map to ids, so a refresh removes, updates and inserts rows
+// in place instead of resetting the model. Rows stay sorted: a handful of moved or new rows are
+// moved or inserted one at a time, larger changes re-sort as one layout change.
+class FlightListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(Column sortColumn READ sortColumn WRITE setSortColumn NOTIFY sortChanged)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortChanged)
+
+public:
+    enum Column {
+        Callsign,
+        Icao24,
+        Country,
+        Altitude,
+        Speed,
+        Heading,
+        VerticalRate,
+        Squawk
+    };
+    Q_ENUM(Column)
+
+    // Altitude in feet, speed in knots and vertical rate in feet per minute, as the filters use
+    enum Roles {
+        Icao24Role = Qt::UserRole + 1,
+        CallsignRole,
+        CountryRole,
+        AltitudeRole,
+        SpeedRole,
+        HeadingRole,
+        VerticalRateRole,
+        OnGroundRole,
+        SquawkRole,
+        FlightIdRole
+    };
+
+    explicit FlightListModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Brings the rows in line with the store's visible flights
+    void update(const FlightStore& store);
+    void clear();
+
+    int count() const { return int(m_rows.size()); }
+    Column sortColumn() const { return m_sortColumn; }
+    void setSortColumn(Column column) { sort(column, m_sortOrder); }
+    Qt::SortOrder sortOrder() const { return m_sortOrder; }
+    void setSortOrder(Qt::SortOrder order) { sort(m_sortColumn, order); }
+
+    // Row of the aircraft, or -1 when it is not listed
+    Q_INVOKABLE int rowOf(const QString& icao24) const;
+    Q_INVOKABLE QString icao24At(int row) const;
+
+signals:
+    void countChanged();
+    void sortChanged();
+
+private:
+    struct Entry
+    {
+        FlightData flight;
+        quint32 generation = 0;
+    };
+
+    // Above this many rows to place, a refresh re-sorts instead of moving rows one by one
+    static constexpr int MaxIncrementalRows = 64;
+
+    bool lessThan(int id, int otherId) const;
+    bool isInOrder(int row) const;
+    int allocate(const FlightData& flight);
+    void removeStaleRows();
+    void emitChangedRows(const QList<int>& ids);
+    void moveToSortedRow(int id);
+    void insertSorted(int id);
+    void sortRows();
+    void reindexRows(int first, int last = -1);
+
+    QList<Entry> m_entries;     // by id
+    QList<int> m_freeIds;
+    QHash<QString, int> m_ids;
+    QList<int> m_rows;          // row -> id
+    QList<int> m_rowOfId;       // id -> row, -1 while unlisted
+    quint32 m_generation = 0;
+    Column m_sortColumn = Callsign;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+};
+
+#endif // FLIGHTLISTMODEL_H
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "FlightMotion.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double MetersPerDegree = 111320.0;
+
+double finiteOr(double value, double fallback)
+{
+    return std::isfinite(value) ? value : fallback;
+}
+
+// Difference between two angles in degrees, in [-180, 180)
+double angleDelta(double from, double to)
+{
+    return std::fmod(to - from + 540.0, 360.0) - 180.0;
+}
+}
+
+FlightMotion::FlightMotion(const Options& options)
+    : m_options(options)
+{
+}
+
+void FlightMotion::report(const FlightData& flight, qint64 nowMs)
+{
+    if (!flight.isValid() || (isValid() && flight == m_report)) {
+        return;
+    }
+
+    const bool first = !isValid() || flight.icao24() != m_report.icao24();
+    const State shown = first ? State() : at(nowMs);
+
+    m_report = flight;
+    m_reportMs = nowMs;
+    m_correction = State();
+
+    if (first) {
+        return;
+    }
+
+    const State reported = reckon(nowMs);
+    const double dLon = angleDelta(reported.longitude, shown.longitude);
+    const double dLat = shown.latitude - reported.latitude;
+    if (std::abs(dLon) > m_options.snapDistanceDegrees || std::abs(dLat) > m_options.snapDistanceDegrees) {
+        return;
+    }
+
+    m_correction.longitude = dLon;
+    m_correction.latitude = dLat;
+    m_correction.altitude = shown.altitude - reported.altitude;
+    m_correction.heading = angleDelta(reported.heading, shown.heading);
+    m_correction.pitch = shown.pitch - reported.pitch;
+}
+
+void FlightMotion::clear()
+{
+    m_report = FlightData();
+    m_reportMs = 0;
+    m_correction = State();
+}
+
+FlightMotion::State FlightMotion::reckon(qint64 nowMs) const
+{
+    State state;
+    state.longitude = m_report.longitude();
+    state.latitude = m_report.latitude();
+    state.altitude = finiteOr(m_report.altitude(), 0.0);
+    state.heading = finiteOr(m_report.heading(), 0.0);
+
+    if (m_report.onGround()) {
+        return state;
+    }
+
+    const double speed = finiteOr(m_report.velocity(), 0.0);
+    const double climb = finiteOr(m_report.verticalRate(), 0.0);
+    if (speed > 0.0) {
+        state.pitch = std::clamp(qRadiansToDegrees(std::atan2(climb, speed)), -15.0, 15.0);
+    }
+
+    const double seconds = std::clamp<qint64>(nowMs - m_reportMs, 0, m_options.maxExtrapolationMs) / 1000.0;
+    const double distance = speed * seconds;
+    const double heading = qDegreesToRadians(state.heading);
+    const double cosLat = std::max(std::cos(qDegreesToRadians(state.latitude)), 0.01);
+    state.latitude += distance * std::cos(heading) / MetersPerDegree;
+    state.longitude += distance * std::sin(heading) / (MetersPerDegree * cosLat);
+    state.altitude += climb * seconds;
+    return state;
+}
+
+FlightMotion::State FlightMotion::at(qint64 nowMs) const
+{
+    if (!isValid()) {
+        return State();
+    }
+
+    State state = reckon(nowMs);
+
+    // Smoothstep, so the correction starts and ends without a kink
+    const double t = m_options.blendMs > 0 ? std::clamp((nowMs - m_reportMs) / double(m_options.blendMs), 0.0, 1.0) : 1.0;
+    const double remaining = 1.0 - t * t * (3.0 - 2.0 * t);
+
+    state.longitude += m_correction.longitude * remaining;
+    state.latitude += m_correction.latitude * remaining;
+    state.altitude += m_correction.altitude * remaining;
+    state.heading = std::fmod(state.heading + m_correction.heading * remaining + 360.0, 360.0);
+    state.pitch += m_correction.pitch * remaining;
+    return state;
+}
+
+bool FlightMotion::isSettled(qint64 nowMs) const
+{
+    if (!isValid()) {
+        return true;
+    }
+
+    const qint64 elapsed = nowMs - m_reportMs;
+    const bool stationary = m_report.onGround() || finiteOr(m_report.velocity(), 0.0) <= 0.0;
+    return elapsed >= m_options.blendMs && (stationary || elapsed >= m_options.maxExtrapolationMs);
+}
\ No newline at end of file
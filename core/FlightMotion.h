@@ -0,0 +1,53 @@
+#ifndef FLIGHTMOTION_H
+#define FLIGHTMOTION_H
+
+#include "FlightData.h"
+
+// Moves one aircraft smoothly between position reports. The aircraft is dead-reckoned along
+// its reported heading, speed and vertical rate, and the jump to each new report is eased out
+// over a short blend instead of snapping. Times are milliseconds on any monotonic clock.
+class FlightMotion
+{
+public:
+    struct State
+    {
+        double longitude = 0.0;
+        double latitude = 0.0;
+        double altitude = 0.0;  // meters
+        double heading = 0.0;   // degrees clockwise from north
+        double pitch = 0.0;     // degrees, nose up positive
+    };
+
+    struct Options
+    {
+        int blendMs = 1500;                // how long a correction takes to ease out
+        int maxExtrapolationMs = 20000;    // stop coasting when reports stop coming
+        double snapDistanceDegrees = 0.1;  // corrections larger than this jump instead
+    };
+
+    explicit FlightMotion(const Options& options = Options());
+
+    bool isValid() const { return m_report.isValid(); }
+    const FlightData& lastReport() const { return m_report; }
+
+    // Takes a new report at nowMs. A repeat of the last report is ignored, so the aircraft
+    // keeps coasting from when that position was first seen.
+    void report(const FlightData& flight, qint64 nowMs);
+    void clear();
+
+    State at(qint64 nowMs) const;
+
+    // True once nothing moves until the next report
+    bool isSettled(qint64 nowMs) const;
+
+private:
+    State reckon(qint64 nowMs) const;
+
+    Options m_options;
+    FlightData m_report;
+    qint64 m_reportMs = 0;
+    // Shown minus reported at the time of the report, eased to zero over the blend
+    State m_correction;
+};
+
+#endif // FLIGHTMOTION_H
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "FlightReplayService.h"
+#include <QDebug>
+#include <cmath>
+#include <limits>
+
+FlightReplayService::FlightReplayService(QObject *parent)
+    : QObject(parent)
+    , m_frameTimer(new QTimer(this))
+{
+    m_frameTimer->setSingleShot(true);
+    connect(m_frameTimer, &QTimer::timeout, this, &FlightReplayService::emitPendingSnapshot);
+}
+
+bool FlightReplayService::open(const QString& path)
+{
+    close();
+
+    if (!m_reader.open(path)) {
+        emit replayFailed(m_reader.errorString());
+        return false;
+    }
+
+    qDebug() << "Replay archive opened:" << path;
+    return true;
+}
+
+void FlightReplayService::close()
+{
+    pause();
+    m_reader.close();
+    m_hasPending = false;
+    m_awaitingAck = false;
+    m_currentTime = 0;
+}
+
+void FlightReplayService::setSpeed(double speed)
+{
+    m_speed = std::isfinite(speed) && speed > 0.0 ? speed : 0.0;
+}
+
+void FlightReplayService::start()
+{
+    if (!m_reader.isOpen()) {
+        emit replayFailed("No replay archive open");
+        return;
+    }
+
+    m_reader.rewind();
+    m_currentTime = 0;
+    m_awaitingAck = false;
+
+    if (!loadPending()) {
+        emit replayFailed("Replay archive contains no snapshots");
+        return;
+    }
+
+    resume();
+}
+
+void FlightReplayService::pause()
+{
+    m_frameTimer->stop();
+    if (m_playing) {
+        m_playing = false;
+        emit playingChanged();
+    }
+}
+
+void FlightReplayService::resume()
+{
+    if (m_playing || !m_reader.isOpen()) {
+        return;
+    }
+    if (!m_hasPending) {
+        start();
+        return;
+    }
+
+    m_playing = true;
+    emit playingChanged();
+    scheduleNext();
+}
+
+void FlightReplayService::seek(qint64 timestamp)
+{
+    if (!m_reader.isOpen()) {
+        return;
+    }
+
+    m_frameTimer->stop();
+
+    if (!m_reader.seek(timestamp)) {
+        qDebug() << "Replay seek past end of archive:" << timestamp;
+        if (m_loop) {
+            // Looping replays carry on from the start, as they do on reaching the end
+            m_reader.rewind();
+        } else {
+            m_hasPending = false;
+            m_awaitingAck = false;
+            if (m_playing) {
+                m_playing = false;
+                emit playingChanged();
+            }
+            emit replayFinished();
+            return;
+        }
+    }
+
+    // The snapshot at the seek target is shown straight away rather than after a gap
+    m_currentTime = 0;
+    loadPending();
+    scheduleNext();
+}
+
+void FlightReplayService::acknowledgeSnapshot()
+{
+    if (!m_awaitingAck) {
+        return;
+    }
+
+    m_awaitingAck = false;
+    scheduleNext();
+}
+
+bool FlightReplayService::loadPending()
+{
+    m_hasPending = m_reader.readNext(m_pending);
+
+    if (!m_hasPending && m_loop) {
+        m_reader.rewind();
+        m_currentTime = 0;
+        m_hasPending = m_reader.readNext(m_pending);
+    }
+    return m_hasPending;
+}
+
+void FlightReplayService::scheduleNext()
+{
+    if (!m_playing || m_awaitingAck || !m_hasPending) {
+        return;
+    }
+
+    qint64 delay = 0;
+    if (m_currentTime != 0 && m_speed > 0.0) {
+        const qint64 gap = m_pending.timestamp - m_currentTime;
+        delay = qMax<qint64>(0, qint64(gap / m_speed) - m_sinceEmit.elapsed());
+    }
+
+    m_frameTimer->start(int(qMin<qint64>(delay, std::numeric_limits<int>::max())));
+}
+
+void FlightReplayService::emitPendingSnapshot()
+{
+    if (!m_hasPending) {
+        return;
+    }
+
+    const FlightSnapshot snapshot = std::move(m_pending);
+    m_hasPending = false;
+    m_currentTime = snapshot.timestamp;
+    m_awaitingAck = true;
+    m_sinceEmit.start();
+
+    emit currentTimeChanged(m_currentTime);
+    emit flightDataReceived(snapshot.flights);
+
+    // Read ahead while the pipeline is busy with this snapshot
+    if (!loadPending()) {
+        m_playing = false;
+        emit playingChanged();
+        emit replayFinished();
+        return;
+    }
+
+    // Consumers may acknowledge synchronously from within flightDataReceived
+    scheduleNext();
+}
\ No newline at end of file
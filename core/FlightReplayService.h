@@ -0,0 +1,71 @@
+#ifndef FLIGHTREPLAYSERVICE_H
+#define FLIGHTREPLAYSERVICE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "FlightArchive.h"
+
+// Plays a recorded archive back through the same flightDataReceived signal as FlightDataService.
+// The replay clock only ever takes the timestamps of recorded snapshots, and each snapshot waits
+// for acknowledgeSnapshot() before the next one is scheduled, so a run is identical at any speed.
+class FlightReplayService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FlightReplayService(QObject *parent = nullptr);
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_reader.isOpen(); }
+
+    // Playback speed multiplier; 0 plays as fast as the pipeline acknowledges snapshots
+    void setSpeed(double speed);
+    double speed() const { return m_speed; }
+
+    void setLoop(bool loop) { m_loop = loop; }
+    bool loop() const { return m_loop; }
+
+    void start();
+    void pause();
+    // Continues from where playback stopped, or from the start once the archive has finished
+    void resume();
+    // A seek past the last snapshot finishes the replay, or starts it over when looping
+    void seek(qint64 timestamp);
+
+    bool isPlaying() const { return m_playing; }
+    // Stopped after the last snapshot (or a seek past it) with nothing left to play
+    bool isFinished() const { return m_reader.isOpen() && !m_playing && !m_hasPending; }
+    qint64 currentTime() const { return m_currentTime; }
+
+    // Called by the consumer once a snapshot has been fully processed
+    void acknowledgeSnapshot();
+
+signals:
+    void flightDataReceived(const QList<FlightData>& flights);
+    void currentTimeChanged(qint64 timestamp);
+    void playingChanged();
+    void replayFinished();
+    void replayFailed(const QString& error);
+
+private slots:
+    void emitPendingSnapshot();
+
+private:
+    void scheduleNext();
+    bool loadPending();
+
+    FlightArchiveReader m_reader;
+    QTimer* m_frameTimer;
+    QElapsedTimer m_sinceEmit;
+    FlightSnapshot m_pending;
+    bool m_hasPending = false;
+    bool m_awaitingAck = false;
+    bool m_playing = false;
+    bool m_loop = false;
+    double m_speed = 1.0;
+    qint64 m_currentTime = 0;
+};
+
+#endif // FLIGHTREPLAYSERVICE_H
\ No newline at end of file
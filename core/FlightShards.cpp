@@ -0,0 +1,71 @@
+#include "FlightShards.h"
+#include <QSet>
+#include <cmath>
+#include <limits>
+
+QList<QRectF> FlightShards::split(const QRectF& area, int count)
+{
+    if (count <= 1 || area.isEmpty()) {
+        return {area};
+    }
+
+    // Pick the rows x columns factorisation whose cells are closest to square
+    int rows = 1;
+    double bestSkew = std::numeric_limits<double>::max();
+    for (int r = 1; r <= count; ++r) {
+        if (count % r != 0) {
+            continue;
+        }
+        const double cellAspect = (area.width() / (count / r)) / (area.height() / r);
+        const double skew = std::abs(std::log(cellAspect));
+        if (skew < bestSkew) {
+            bestSkew = skew;
+            rows = r;
+        }
+    }
+    const int columns = count / rows;
+
+    QList<QRectF> boxes;
+    boxes.reserve(count);
+    const double cellWidth = area.width() / columns;
+    const double cellHeight = area.height() / rows;
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            // Edges are computed from the area rather than accumulated, so neighbours meet exactly
+            const double left = area.left() + column * cellWidth;
+            const double right = column == columns - 1 ? area.right() : area.left() + (column + 1) * cellWidth;
+            const double top = area.top() + row * cellHeight;
+            const double bottom = row == rows - 1 ? area.bottom() : area.top() + (row + 1) * cellHeight;
+            boxes.append(QRectF(QPointF(left, top), QPointF(right, bottom)));
+        }
+    }
+    return boxes;
+}
+
+QList<FlightData> FlightShards::merge(const QList<QList<FlightData>>& shards)
+{
+    if (shards.size() == 1) {
+        return shards.first();
+    }
+
+    qsizetype total = 0;
+    for (const QList<FlightData>& shard : shards) {
+        total += shard.size();
+    }
+
+    QList<FlightData> flights;
+    flights.reserve(total);
+    QSet<QString> seen;
+    seen.reserve(total);
+
+    for (const QList<FlightData>& shard : shards) {
+        for (const FlightData& flight : shard) {
+            const qsizetype before = seen.size();
+            seen.insert(flight.icao24());
+            if (seen.size() != before) {
+                flights.append(flight);
+            }
+        }
+    }
+    return flights;
+}
\ No newline at end of file
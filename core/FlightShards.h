@@ -0,0 +1,23 @@
+#ifndef FLIGHTSHARDS_H
+#define FLIGHTSHARDS_H
+
+#include <QList>
+#include <QRectF>
+#include "FlightData.h"
+
+// Splitting a /states/all fetch into bounding boxes and merging the answers.
+// Areas are in degrees with longitude on x and latitude on y.
+class FlightShards
+{
+public:
+    static QRectF world() { return QRectF(-180.0, -90.0, 360.0, 180.0); }
+
+    // A grid of count boxes covering area, with cells as close to square as count allows
+    static QList<QRectF> split(const QRectF& area, int count);
+
+    // Every aircraft once, in shard order. OpenSky bounds are inclusive, so an aircraft
+    // on the edge between two boxes is reported by both.
+    static QList<FlightData> merge(const QList<QList<FlightData>>& shards);
+};
+
+#endif // FLIGHTSHARDS_H
\ No newline at end of file
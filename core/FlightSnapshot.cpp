@@ -0,0 +1,68 @@
+#include "FlightSnapshot.h"
+#include <QSet>
+
+void FlightSnapshotState::reset(const QList<FlightData>& flights)
+{
+    m_flights.clear();
+    m_indexByIcao.clear();
+    m_flights.reserve(flights.size());
+    m_indexByIcao.reserve(flights.size());
+
+    for (const FlightData& flight : flights) {
+        auto it = m_indexByIcao.constFind(flight.icao24());
+        if (it != m_indexByIcao.constEnd()) {
+            m_flights[*it] = flight;
+        } else {
+            m_indexByIcao.insert(flight.icao24(), m_flights.size());
+            m_flights.append(flight);
+        }
+    }
+}
+
+void FlightSnapshotState::apply(const FlightSnapshotDelta& delta)
+{
+    if (!delta.removed.isEmpty()) {
+        const QSet<QString> removed(delta.removed.cbegin(), delta.removed.cend());
+        m_flights.removeIf([&removed](const FlightData& flight) {
+            return removed.contains(flight.icao24());
+        });
+
+        m_indexByIcao.clear();
+        for (qsizetype i = 0; i < m_flights.size(); ++i) {
+            m_indexByIcao.insert(m_flights[i].icao24(), i);
+        }
+    }
+
+    for (const FlightData& flight : delta.upserted) {
+        auto it = m_indexByIcao.constFind(flight.icao24());
+        if (it != m_indexByIcao.constEnd()) {
+            m_flights[*it] = flight;
+        } else {
+            m_indexByIcao.insert(flight.icao24(), m_flights.size());
+            m_flights.append(flight);
+        }
+    }
+}
+
+FlightSnapshotDelta FlightSnapshotState::diff(const QList<FlightData>& next) const
+{
+    FlightSnapshotDelta delta;
+    QSet<QString> seen;
+    seen.reserve(next.size());
+
+    for (const FlightData& flight : next) {
+        seen.insert(flight.icao24());
+        auto it = m_indexByIcao.constFind(flight.icao24());
+        if (it == m_indexByIcao.constEnd() || m_flights[*it] != flight) {
+            delta.upserted.append(flight);
+        }
+    }
+
+    for (const FlightData& flight : m_flights) {
+        if (!seen.contains(flight.icao24())) {
+            delta.removed.append(flight.icao24());
+        }
+    }
+
+    return delta;
+}
\ No newline at end of file
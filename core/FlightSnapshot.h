@@ -0,0 +1,42 @@
+#ifndef FLIGHTSNAPSHOT_H
+#define FLIGHTSNAPSHOT_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include "FlightData.h"
+
+// One decoded /states/all response and the time it was received
+struct FlightSnapshot
+{
+    qint64 timestamp = 0;   // msecs since epoch
+    QList<FlightData> flights;
+};
+
+// Aircraft that appeared or changed, and the icao24s of those that disappeared, between two snapshots
+struct FlightSnapshotDelta
+{
+    QList<FlightData> upserted;
+    QStringList removed;
+
+    bool isEmpty() const { return upserted.isEmpty() && removed.isEmpty(); }
+};
+
+// Snapshot state keyed by icao24 that keeps the order aircraft were first seen in
+class FlightSnapshotState
+{
+public:
+    void reset(const QList<FlightData>& flights);
+    void apply(const FlightSnapshotDelta& delta);
+    FlightSnapshotDelta diff(const QList<FlightData>& next) const;
+
+    const QList<FlightData>& flights() const { return m_flights; }
+    bool isEmpty() const { return m_flights.isEmpty(); }
+
+private:
+    QList<FlightData> m_flights;
+    QHash<QString, qsizetype> m_indexByIcao;
+};
+
+#endif // FLIGHTSNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "FlightStore.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+FlightSnapshotDelta FlightStore::ingest(const QList<FlightData>& flights)
+{
+    FlightSnapshotDelta delta;
+    {
+        TraceScope trace("diff", "pipeline");
+        delta = m_previous.diff(flights);
+        m_previous.apply(delta);
+    }
+    m_hasNewCountries = m_stats.apply(delta);
+
+    m_flights = flights;
+    m_indexByIcao.clear();
+    m_indexByIcao.reserve(m_flights.size());
+    // Walked backwards so a duplicated icao24 resolves to its first occurrence
+    for (int i = int(m_flights.size()) - 1; i >= 0; --i) {
+        m_indexByIcao.insert(m_flights[i].icao24(), i);
+    }
+
+    m_hitTester.setFlights(m_flights);
+    evaluateFilter();
+    return delta;
+}
+
+void FlightStore::clear()
+{
+    m_flights.clear();
+    m_indexByIcao.clear();
+    m_previous.reset({});
+    m_stats.clear();
+    m_hasNewCountries = false;
+    m_visible.clear();
+    m_visibleCount = 0;
+    m_hitTester.clear();
+}
+
+FlightData FlightStore::flight(const QString& icao24) const
+{
+    const int index = indexOf(icao24);
+    return index >= 0 ? m_flights[index] : FlightData();
+}
+
+void FlightStore::setFilter(const FlightFilter& filter)
+{
+    m_filter = filter;
+    evaluateFilter();
+}
+
+void FlightStore::evaluateFilter()
+{
+    m_visible.resize(m_flights.size());
+    m_visibleCount = 0;
+    for (qsizetype i = 0; i < m_flights.size(); ++i) {
+        const FlightData& flight = m_flights[i];
+        m_visible[i] = flight.isValid() && m_filter.matches(flight);
+        m_visibleCount += m_visible[i];
+    }
+}
+
+int FlightStore::hitTest(double longitude, double latitude, double toleranceMeters, qsizetype limit) const
+{
+    if (limit < 0 || limit >= m_visible.size()) {
+        return m_hitTester.hitTest(longitude, latitude, toleranceMeters, m_visible);
+    }
+    return m_hitTester.hitTest(longitude, latitude, toleranceMeters, m_visible.first(limit));
+}
+
+QMap<QString, QStringList> FlightStore::countriesByContinent() const
+{
+    QMap<QString, QStringList> continents;
+    const QStringList& countries = m_stats.countries();
+    for (int id = 0; id < countries.size(); ++id) {
+        continents[m_stats.continents()[m_stats.continentOf(id)]].append(countries[id]);
+    }
+
+    for (QStringList& countries : continents) {
+        std::sort(countries.begin(), countries.end());
+    }
+    return continents;
+}
+
+bool FlightStore::startRecording(const QString& path, int keyframeInterval)
+{
+    m_history.setKeyframeInterval(keyframeInterval);
+    return m_history.open(path);
+}
+
+bool FlightStore::record(const QList<FlightData>& flights, qint64 timestamp)
+{
+    if (!m_history.isOpen()) {
+        return false;
+    }
+
+    TraceScope trace("record", "pipeline");
+
+    FlightSnapshot snapshot;
+    snapshot.timestamp = timestamp;
+    snapshot.flights = flights;
+    return m_history.append(snapshot);
+}
\ No newline at end of file
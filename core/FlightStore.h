@@ -0,0 +1,80 @@
+#ifndef FLIGHTSTORE_H
+#define FLIGHTSTORE_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include "FlightData.h"
+#include "FlightSnapshot.h"
+#include "FlightFilter.h"
+#include "FlightHitTester.h"
+#include "FlightArchive.h"
+#include "CountryRegistry.h"
+#include "TrafficStats.h"
+
+// The current flights and everything derived from them, independent of how they are drawn.
+// Each ingest replaces the snapshot, diffs it against the previous one and re-evaluates the
+// filter, so the visibility flags, hit-test index and lookups always describe the same list.
+// Flights keep the order they were ingested in, which callers can rely on to line up graphics.
+class FlightStore
+{
+public:
+    // Replaces the current flights and returns what changed since the previous ingest
+    FlightSnapshotDelta ingest(const QList<FlightData>& flights);
+    void clear();
+
+    const QList<FlightData>& flights() const { return m_flights; }
+    qsizetype size() const { return m_flights.size(); }
+    bool isEmpty() const { return m_flights.isEmpty(); }
+
+    // Index of the first flight with icao24, or -1
+    int indexOf(const QString& icao24) const { return m_indexByIcao.value(icao24, -1); }
+    FlightData flight(const QString& icao24) const;
+
+    // Filtering
+    void setFilter(const FlightFilter& filter);
+    const FlightFilter& filter() const { return m_filter; }
+    const QList<bool>& visibility() const { return m_visible; }
+    qsizetype visibleCount() const { return m_visibleCount; }
+
+    // Index of the visible flight nearest the click within toleranceMeters, or -1.
+    // Only the first limit flights are considered when limit is not negative.
+    int hitTest(double longitude, double latitude, double toleranceMeters, qsizetype limit = -1) const;
+
+    // Running counts per country, continent, status, vertical state and altitude band, from
+    // each ingest's delta
+    const TrafficStats& stats() const { return m_stats; }
+    // The last ingest brought a country not seen since clear()
+    bool hasNewCountries() const { return m_hasNewCountries; }
+
+    // Countries seen since the last clear() grouped by continent, sorted by name. A country
+    // stays listed after its last flight leaves, so a deselection in the filter is not lost.
+    void setCountries(const CountryRegistry& registry) { m_stats.setCountryRegistry(registry); }
+    const CountryRegistry& countries() const { return m_stats.countryRegistry(); }
+    QMap<QString, QStringList> countriesByContinent() const;
+
+    // History: snapshots appended to an archive that FlightReplayService can play back
+    bool startRecording(const QString& path, int keyframeInterval = 30);
+    void stopRecording() { m_history.close(); }
+    bool isRecording() const { return m_history.isOpen(); }
+    QString recordingError() const { return m_history.errorString(); }
+    bool record(const QList<FlightData>& flights, qint64 timestamp);
+
+private:
+    void evaluateFilter();
+
+    QList<FlightData> m_flights;
+    QHash<QString, int> m_indexByIcao;
+    FlightSnapshotState m_previous;
+    FlightFilter m_filter;
+    QList<bool> m_visible;
+    qsizetype m_visibleCount = 0;
+    FlightHitTester m_hitTester;
+    TrafficStats m_stats;
+    bool m_hasNewCountries = false;
+    FlightArchiveWriter m_history;
+};
+
+#endif // FLIGHTSTORE_H
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "FlightTrack.h"
+#include "WebMercator.h"
+#include <QJsonArray>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+double distanceToSegment(const QPointF& p, const QPointF& a, const QPointF& b)
+{
+    const double dx = b.x() - a.x();
+    const double dy = b.y() - a.y();
+    const double lengthSquared = dx * dx + dy * dy;
+
+    double t = 0.0;
+    if (lengthSquared > 0.0) {
+        t = std::clamp(((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / lengthSquared, 0.0, 1.0);
+    }
+    return std::hypot(p.x() - (a.x() + t * dx), p.y() - (a.y() + t * dy));
+}
+}
+
+FlightTrack::FlightTrack(const QList<Waypoint>& waypoints)
+    : m_waypoints(waypoints)
+{
+    computeImportance();
+}
+
+FlightTrack FlightTrack::fromJson(const QJsonObject& trackData)
+{
+    FlightTrack track;
+    track.m_icao24 = trackData["icao24"].toString();
+
+    const QJsonArray path = trackData["path"].toArray();
+    track.m_waypoints.reserve(path.size());
+
+    // Waypoint layout: [time, latitude, longitude, baro_altitude, true_track, on_ground]
+    for (const QJsonValue& value : path) {
+        const QJsonArray waypoint = value.toArray();
+        if (waypoint.size() < 6) {
+            continue;
+        }
+
+        const double lat = waypoint[1].toDouble();
+        const double lon = waypoint[2].toDouble();
+        if (lat == 0.0 && lon == 0.0) {
+            continue;
+        }
+
+        const bool onGround = waypoint[5].toBool();
+        track.m_waypoints.append({lon, lat, onGround ? 0.0 : waypoint[3].toDouble()});
+    }
+
+    track.computeImportance();
+    return track;
+}
+
+void FlightTrack::computeImportance()
+{
+    const int count = int(m_waypoints.size());
+    m_importance.fill(0.0, count);
+    m_sortedImportance.clear();
+
+    if (count == 0) {
+        return;
+    }
+
+    QList<QPointF> projected;
+    projected.reserve(count);
+    for (const Waypoint& waypoint : m_waypoints) {
+        projected.append(WebMercator::project(waypoint.longitude, waypoint.latitude));
+    }
+
+    // Endpoints are always kept
+    m_importance[0] = std::numeric_limits<double>::infinity();
+    m_importance[count - 1] = std::numeric_limits<double>::infinity();
+
+    // Iterative Douglas-Peucker. A vertex's importance is capped by its parent's so that
+    // the kept set shrinks monotonically as tolerance grows.
+    struct Span { int first; int last; double cap; };
+    QList<Span> stack;
+    stack.append({0, count - 1, std::numeric_limits<double>::infinity()});
+
+    while (!stack.isEmpty()) {
+        const Span span = stack.takeLast();
+        if (span.last - span.first < 2) {
+            continue;
+        }
+
+        int farthest = -1;
+        double maxDistance = -1.0;
+        for (int i = span.first + 1; i < span.last; ++i) {
+            const double distance = distanceToSegment(projected[i], projected[span.first], projected[span.last]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                farthest = i;
+            }
+        }
+
+        const double importance = std::min(maxDistance, span.cap);
+        m_importance[farthest] = importance;
+        stack.append({span.first, farthest, importance});
+        stack.append({farthest, span.last, importance});
+    }
+
+    m_sortedImportance = m_importance;
+    std::sort(m_sortedImportance.begin(), m_sortedImportance.end(), std::greater<double>());
+}
+
+int FlightTrack::vertexCountForTolerance(double toleranceMeters) const
+{
+    // Vertices with importance >= tolerance are kept
+    auto it = std::partition_point(m_sortedImportance.cbegin(), m_sortedImportance.cend(),
+                                   [toleranceMeters](double importance) { return importance >= toleranceMeters; });
+    return int(it - m_sortedImportance.cbegin());
+}
+
+QList<int> FlightTrack::verticesForTolerance(double toleranceMeters) const
+{
+    QList<int> vertices;
+    vertices.reserve(vertexCountForTolerance(toleranceMeters));
+
+    for (int i = 0; i < m_importance.size(); ++i) {
+        if (m_importance[i] >= toleranceMeters) {
+            vertices.append(i);
+        }
+    }
+    return vertices;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef FLIGHTTRACK_H
+#define FLIGHTTRACK_H
+
+#include <QList>
+#include <QString>
+#include <QJsonObject>
+
+// Waypoints of one aircraft's track with a Douglas-Peucker importance per vertex.
+// Importance is the largest simplification tolerance (Web Mercator meters) at which the vertex
+// is still kept, so any zoom level can pick its vertex subset without re-simplifying.
+class FlightTrack
+{
+public:
+    struct Waypoint
+    {
+        double longitude = 0.0;
+        double latitude = 0.0;
+        double altitude = 0.0;  // meters, 0 while on ground
+    };
+
+    FlightTrack() = default;
+    explicit FlightTrack(const QList<Waypoint>& waypoints);
+
+    // Builds a track from a /tracks/all response
+    static FlightTrack fromJson(const QJsonObject& trackData);
+
+    QString icao24() const { return m_icao24; }
+    bool isEmpty() const { return m_waypoints.size() < 2; }
+    const QList<Waypoint>& waypoints() const { return m_waypoints; }
+    const QList<double>& importance() const { return m_importance; }
+
+    // Indices of the vertices kept at the given tolerance, in track order
+    QList<int> verticesForTolerance(double toleranceMeters) const;
+    int vertexCountForTolerance(double toleranceMeters) const;
+
+private:
+    void computeImportance();
+
+    QString m_icao24;
+    QList<Waypoint> m_waypoints;
+    QList<double> m_importance;
+    QList<double> m_sortedImportance;  // descending, for counting vertices per tolerance
+};
+
+#endif // FLIGHTTRACK_H
\ No newline at end of file
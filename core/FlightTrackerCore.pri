@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#  Links the FlightTrackerCore static library. Build it first:
+#  FlightTrackerProject.pro orders the subprojects accordingly.
+#-------------------------------------------------
+
+QT *= core network concurrent
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+FLIGHT_TRACKER_CORE_DIR = $$shadowed($$PWD)
+
+LIBS += -L$$FLIGHT_TRACKER_CORE_DIR -lFlightTrackerCore
+PRE_TARGETDEPS += $$FLIGHT_TRACKER_CORE_DIR/$${QMAKE_PREFIX_STATICLIB}FlightTrackerCore.$${QMAKE_EXTENSION_STATICLIB}
+
+# MemoryStats reads the working set through psapi
+win32: LIBS += -lpsapi
\ No newline at end of file
@@ -0,0 +1,88 @@
+#-------------------------------------------------
+#  Flight data logic without the ArcGIS SDK or a GPU: ingest,
+#  store, diff, filter, query and history, plus the data sources.
+#  Built as a static library that the app, the CLI, the tools and
+#  the benchmarks link through FlightTrackerCore.pri.
+#-------------------------------------------------
+
+TEMPLATE = lib
+
+CONFIG += staticlib c++17
+# One output directory in every configuration, so consumers find the library
+CONFIG -= debug_and_release debug_and_release_target
+
+QT = core network concurrent
+
+TARGET = FlightTrackerCore
+DESTDIR = $$OUT_PWD
+
+HEADERS += \
+    FlightData.h \
+    FlightDataSource.h \
+    FlightDataService.h \
+    FlightShards.h \
+    FileFlightDataSource.h \
+    TrafficGenerator.h \
+    SyntheticFlightDataSource.h \
+    OpenSkyAuthManager.h \
+    FlightSnapshot.h \
+    SnapshotCodec.h \
+    FlightArchive.h \
+    SnapshotCache.h \
+    ModelCache.h \
+    FlightReplayService.h \
+    FlightStore.h \
+    FlightTrack.h \
+    FlightMotion.h \
+    WebMercator.h \
+    FlightFilter.h \
+    FlightClassifier.h \
+    FlightHitTester.h \
+    TrafficLod.h \
+    TrafficStats.h \
+    AlertEngine.h \
+    ConflictDetector.h \
+    DensityGrid.h \
+    CountryRegistry.h \
+    CountryTreeModel.h \
+    FlightListModel.h \
+    PipelineStats.h \
+    TraceRecorder.h \
+    StartupTimeline.h \
+    GraphicsGeneration.h \
+    MemoryStats.h
+
+SOURCES += \
+    FlightData.cpp \
+    FlightDataSource.cpp \
+    FlightDataService.cpp \
+    FlightShards.cpp \
+    FileFlightDataSource.cpp \
+    TrafficGenerator.cpp \
+    SyntheticFlightDataSource.cpp \
+    OpenSkyAuthManager.cpp \
+    FlightSnapshot.cpp \
+    SnapshotCodec.cpp \
+    FlightArchive.cpp \
+    SnapshotCache.cpp \
+    ModelCache.cpp \
+    FlightReplayService.cpp \
+    FlightStore.cpp \
+    FlightTrack.cpp \
+    FlightMotion.cpp \
+    FlightFilter.cpp \
+    FlightClassifier.cpp \
+    FlightHitTester.cpp \
+    TrafficLod.cpp \
+    TrafficStats.cpp \
+    AlertEngine.cpp \
+    ConflictDetector.cpp \
+    DensityGrid.cpp \
+    CountryRegistry.cpp \
+    CountryTreeModel.cpp \
+    FlightListModel.cpp \
+    PipelineStats.cpp \
+    TraceRecorder.cpp \
+    StartupTimeline.cpp \
+    GraphicsGeneration.cpp \
+    MemoryStats.cpp
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "GraphicsGeneration.h"
+
+std::atomic<qint64> GraphicsGeneration::s_live[GraphicsGeneration::KindCount] = {};
+std::atomic<qint64> GraphicsGeneration::s_generations{0};
+
+GraphicsGeneration::GraphicsGeneration(QObject *parent)
+    : QObject(parent)
+{
+    s_generations.fetch_add(1, std::memory_order_relaxed);
+}
+
+GraphicsGeneration::~GraphicsGeneration()
+{
+    // Children are deleted by ~QObject right after this, so they leave the counts now
+    for (int kind = 0; kind < KindCount; ++kind) {
+        s_live[kind].fetch_sub(m_counts[kind], std::memory_order_relaxed);
+    }
+    s_generations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void GraphicsGeneration::track(Kind kind, qint64 count)
+{
+    m_counts[kind] += count;
+    s_live[kind].fetch_add(count, std::memory_order_relaxed);
+}
+
+QVariantMap GraphicsGeneration::liveCounts()
+{
+    return {
+        {"graphics", liveCount(Graphics)},
+        {"symbols", liveCount(Symbols)},
+        {"popups", liveCount(Popups)},
+        {"generations", liveGenerations()}
+    };
+}
\ No newline at end of file
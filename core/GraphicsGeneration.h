@@ -0,0 +1,44 @@
+#ifndef GRAPHICSGENERATION_H
+#define GRAPHICSGENERATION_H
+
+#include <QObject>
+#include <QVariantMap>
+#include <atomic>
+
+// Owner of the graphics, symbols and popups created for one refresh of one overlay.
+// Everything created for the refresh is parented to its generation, and the generation is
+// deleted when the overlay is cleared, so nothing outlives the graphics it was made for.
+// Live counts across all generations are kept for memory accounting.
+class GraphicsGeneration : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        Graphics,
+        Symbols,
+        Popups,
+        KindCount
+    };
+
+    explicit GraphicsGeneration(QObject *parent = nullptr);
+    ~GraphicsGeneration() override;
+
+    // Counts objects created with this generation as parent
+    void track(Kind kind, qint64 count = 1);
+    qint64 count(Kind kind) const { return m_counts[kind]; }
+
+    static qint64 liveCount(Kind kind) { return s_live[kind].load(std::memory_order_relaxed); }
+    static qint64 liveGenerations() { return s_generations.load(std::memory_order_relaxed); }
+
+    // {graphics, symbols, popups, generations} for QML
+    static QVariantMap liveCounts();
+
+private:
+    qint64 m_counts[KindCount] = {};
+
+    static std::atomic<qint64> s_live[KindCount];
+    static std::atomic<qint64> s_generations;
+};
+
+#endif // GRAPHICSGENERATION_H
\ No newline at end of file
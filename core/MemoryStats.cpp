@@ -0,0 +1,45 @@
+#include "MemoryStats.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS) || defined(Q_OS_IOS)
+#include <mach/mach.h>
+#elif defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#include <QFile>
+#include <unistd.h>
+#endif
+
+namespace MemoryStats {
+
+qint64 residentBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return qint64(counters.WorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_MACOS) || defined(Q_OS_IOS)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, task_info_t(&info), &count) == KERN_SUCCESS) {
+        return qint64(info.resident_size);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    // Second field of statm is resident pages
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    bool ok = false;
+    const qint64 pages = fields.size() > 1 ? fields[1].toLongLong(&ok) : 0;
+    return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <QtGlobal>
+
+namespace MemoryStats {
+
+// Resident set size of this process in bytes, -1 where the platform doesn't report it
+qint64 residentBytes();
+
+}
+
+#endif // MEMORYSTATS_H
\ No newline at end of file
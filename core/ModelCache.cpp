@@ -0,0 +1,86 @@
+#include "ModelCache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QDebug>
+
+namespace {
+// Written last, so a directory without it is an interrupted copy
+const QString CompleteMarker = ".complete";
+}
+
+QString ModelCache::defaultRoot()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("models");
+}
+
+QString ModelCache::extract(const QString& resourceDir, const QStringList& files, const QString& mainFile,
+                            const QString& root)
+{
+    const QDir source(resourceDir);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString& name : files) {
+        QFile file(source.filePath(name));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "Cannot read model file" << file.fileName();
+            return QString();
+        }
+        hash.addData(name.toUtf8());
+        hash.addData(&file);
+    }
+    const QString key = QString::fromLatin1(hash.result().toHex().left(16));
+
+    QDir rootDir(root);
+    const QString target = rootDir.filePath(key);
+    const QString mainPath = QDir(target).filePath(mainFile);
+    if (QFile::exists(QDir(target).filePath(CompleteMarker))) {
+        return mainPath;
+    }
+
+    // Copy into a staging directory and rename it into place, so a crash or a second
+    // process copying at the same time never leaves a half-written model behind
+    rootDir.mkpath(".");
+    QDir(target).removeRecursively();
+    QTemporaryDir staging(rootDir.filePath(key + "-XXXXXX"));
+    if (!staging.isValid()) {
+        qWarning() << "Cannot create model cache directory in" << root;
+        return QString();
+    }
+
+    for (const QString& name : files) {
+        const QString destination = staging.filePath(name);
+        if (!QFile::copy(source.filePath(name), destination)) {
+            qWarning() << "Cannot copy model file" << name << "to" << staging.path();
+            return QString();
+        }
+        // Resource copies are read-only, which would stop the pruning below from deleting them
+        QFile::setPermissions(destination, QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+    }
+
+    QFile marker(staging.filePath(CompleteMarker));
+    if (!marker.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write" << marker.fileName();
+        return QString();
+    }
+    marker.close();
+
+    if (rootDir.rename(QFileInfo(staging.path()).fileName(), key)) {
+        staging.setAutoRemove(false);
+    } else if (!QFile::exists(QDir(target).filePath(CompleteMarker))) {
+        qWarning() << "Cannot move model cache into" << target;
+        return QString();
+    }
+
+    // Older builds' models are never read again
+    for (const QString& entry : rootDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (!entry.startsWith(key)) {
+            QDir(rootDir.filePath(entry)).removeRecursively();
+        }
+    }
+
+    return mainPath;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef MODELCACHE_H
+#define MODELCACHE_H
+
+#include <QString>
+#include <QStringList>
+
+// Model files bundled as resources, copied to disk once for loaders that need real files
+// (the 3D symbol reads the OBJ, its MTL and the textures by path). Each copy lives in a
+// directory named after a hash of the file contents, so it survives restarts and a new
+// build with a different model gets a fresh directory instead of stale textures.
+class ModelCache
+{
+public:
+    // <cache location>/models
+    static QString defaultRoot();
+
+    // Copies files from resourceDir into <root>/<hash>/ unless a complete copy is already there
+    // and returns the local path of mainFile, or an empty string when the copy fails.
+    // Directories left by other hashes are removed. Safe to call from a worker thread.
+    static QString extract(const QString& resourceDir, const QStringList& files, const QString& mainFile,
+                           const QString& root = defaultRoot());
+};
+
+#endif // MODELCACHE_H
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "OpenSkyAuthManager.h"
+#include "TraceRecorder.h"
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+namespace {
+// Refresh this long before expiry, or halfway through lifetimes shorter than twice this
+constexpr int RefreshMarginSecs = 60;
+constexpr int MinRetryDelayMs = 2000;
+constexpr int MaxRetryDelayMs = 60000;
+}
+
+OpenSkyAuthManager::OpenSkyAuthManager(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(new QNetworkAccessManager(this))
+    , m_refreshTimer(new QTimer(this))
+    , m_tokenUrl(defaultTokenUrl())
+{
+    m_refreshTimer->setSingleShot(true);
+    connect(m_refreshTimer, &QTimer::timeout, this, &OpenSkyAuthManager::refreshToken);
+}
+
+QUrl OpenSkyAuthManager::defaultTokenUrl()
+{
+    return QUrl("https://auth.opensky-network.org/auth/realms/opensky-network/protocol/openid-connect/token");
+}
+
+void OpenSkyAuthManager::setCredentials(const QString& clientId, const QString& clientSecret)
+{
+    m_clientId = clientId;
+    m_clientSecret = clientSecret;
+}
+
+void OpenSkyAuthManager::authenticate()
+{
+    if (m_clientId.isEmpty() || m_clientSecret.isEmpty()) {
+        emit authenticationFailed("Missing credentials");
+        return;
+    }
+    
+    qDebug() << "Starting OpenSky Network authentication...";
+    requestAccessToken();
+}
+
+void OpenSkyAuthManager::refreshToken()
+{
+    // Callers rejected with 401 all land here; they share the request already in flight
+    if (m_requestPending || m_clientId.isEmpty() || m_clientSecret.isEmpty()) {
+        return;
+    }
+
+    qDebug() << "Refreshing OpenSky access token";
+    m_refreshTimer->stop();
+    requestAccessToken();
+}
+
+void OpenSkyAuthManager::requestAccessToken()
+{
+    if (m_requestPending) {
+        return;
+    }
+    m_requestPending = true;
+
+    QNetworkRequest request(m_tokenUrl);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
+
+    QUrlQuery postData;
+    postData.addQueryItem("grant_type", "client_credentials");
+    postData.addQueryItem("client_id", m_clientId);
+    postData.addQueryItem("client_secret", m_clientSecret);
+
+    QNetworkReply *reply = m_networkManager->post(request, postData.toString(QUrl::FullyEncoded).toUtf8());
+    if (TraceRecorder::isEnabled()) {
+        const quint64 traceId = TraceRecorder::nextId();
+        reply->setProperty("traceId", traceId);
+        TraceRecorder::instance().asyncBegin("auth", "network", traceId);
+    }
+    connect(reply, &QNetworkReply::finished, this, &OpenSkyAuthManager::onAuthenticationReply);
+}
+
+void OpenSkyAuthManager::onAuthenticationReply()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) {
+        return;
+    }
+
+    reply->deleteLater();
+    m_requestPending = false;
+
+    if (TraceRecorder::isEnabled() && reply->property("traceId").isValid()) {
+        TraceRecorder::instance().asyncEnd("auth", "network", reply->property("traceId").toULongLong());
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        QString error = QString("Authentication failed: %1").arg(reply->errorString());
+        qDebug() << error;
+        if (m_accessToken.isEmpty()) {
+            emit authenticationFailed(error);
+        } else {
+            retryRefresh(error);
+        }
+        return;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+    QJsonObject obj = doc.object();
+
+    if (obj.contains("access_token")) {
+        const bool firstToken = m_accessToken.isEmpty();
+        m_accessToken = obj["access_token"].toString();
+        m_retryDelayMs = 0;
+        scheduleRefresh(obj["expires_in"].toInt());
+
+        emit accessTokenChanged(m_accessToken);
+        if (firstToken) {
+            qDebug() << "Authentication successful!";
+            emit authenticationSuccess();
+        }
+    } else {
+        QString error = "No access token in response";
+        if (obj.contains("error")) {
+            error = obj["error"].toString();
+            if (obj.contains("error_description")) {
+                error += ": " + obj["error_description"].toString();
+            }
+        }
+        qDebug() << "Authentication failed:" << error;
+        if (m_accessToken.isEmpty()) {
+            emit authenticationFailed(error);
+        } else {
+            retryRefresh(error);
+        }
+    }
+}
+
+void OpenSkyAuthManager::scheduleRefresh(int expiresInSecs)
+{
+    // Without expires_in the token is only replaced when the API rejects it
+    if (expiresInSecs <= 0) {
+        m_tokenExpiry = QDateTime();
+        return;
+    }
+
+    m_tokenExpiry = QDateTime::currentDateTimeUtc().addSecs(expiresInSecs);
+    const int refreshInSecs = qMax(expiresInSecs / 2, expiresInSecs - RefreshMarginSecs);
+    m_refreshTimer->start(refreshInSecs * 1000);
+    qDebug() << "Access token valid for" << expiresInSecs << "s, refreshing in" << refreshInSecs << "s";
+}
+
+void OpenSkyAuthManager::retryRefresh(const QString& error)
+{
+    // Keep the current token while it lasts and back off until the token server answers again
+    m_retryDelayMs = qBound(MinRetryDelayMs, m_retryDelayMs * 2, MaxRetryDelayMs);
+    qWarning() << "Token refresh failed:" << error << "- retrying in" << m_retryDelayMs / 1000 << "s";
+    m_refreshTimer->start(m_retryDelayMs);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef OPENSKYAUTHMANAGER_H
+#define OPENSKYAUTHMANAGER_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QDateTime>
+#include <QTimer>
+#include <QUrl>
+
+// OAuth2 client credentials for OpenSky. The token is refreshed in the background before
+// expires_in runs out, and refreshToken() can be called whenever the API rejects it;
+// only one token request is ever in flight.
+class OpenSkyAuthManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OpenSkyAuthManager(QObject *parent = nullptr);
+
+    static QUrl defaultTokenUrl();
+
+    void setCredentials(const QString& clientId, const QString& clientSecret);
+    void setTokenUrl(const QUrl& url) { m_tokenUrl = url; }
+    QUrl tokenUrl() const { return m_tokenUrl; }
+    void authenticate();
+    void refreshToken();
+    
+    bool isAuthenticated() const { return !m_accessToken.isEmpty(); }
+    bool isRefreshing() const { return m_requestPending; }
+    QString accessToken() const { return m_accessToken; }
+    QDateTime tokenExpiry() const { return m_tokenExpiry; }
+
+signals:
+    // The first token; later ones only emit accessTokenChanged
+    void authenticationSuccess();
+    void authenticationFailed(const QString& error);
+    void accessTokenChanged(const QString& token);
+
+private slots:
+    void onAuthenticationReply();
+
+private:
+    void requestAccessToken();
+    void scheduleRefresh(int expiresInSecs);
+    void retryRefresh(const QString& error);
+
+    QNetworkAccessManager* m_networkManager;
+    QTimer* m_refreshTimer;
+    QUrl m_tokenUrl;
+    QString m_clientId;
+    QString m_clientSecret;
+    QString m_accessToken;
+    QDateTime m_tokenExpiry;
+    bool m_requestPending = false;
+    int m_retryDelayMs = 0;
+};
+
+#endif // OPENSKYAUTHMANAGER_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "PipelineStats.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+RollingStats::RollingStats(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+    m_samples.reserve(m_capacity);
+}
+
+void RollingStats::add(double value)
+{
+    m_last = value;
+    if (m_samples.size() < m_capacity) {
+        m_samples.append(value);
+    } else {
+        m_samples[m_next] = value;
+    }
+    m_next = (m_next + 1) % m_capacity;
+}
+
+void RollingStats::clear()
+{
+    m_samples.clear();
+    m_next = 0;
+    m_last = 0.0;
+}
+
+double RollingStats::min() const
+{
+    return m_samples.isEmpty() ? 0.0 : *std::min_element(m_samples.cbegin(), m_samples.cend());
+}
+
+double RollingStats::max() const
+{
+    return m_samples.isEmpty() ? 0.0 : *std::max_element(m_samples.cbegin(), m_samples.cend());
+}
+
+double RollingStats::mean() const
+{
+    if (m_samples.isEmpty()) {
+        return 0.0;
+    }
+    return std::accumulate(m_samples.cbegin(), m_samples.cend(), 0.0) / m_samples.size();
+}
+
+double RollingStats::percentile(double fraction) const
+{
+    if (m_samples.isEmpty()) {
+        return 0.0;
+    }
+
+    // Nearest rank
+    QList<double> sorted = m_samples;
+    const qsizetype rank = qBound<qsizetype>(0, qsizetype(std::ceil(fraction * sorted.size())) - 1, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+QVariantMap RollingStats::toVariantMap() const
+{
+    return {
+        {"last", m_last},
+        {"min", min()},
+        {"avg", mean()},
+        {"p95", percentile(0.95)},
+        {"max", max()},
+        {"count", count()}
+    };
+}
+
+QString PipelineStats::stageName(Stage stage)
+{
+    switch (stage) {
+    case Fetch: return "Fetch";
+    case Decode: return "Decode";
+    case Prepare: return "Prepare";
+    case RenderDelay: return "Render delay";
+    case Graphics: return "Graphics";
+    case Filter: return "Filter";
+    case Density: return "Density";
+    case Conflicts: return "Conflicts";
+    case Refresh: return "Refresh";
+    case StageCount: break;
+    }
+    return QString();
+}
+
+void PipelineStats::clear()
+{
+    for (RollingStats& stats : m_stages) {
+        stats.clear();
+    }
+}
+
+QVariantList PipelineStats::toVariantList() const
+{
+    QVariantList stages;
+    for (int stage = 0; stage < StageCount; ++stage) {
+        QVariantMap stats = m_stages[stage].toVariantMap();
+        stats["name"] = stageName(Stage(stage));
+        stages.append(stats);
+    }
+    return stages;
+}
\ No newline at end of file
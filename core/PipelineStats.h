@@ -0,0 +1,65 @@
+#ifndef PIPELINESTATS_H
+#define PIPELINESTATS_H
+
+#include <QList>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+
+// Min/avg/p95/max over the most recent samples
+class RollingStats
+{
+public:
+    explicit RollingStats(int capacity = 120);
+
+    void add(double value);
+    void clear();
+
+    int count() const { return int(m_samples.size()); }
+    double last() const { return m_last; }
+    double min() const;
+    double max() const;
+    double mean() const;
+    double percentile(double fraction) const;
+
+    // {last, min, avg, p95, max, count} for QML
+    QVariantMap toVariantMap() const;
+
+private:
+    QList<double> m_samples;
+    int m_capacity;
+    int m_next = 0;
+    double m_last = 0.0;
+};
+
+// Rolling per-stage durations (ms) of the refresh pipeline
+class PipelineStats
+{
+public:
+    enum Stage {
+        Fetch,          // request sent until the reply arrives (source time for local sources)
+        Decode,         // JSON to FlightData
+        Prepare,        // onFlightDataReceived bookkeeping
+        RenderDelay,    // wait before graphics are rebuilt
+        Graphics,       // updateFlightGraphics
+        Filter,         // applyFilters
+        Density,        // density grid and image, while zoomed out
+        Conflicts,      // proximity detection and drawing
+        Refresh,        // fetch start until filters are applied
+        StageCount
+    };
+
+    static QString stageName(Stage stage);
+
+    void record(Stage stage, double milliseconds) { m_stages[stage].add(milliseconds); }
+    const RollingStats& stage(Stage stage) const { return m_stages[stage]; }
+    void clear();
+
+    // One map per stage with a "name" key added, in pipeline order
+    QVariantList toVariantList() const;
+
+private:
+    RollingStats m_stages[StageCount];
+};
+
+#endif // PIPELINESTATS_H
\ No newline at end of file
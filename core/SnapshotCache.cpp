@@ -0,0 +1,81 @@
+#include "SnapshotCache.h"
+#include "SnapshotCodec.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+constexpr quint32 CacheMagic = 0x46545343; // "FTSC"
+constexpr quint16 CacheVersion = 1;
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_5;
+}
+
+QString SnapshotCache::defaultPath()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("last-snapshot.ftsc");
+}
+
+bool SnapshotCache::save(const QString& path, const Contents& contents, QString* error)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = QString("Cannot write snapshot cache %1: %2").arg(path, file.errorString());
+        }
+        return false;
+    }
+
+    SnapshotEncoder encoder;
+    QDataStream out(&file);
+    out.setVersion(StreamVersion);
+    out << CacheMagic << CacheVersion << contents.snapshot.timestamp << contents.countriesByContinent
+        << encoder.encodeKeyframe(contents.snapshot.flights);
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        if (error) {
+            *error = QString("Cannot write snapshot cache %1: %2").arg(path, file.errorString());
+        }
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotCache::load(const QString& path, Contents& contents)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(StreamVersion);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != CacheMagic || version != CacheVersion) {
+        return false;
+    }
+
+    Contents loaded;
+    QByteArray keyframe;
+    in >> loaded.snapshot.timestamp >> loaded.countriesByContinent >> keyframe;
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    SnapshotDecoder decoder;
+    FlightSnapshotDelta delta;
+    if (!decoder.decode(keyframe, delta)) {
+        return false;
+    }
+
+    loaded.snapshot.flights = delta.upserted;
+    contents = loaded;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef SNAPSHOTCACHE_H
+#define SNAPSHOTCACHE_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include "FlightSnapshot.h"
+
+// The last live snapshot and its country list, kept on disk so the next launch can draw
+// something before authentication and the first download finish. Flights are stored as one
+// SnapshotEncoder keyframe, and the file is replaced atomically so a crash mid-save keeps
+// the previous copy.
+class SnapshotCache
+{
+public:
+    struct Contents
+    {
+        FlightSnapshot snapshot;
+        QMap<QString, QStringList> countriesByContinent;
+    };
+
+    // <cache location>/last-snapshot.ftsc
+    static QString defaultPath();
+
+    static bool save(const QString& path, const Contents& contents, QString* error = nullptr);
+    static bool load(const QString& path, Contents& contents);
+};
+
+#endif // SNAPSHOTCACHE_H
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include "SnapshotCodec.h"
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr double FieldScale[QuantizedFlight::FieldCount] = {
+    1e5,    // Longitude: 1e-5 deg (~1 m)
+    1e5,    // Latitude
+    10.0,   // Altitude: 0.1 m
+    100.0,  // Velocity: 0.01 m/s
+    100.0,  // Heading: 0.01 deg
+    100.0   // VerticalRate: 0.01 m/s
+};
+
+// Missing values (NaN) round-trip through a reserved quantum
+constexpr qint64 MissingValue = std::numeric_limits<qint64>::min();
+
+enum MaskBit : quint32 {
+    CallsignBit = 1u << 0,
+    CountryBit = 1u << 1,
+    SquawkBit = 1u << 2,
+    FirstValueBit = 3,                                  // one bit per QuantizedFlight::Field
+    OnGroundBit = 1u << (FirstValueBit + QuantizedFlight::FieldCount)
+};
+
+void writeVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+bool readVarint(const char*& pos, const char* end, quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        const quint8 byte = quint8(*pos++);
+        value |= quint64(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+qint64 quantize(double value, double scale)
+{
+    return std::isfinite(value) ? qint64(std::llround(value * scale)) : MissingValue;
+}
+
+double dequantize(qint64 value, double scale)
+{
+    return value == MissingValue ? std::nan("") : double(value) / scale;
+}
+
+// Differences wrap modulo 2^64 so the missing-value quantum never overflows
+qint64 difference(qint64 next, qint64 previous)
+{
+    return qint64(quint64(next) - quint64(previous));
+}
+
+qint64 accumulate(qint64 previous, qint64 delta)
+{
+    return qint64(quint64(previous) + quint64(delta));
+}
+}
+
+QuantizedFlight QuantizedFlight::fromFlight(const FlightData& flight)
+{
+    QuantizedFlight quantized;
+    quantized.callsign = flight.callsign();
+    quantized.country = flight.country();
+    quantized.squawk = flight.squawk();
+    quantized.values[Longitude] = quantize(flight.longitude(), FieldScale[Longitude]);
+    quantized.values[Latitude] = quantize(flight.latitude(), FieldScale[Latitude]);
+    quantized.values[Altitude] = quantize(flight.altitude(), FieldScale[Altitude]);
+    quantized.values[Velocity] = quantize(flight.velocity(), FieldScale[Velocity]);
+    quantized.values[Heading] = quantize(flight.heading(), FieldScale[Heading]);
+    quantized.values[VerticalRate] = quantize(flight.verticalRate(), FieldScale[VerticalRate]);
+    quantized.onGround = flight.onGround();
+    return quantized;
+}
+
+FlightData QuantizedFlight::toFlight(const QString& icao24) const
+{
+    return FlightData(icao24, callsign, country,
+                      dequantize(values[Longitude], FieldScale[Longitude]),
+                      dequantize(values[Latitude], FieldScale[Latitude]),
+                      dequantize(values[Altitude], FieldScale[Altitude]),
+                      dequantize(values[Velocity], FieldScale[Velocity]),
+                      dequantize(values[Heading], FieldScale[Heading]),
+                      dequantize(values[VerticalRate], FieldScale[VerticalRate]),
+                      onGround, squawk);
+}
+
+// SnapshotEncoder
+
+void SnapshotEncoder::reset()
+{
+    m_dictionary.clear();
+    m_state.clear();
+}
+
+void SnapshotEncoder::writeString(QByteArray& out, const QString& value)
+{
+    // 0 introduces a new dictionary entry, otherwise id + 1
+    auto it = m_dictionary.constFind(value);
+    if (it != m_dictionary.constEnd()) {
+        writeVarint(out, quint64(*it) + 1);
+        return;
+    }
+
+    const QByteArray utf8 = value.toUtf8();
+    writeVarint(out, 0);
+    writeVarint(out, quint64(utf8.size()));
+    out.append(utf8);
+    m_dictionary.insert(value, quint32(m_dictionary.size()));
+}
+
+QByteArray SnapshotEncoder::encodeKeyframe(const QList<FlightData>& flights)
+{
+    reset();
+    return encodeDelta(flights);
+}
+
+QByteArray SnapshotEncoder::encodeDelta(const QList<FlightData>& flights)
+{
+    static const QuantizedFlight empty;
+
+    QByteArray records;
+    records.reserve(flights.size() * 8);
+    quint64 recordCount = 0;
+
+    QSet<QString> seen;
+    seen.reserve(flights.size());
+
+    for (const FlightData& flight : flights) {
+        seen.insert(flight.icao24());
+
+        const QuantizedFlight next = QuantizedFlight::fromFlight(flight);
+        auto previousIt = m_state.constFind(flight.icao24());
+        const bool isNew = previousIt == m_state.constEnd();
+        const QuantizedFlight& previous = isNew ? empty : *previousIt;
+
+        quint32 mask = next.onGround ? OnGroundBit : 0;
+        if (next.callsign != previous.callsign) mask |= CallsignBit;
+        if (next.country != previous.country) mask |= CountryBit;
+        if (next.squawk != previous.squawk) mask |= SquawkBit;
+        for (int field = 0; field < QuantizedFlight::FieldCount; ++field) {
+            if (next.values[field] != previous.values[field]) {
+                mask |= 1u << (FirstValueBit + field);
+            }
+        }
+
+        // Aircraft that only moved within a quantum are left out of the delta
+        if (!isNew && mask == (previous.onGround ? quint32(OnGroundBit) : 0u)) {
+            continue;
+        }
+
+        writeString(records, flight.icao24());
+        writeVarint(records, mask);
+        if (mask & CallsignBit) writeString(records, next.callsign);
+        if (mask & CountryBit) writeString(records, next.country);
+        if (mask & SquawkBit) writeString(records, next.squawk);
+        for (int field = 0; field < QuantizedFlight::FieldCount; ++field) {
+            if (mask & (1u << (FirstValueBit + field))) {
+                writeVarint(records, zigzag(difference(next.values[field], previous.values[field])));
+            }
+        }
+
+        m_state.insert(flight.icao24(), next);
+        ++recordCount;
+    }
+
+    QStringList removed;
+    for (auto it = m_state.cbegin(); it != m_state.cend(); ++it) {
+        if (!seen.contains(it.key())) {
+            removed.append(it.key());
+        }
+    }
+    // Hash order is per-process, sort so identical input always encodes identically
+    std::sort(removed.begin(), removed.end());
+
+    QByteArray frame;
+    frame.reserve(records.size() + 16 + removed.size() * 2);
+    writeVarint(frame, recordCount);
+    frame.append(records);
+    writeVarint(frame, quint64(removed.size()));
+    for (const QString& icao24 : removed) {
+        writeString(frame, icao24);
+        m_state.remove(icao24);
+    }
+
+    return frame;
+}
+
+// SnapshotDecoder
+
+void SnapshotDecoder::reset()
+{
+    m_dictionary.clear();
+    m_state.clear();
+}
+
+bool SnapshotDecoder::readString(const char*& pos, const char* end, QString& value)
+{
+    quint64 ref = 0;
+    if (!readVarint(pos, end, ref)) {
+        return false;
+    }
+
+    if (ref > 0) {
+        if (ref > quint64(m_dictionary.size())) {
+            return false;
+        }
+        value = m_dictionary.at(qsizetype(ref - 1));
+        return true;
+    }
+
+    quint64 length = 0;
+    if (!readVarint(pos, end, length) || length > quint64(end - pos)) {
+        return false;
+    }
+
+    value = QString::fromUtf8(pos, qsizetype(length));
+    pos += length;
+    m_dictionary.append(value);
+    return true;
+}
+
+bool SnapshotDecoder::decode(const QByteArray& frame, FlightSnapshotDelta& delta)
+{
+    const char* pos = frame.constData();
+    const char* end = pos + frame.size();
+
+    quint64 recordCount = 0;
+    if (!readVarint(pos, end, recordCount)) {
+        return false;
+    }
+
+    delta.upserted.clear();
+    delta.removed.clear();
+    delta.upserted.reserve(qsizetype(qMin<quint64>(recordCount, quint64(frame.size()))));
+
+    for (quint64 i = 0; i < recordCount; ++i) {
+        QString icao24;
+        quint64 mask = 0;
+        if (!readString(pos, end, icao24) || !readVarint(pos, end, mask)) {
+            return false;
+        }
+
+        QuantizedFlight& flight = m_state[icao24];
+        flight.onGround = mask & OnGroundBit;
+        if ((mask & CallsignBit) && !readString(pos, end, flight.callsign)) return false;
+        if ((mask & CountryBit) && !readString(pos, end, flight.country)) return false;
+        if ((mask & SquawkBit) && !readString(pos, end, flight.squawk)) return false;
+
+        for (int field = 0; field < QuantizedFlight::FieldCount; ++field) {
+            if (mask & (1u << (FirstValueBit + field))) {
+                quint64 encoded = 0;
+                if (!readVarint(pos, end, encoded)) {
+                    return false;
+                }
+                flight.values[field] = accumulate(flight.values[field], unzigzag(encoded));
+            }
+        }
+
+        delta.upserted.append(flight.toFlight(icao24));
+    }
+
+    quint64 removedCount = 0;
+    if (!readVarint(pos, end, removedCount)) {
+        return false;
+    }
+
+    for (quint64 i = 0; i < removedCount; ++i) {
+        QString icao24;
+        if (!readString(pos, end, icao24)) {
+            return false;
+        }
+        m_state.remove(icao24);
+        delta.removed.append(icao24);
+    }
+
+    return pos == end;
+}
\ No newline at end of file
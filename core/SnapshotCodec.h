@@ -0,0 +1,78 @@
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include "FlightSnapshot.h"
+
+// Compact encoding for archive frames.
+//
+// Numeric fields are quantized (1e-5 deg position, 0.1 m altitude, 0.01 for velocity, heading and
+// vertical rate) and written as zigzag varint differences from the aircraft's previous record.
+// Strings are replaced by ids into a dictionary that is rebuilt from each keyframe, with new
+// strings written inline on first use. A keyframe is a delta against an empty state, so decoding
+// from any keyframe forward is self-contained.
+//
+// Frame layout:
+//   varint recordCount, records..., varint removedCount, removed icao24 refs...
+// Record layout:
+//   icao24 ref, varint fieldMask, [string refs], [zigzag varint deltas]
+
+struct QuantizedFlight
+{
+    enum Field {
+        Longitude,
+        Latitude,
+        Altitude,
+        Velocity,
+        Heading,
+        VerticalRate,
+        FieldCount
+    };
+
+    QString callsign;
+    QString country;
+    QString squawk;
+    qint64 values[FieldCount] = {};
+    bool onGround = false;
+
+    static QuantizedFlight fromFlight(const FlightData& flight);
+    FlightData toFlight(const QString& icao24) const;
+};
+
+class SnapshotEncoder
+{
+public:
+    // Starts a new self-contained frame sequence and encodes all flights
+    QByteArray encodeKeyframe(const QList<FlightData>& flights);
+
+    // Encodes only the aircraft that changed, appeared or disappeared since the previous frame
+    QByteArray encodeDelta(const QList<FlightData>& flights);
+
+    void reset();
+
+private:
+    void writeString(QByteArray& out, const QString& value);
+
+    QHash<QString, quint32> m_dictionary;
+    QHash<QString, QuantizedFlight> m_state;
+};
+
+class SnapshotDecoder
+{
+public:
+    // Decodes a frame into the aircraft it upserts and removes. Call reset() before a keyframe.
+    bool decode(const QByteArray& frame, FlightSnapshotDelta& delta);
+
+    void reset();
+
+private:
+    bool readString(const char*& pos, const char* end, QString& value);
+
+    QList<QString> m_dictionary;
+    QHash<QString, QuantizedFlight> m_state;
+};
+
+#endif // SNAPSHOTCODEC_H
\ No newline at end of file
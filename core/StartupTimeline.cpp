@@ -0,0 +1,74 @@
+#include "StartupTimeline.h"
+#include <QVariantMap>
+#include <QDebug>
+#include <cstring>
+
+StartupTimeline& StartupTimeline::instance()
+{
+    static StartupTimeline timeline;
+    return timeline;
+}
+
+void StartupTimeline::start()
+{
+    if (!m_clock.isValid()) {
+        m_clock.start();
+        m_marks.append({"process start", 0.0});
+    }
+}
+
+void StartupTimeline::mark(const char* name)
+{
+    start();
+    if (msAt(name) < 0.0) {
+        m_marks.append({name, m_clock.nsecsElapsed() / 1e6});
+    }
+}
+
+double StartupTimeline::msAt(const char* name) const
+{
+    for (const Mark& mark : m_marks) {
+        if (std::strcmp(mark.name, name) == 0) {
+            return mark.ms;
+        }
+    }
+    return -1.0;
+}
+
+QVariantList StartupTimeline::toVariantList() const
+{
+    QVariantList list;
+    for (const Mark& mark : m_marks) {
+        list.append(QVariantMap{{"name", QString::fromLatin1(mark.name)}, {"ms", mark.ms}});
+    }
+    return list;
+}
+
+void StartupTimeline::finish(const char* from, double budgetMs)
+{
+    if (m_finished || m_marks.isEmpty()) {
+        return;
+    }
+    m_finished = true;
+
+    qInfo() << "Startup timeline:";
+    double previous = 0.0;
+    for (const Mark& mark : std::as_const(m_marks)) {
+        qInfo().noquote() << QString("  %1 ms  (+%2)  %3")
+                                 .arg(mark.ms, 8, 'f', 1).arg(mark.ms - previous, 7, 'f', 1)
+                                 .arg(QString::fromLatin1(mark.name));
+        previous = mark.ms;
+    }
+
+    const double begin = qMax(0.0, msAt(from));
+    const double span = m_marks.last().ms - begin;
+    if (span > budgetMs) {
+        qWarning().noquote() << QString("Startup: %1 took %2 ms from %3, over the %4 ms budget")
+                                    .arg(QString::fromLatin1(m_marks.last().name)).arg(span, 0, 'f', 0)
+                                    .arg(QString::fromLatin1(from)).arg(budgetMs, 0, 'f', 0);
+    } else {
+        qInfo().noquote() << QString("Startup: %1 after %2 ms from %3, within the %4 ms budget")
+                                 .arg(QString::fromLatin1(m_marks.last().name)).arg(span, 0, 'f', 0)
+                                 .arg(QString::fromLatin1(from)).arg(budgetMs, 0, 'f', 0);
+    }
+}
\ No newline at end of file
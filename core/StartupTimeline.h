@@ -0,0 +1,42 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QVariantList>
+
+// Milestones from process start to the first drawn map, in ms since start().
+// Main thread only; names must be string literals. Only the first mark of each name counts.
+class StartupTimeline
+{
+public:
+    struct Mark
+    {
+        const char* name;
+        double ms;
+    };
+
+    static StartupTimeline& instance();
+
+    // Call first thing in main(); mark() starts the clock itself otherwise
+    void start();
+    void mark(const char* name);
+
+    // ms at which name was marked, or -1
+    double msAt(const char* name) const;
+    QList<Mark> marks() const { return m_marks; }
+    QVariantList toVariantList() const;
+
+    // Logs the timeline once, and whether the time from `from` to the last mark fits the budget
+    void finish(const char* from, double budgetMs);
+    bool isFinished() const { return m_finished; }
+
+private:
+    StartupTimeline() = default;
+
+    QElapsedTimer m_clock;
+    QList<Mark> m_marks;
+    bool m_finished = false;
+};
+
+#endif // STARTUPTIMELINE_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "SyntheticFlightDataSource.h"
+#include "TraceRecorder.h"
+#include <QJsonDocument>
+#include <QTimer>
+#include <QDebug>
+
+SyntheticFlightDataSource::SyntheticFlightDataSource(const TrafficGenerator::Options& options, QObject *parent)
+    : FlightDataSource(parent)
+    , m_generator(options)
+{
+    qDebug() << "Synthetic data source:" << m_generator.aircraftCount() << "aircraft, seed" << options.seed;
+}
+
+void SyntheticFlightDataSource::fetchFlightData()
+{
+    TraceScope trace("fetch states", "source");
+    QElapsedTimer timer;
+    timer.start();
+
+    // The first fetch returns the initial state
+    if (m_sinceFetch.isValid()) {
+        const double elapsed = m_sinceFetch.elapsed() / 1000.0;
+        m_generator.advance(m_stepSeconds > 0.0 ? m_stepSeconds : elapsed);
+    }
+    m_sinceFetch.start();
+
+    // Simulation counts as fetch time, JSON decoding (when enabled) as decode time
+    QList<FlightData> flights;
+    if (m_encodeJson) {
+        const QByteArray json = m_generator.statesJson();
+        m_lastFetchTiming.fetchMs = timer.nsecsElapsed() / 1e6;
+        timer.restart();
+        flights = decodeStates(json);
+        m_lastFetchTiming.decodeMs = timer.nsecsElapsed() / 1e6;
+    } else {
+        flights = m_generator.flights();
+        m_lastFetchTiming.fetchMs = timer.nsecsElapsed() / 1e6;
+        m_lastFetchTiming.decodeMs = 0.0;
+    }
+
+    // Delivered asynchronously like a network reply
+    QTimer::singleShot(0, this, [this, flights = std::move(flights)]() {
+        emit flightDataReceived(flights);
+    });
+}
+
+void SyntheticFlightDataSource::fetchFlightTrack(const QString& icao24)
+{
+    TraceScope trace("fetch track", "track", icao24);
+    const QByteArray track = m_generator.trackJson(icao24);
+
+    QTimer::singleShot(0, this, [this, icao24, track]() {
+        if (track.isEmpty()) {
+            emit dataFetchFailed(QString("No track for %1").arg(icao24));
+            return;
+        }
+        emit trackDataReceived(icao24, QJsonDocument::fromJson(track).object());
+    });
+}
\ No newline at end of file
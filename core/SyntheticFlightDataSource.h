@@ -0,0 +1,34 @@
+#ifndef SYNTHETICFLIGHTDATASOURCE_H
+#define SYNTHETICFLIGHTDATASOURCE_H
+
+#include <QElapsedTimer>
+#include "FlightDataSource.h"
+#include "TrafficGenerator.h"
+
+// Serves generated traffic for scale testing, no network or credentials needed.
+// Each fetch advances the simulation by a fixed step, or by the wall-clock time since the
+// previous fetch when the step is 0.
+class SyntheticFlightDataSource : public FlightDataSource
+{
+    Q_OBJECT
+
+public:
+    explicit SyntheticFlightDataSource(const TrafficGenerator::Options& options, QObject *parent = nullptr);
+
+    bool requiresAuthentication() const override { return false; }
+    void fetchFlightData() override;
+    void fetchFlightTrack(const QString& icao24) override;
+
+    void setStepSeconds(double seconds) { m_stepSeconds = qMax(0.0, seconds); }
+
+    // Round-trip snapshots through /states/all JSON so decoding cost is part of the measurement
+    void setEncodeJson(bool encode) { m_encodeJson = encode; }
+
+private:
+    TrafficGenerator m_generator;
+    QElapsedTimer m_sinceFetch;
+    double m_stepSeconds = 0.0;
+    bool m_encodeJson = false;
+};
+
+#endif // SYNTHETICFLIGHTDATASOURCE_H
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "TraceRecorder.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+
+std::atomic<bool> TraceRecorder::s_enabled{false};
+
+TraceRecorder& TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+quint64 TraceRecorder::nextId()
+{
+    static std::atomic<quint64> id{0};
+    return ++id;
+}
+
+bool TraceRecorder::start(const QString& path, qsizetype maxEvents)
+{
+    QMutexLocker locker(&m_mutex);
+    if (isEnabled()) {
+        return true;
+    }
+
+    // Fail now rather than after a long session
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_errorString = QString("Could not open trace file %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    m_path = path;
+    m_errorString.clear();
+    m_maxEvents = qMax<qsizetype>(1, maxEvents);
+    m_dropped = 0;
+    m_events.clear();
+    m_events.reserve(qMin<qsizetype>(m_maxEvents, 65536));
+    m_threadIndex.clear();
+    m_threadNames.clear();
+    m_clock.start();
+
+    static bool quitHooked = false;
+    if (!quitHooked && QCoreApplication::instance()) {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, []() {
+            TraceRecorder::instance().stop();
+        });
+        quitHooked = true;
+    }
+
+    s_enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool TraceRecorder::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!isEnabled()) {
+        return true;
+    }
+    s_enabled.store(false, std::memory_order_relaxed);
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_errorString = QString("Could not write trace file %1: %2").arg(m_path, file.errorString());
+        qWarning() << m_errorString;
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    auto writeEvent = [&file](const QJsonObject& event, bool first) {
+        if (!first) {
+            file.write(",\n");
+        }
+        file.write(QJsonDocument(event).toJson(QJsonDocument::Compact));
+    };
+
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool first = true;
+    for (int thread = 0; thread < m_threadNames.size(); ++thread) {
+        writeEvent({
+            {"name", "thread_name"},
+            {"ph", "M"},
+            {"pid", pid},
+            {"tid", thread},
+            {"args", QJsonObject{{"name", m_threadNames.at(thread)}}}
+        }, first);
+        first = false;
+    }
+
+    for (const Event& event : std::as_const(m_events)) {
+        QJsonObject object{
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", QString(QChar(event.phase))},
+            {"ts", event.timestamp / 1000.0},
+            {"pid", pid},
+            {"tid", event.thread}
+        };
+        if (event.phase == 'X') {
+            object["dur"] = event.duration / 1000.0;
+        } else {
+            object["id"] = QString::number(event.id, 16).prepend("0x");
+        }
+        if (!event.detail.isEmpty()) {
+            object["args"] = QJsonObject{{"detail", event.detail}};
+        }
+        writeEvent(object, first);
+        first = false;
+    }
+
+    file.write("\n]}\n");
+    file.close();
+
+    qDebug() << "Wrote" << m_events.size() << "trace events to" << m_path;
+    if (m_dropped > 0) {
+        qWarning() << "Trace buffer was full," << m_dropped << "events dropped";
+    }
+
+    m_events.clear();
+    m_events.squeeze();
+    return true;
+}
+
+void TraceRecorder::complete(const char* name, const char* category, qint64 startNs, const QString& detail)
+{
+    const qint64 end = now();
+    append({name, category, 'X', startNs, end - startNs, 0, 0, detail});
+}
+
+void TraceRecorder::asyncBegin(const char* name, const char* category, quint64 id, const QString& detail)
+{
+    append({name, category, 'b', now(), 0, id, 0, detail});
+}
+
+void TraceRecorder::asyncEnd(const char* name, const char* category, quint64 id, const QString& detail)
+{
+    append({name, category, 'e', now(), 0, id, 0, detail});
+}
+
+void TraceRecorder::append(Event event)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!isEnabled()) {
+        return;
+    }
+
+    if (m_events.size() >= m_maxEvents) {
+        ++m_dropped;
+        return;
+    }
+
+    event.thread = currentThreadIndex();
+    m_events.append(std::move(event));
+}
+
+int TraceRecorder::currentThreadIndex()
+{
+    const Qt::HANDLE handle = QThread::currentThreadId();
+    auto it = m_threadIndex.constFind(handle);
+    if (it != m_threadIndex.constEnd()) {
+        return *it;
+    }
+
+    // Name threads so the render thread is easy to tell from the GUI thread
+    QThread* thread = QThread::currentThread();
+    QString name = thread->objectName();
+    if (name.isEmpty()) {
+        name = QThread::isMainThread() ? QString("main") : QString::fromLatin1(thread->metaObject()->className());
+    }
+
+    const int index = int(m_threadNames.size());
+    m_threadNames.append(name);
+    m_threadIndex.insert(handle, index);
+    return index;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+// Opt-in timeline of the refresh pipeline written as Chrome trace JSON (open in Perfetto or
+// chrome://tracing). While disabled every hook is a single relaxed atomic load.
+//
+// Synchronous stages are complete ("X") events on the thread that ran them; network requests
+// and other work that spans the event loop are async ("b"/"e") events matched by id.
+// Names and categories must be string literals; per-event text goes in the detail argument.
+class TraceRecorder
+{
+public:
+    static TraceRecorder& instance();
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Starts collecting events; they are written to path by stop() or when the app quits
+    bool start(const QString& path, qsizetype maxEvents = 1000000);
+    bool stop();
+    QString errorString() const { return m_errorString; }
+
+    // Nanoseconds since start()
+    qint64 now() const { return m_clock.nsecsElapsed(); }
+    static quint64 nextId();
+
+    void complete(const char* name, const char* category, qint64 startNs, const QString& detail = QString());
+    void asyncBegin(const char* name, const char* category, quint64 id, const QString& detail = QString());
+    void asyncEnd(const char* name, const char* category, quint64 id, const QString& detail = QString());
+
+private:
+    struct Event
+    {
+        const char* name;
+        const char* category;
+        char phase;
+        qint64 timestamp;   // ns since start
+        qint64 duration;    // ns, complete events only
+        quint64 id;         // async events only
+        int thread;
+        QString detail;
+    };
+
+    TraceRecorder() = default;
+    void append(Event event);
+    int currentThreadIndex();   // caller holds m_mutex
+
+    static std::atomic<bool> s_enabled;
+
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QString m_path;
+    QString m_errorString;
+    qsizetype m_maxEvents = 0;
+    qsizetype m_dropped = 0;
+    QList<Event> m_events;
+    QHash<Qt::HANDLE, int> m_threadIndex;
+    QList<QString> m_threadNames;
+};
+
+// Records a complete event for the enclosing scope when tracing is enabled
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category, const QString& detail = QString())
+        : m_name(name)
+        , m_category(category)
+        , m_start(TraceRecorder::isEnabled() ? TraceRecorder::instance().now() : -1)
+    {
+        if (m_start >= 0) {
+            m_detail = detail;
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_start >= 0 && TraceRecorder::isEnabled()) {
+            TraceRecorder::instance().complete(m_name, m_category, m_start, m_detail);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    qint64 m_start;
+    QString m_detail;
+};
+
+#endif // TRACERECORDER_H
\ No newline at end of file
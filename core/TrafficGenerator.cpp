@@ -0,0 +1,558 @@
+#include "TrafficGenerator.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double EarthRadius = 6371000.0;
+constexpr double ClimbGradient = 0.06;      // meters of altitude per meter flown
+constexpr double DescentGradient = 0.05;    // ~3 degree approach
+constexpr double ApproachSpeed = 75.0;      // m/s at the runway
+constexpr double FeetToMeters = 0.3048;
+constexpr double TaxiRadius = 2500.0;       // taxiing aircraft stay this close to their hub
+constexpr double LaneSpacing = 5556.0;      // 3 NM between parallel airway lanes
+constexpr double TrackSampleSeconds = 60.0;
+
+struct HubSpec
+{
+    const char* code;
+    double latitude;
+    double longitude;
+    const char* country;
+    const char* airlines;
+    double weight;
+};
+
+// Country names match qml/countries.json so generated traffic filters like live data
+const HubSpec HubSpecs[] = {
+    {"ATL", 33.64, -84.43, "United States", "DAL SWA FDX", 10},
+    {"ORD", 41.98, -87.90, "United States", "UAL AAL UPS", 9},
+    {"DFW", 32.90, -97.04, "United States", "AAL SWA", 8},
+    {"DEN", 39.86, -104.67, "United States", "UAL SWA", 8},
+    {"LAX", 33.94, -118.41, "United States", "DAL UAL AAL", 8},
+    {"JFK", 40.64, -73.78, "United States", "JBU DAL AAL", 7},
+    {"SFO", 37.62, -122.38, "United States", "UAL ASA", 6},
+    {"SEA", 47.45, -122.31, "United States", "ASA DAL", 5},
+    {"MIA", 25.80, -80.29, "United States", "AAL", 5},
+    {"MEM", 35.04, -89.98, "United States", "FDX", 3},
+    {"SDF", 38.17, -85.74, "United States", "UPS", 3},
+    {"YYZ", 43.68, -79.63, "Canada", "ACA WJA", 5},
+    {"YVR", 49.19, -123.18, "Canada", "ACA WJA", 3},
+    {"MEX", 19.44, -99.07, "Mexico", "AMX VOI", 5},
+    {"BOG", 4.70, -74.15, "Colombia", "AVA", 3},
+    {"GRU", -23.43, -46.47, "Brazil", "TAM GLO AZU", 5},
+    {"SCL", -33.39, -70.79, "Chile", "LAN", 3},
+    {"EZE", -34.82, -58.54, "Argentina", "ARG", 2},
+    {"LHR", 51.47, -0.45, "United Kingdom", "BAW VIR", 8},
+    {"CDG", 49.01, 2.55, "France", "AFR", 7},
+    {"FRA", 50.03, 8.56, "Germany", "DLH", 7},
+    {"AMS", 52.31, 4.76, "Netherlands", "KLM", 6},
+    {"MAD", 40.47, -3.56, "Spain", "IBE", 5},
+    {"FCO", 41.80, 12.25, "Italy", "ITY", 4},
+    {"ZRH", 47.46, 8.55, "Switzerland", "SWR", 3},
+    {"DUB", 53.42, -6.27, "Ireland", "RYR EIN", 4},
+    {"IST", 41.26, 28.74, "Turkey", "THY", 7},
+    {"SVO", 55.97, 37.41, "Russia", "AFL", 5},
+    {"CAI", 30.12, 31.41, "Egypt", "MSR", 3},
+    {"ADD", 8.98, 38.80, "Ethiopia", "ETH", 3},
+    {"NBO", -1.32, 36.93, "Kenya", "KQA", 2},
+    {"JNB", -26.14, 28.24, "South Africa", "SAA", 3},
+    {"DXB", 25.25, 55.36, "United Arab Emirates", "UAE", 7},
+    {"DOH", 25.27, 51.61, "Qatar", "QTR", 5},
+    {"RUH", 24.96, 46.70, "Saudi Arabia", "SVA", 3},
+    {"DEL", 28.56, 77.10, "India", "AIC IGO", 6},
+    {"BOM", 19.09, 72.87, "India", "IGO AIC", 5},
+    {"PEK", 40.08, 116.58, "China", "CCA", 7},
+    {"PVG", 31.14, 121.81, "China", "CES", 7},
+    {"CAN", 23.39, 113.30, "China", "CSN", 6},
+    {"HKG", 22.31, 113.91, "Hong Kong", "CPA", 5},
+    {"TPE", 25.08, 121.23, "Taiwan", "CAL EVA", 3},
+    {"HND", 35.55, 139.78, "Japan", "JAL ANA", 7},
+    {"ICN", 37.46, 126.44, "South Korea", "KAL AAR", 5},
+    {"SIN", 1.36, 103.99, "Singapore", "SIA", 5},
+    {"KUL", 2.75, 101.71, "Malaysia", "MAS AXM", 3},
+    {"BKK", 13.69, 100.75, "Thailand", "THA", 4},
+    {"CGK", -6.13, 106.66, "Indonesia", "GIA", 4},
+    {"MNL", 14.51, 121.02, "Philippines", "PAL", 3},
+    {"SYD", -33.94, 151.18, "Australia", "QFA VOZ", 5},
+    {"AKL", -37.01, 174.79, "New Zealand", "ANZ", 2},
+};
+
+double distanceMeters(double lon1, double lat1, double lon2, double lat2)
+{
+    const double dLat = qDegreesToRadians(lat2 - lat1);
+    const double dLon = qDegreesToRadians(lon2 - lon1);
+    const double a = std::sin(dLat / 2) * std::sin(dLat / 2)
+                   + std::cos(qDegreesToRadians(lat1)) * std::cos(qDegreesToRadians(lat2))
+                     * std::sin(dLon / 2) * std::sin(dLon / 2);
+    return 2.0 * EarthRadius * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+double bearingDegrees(double lon1, double lat1, double lon2, double lat2)
+{
+    const double phi1 = qDegreesToRadians(lat1);
+    const double phi2 = qDegreesToRadians(lat2);
+    const double dLon = qDegreesToRadians(lon2 - lon1);
+    const double y = std::sin(dLon) * std::cos(phi2);
+    const double x = std::cos(phi1) * std::sin(phi2) - std::sin(phi1) * std::cos(phi2) * std::cos(dLon);
+    return std::fmod(qRadiansToDegrees(std::atan2(y, x)) + 360.0, 360.0);
+}
+
+// Point reached by travelling meters from (lon, lat) along an initial bearing
+void destinationPoint(double lon, double lat, double bearing, double meters, double& outLon, double& outLat)
+{
+    const double delta = meters / EarthRadius;
+    const double theta = qDegreesToRadians(bearing);
+    const double phi1 = qDegreesToRadians(lat);
+    const double lambda1 = qDegreesToRadians(lon);
+    const double phi2 = std::asin(std::sin(phi1) * std::cos(delta) + std::cos(phi1) * std::sin(delta) * std::cos(theta));
+    const double lambda2 = lambda1 + std::atan2(std::sin(theta) * std::sin(delta) * std::cos(phi1),
+                                                std::cos(delta) - std::sin(phi1) * std::sin(phi2));
+    outLat = qRadiansToDegrees(phi2);
+    outLon = std::remainder(qRadiansToDegrees(lambda2), 360.0);
+}
+
+// Great-circle interpolation between two points
+void interpolate(double lon1, double lat1, double lon2, double lat2, double fraction, double& outLon, double& outLat)
+{
+    const double phi1 = qDegreesToRadians(lat1);
+    const double phi2 = qDegreesToRadians(lat2);
+    const double lambda1 = qDegreesToRadians(lon1);
+    const double lambda2 = qDegreesToRadians(lon2);
+
+    const double x1 = std::cos(phi1) * std::cos(lambda1), y1 = std::cos(phi1) * std::sin(lambda1), z1 = std::sin(phi1);
+    const double x2 = std::cos(phi2) * std::cos(lambda2), y2 = std::cos(phi2) * std::sin(lambda2), z2 = std::sin(phi2);
+    const double angle = std::acos(std::clamp(x1 * x2 + y1 * y2 + z1 * z2, -1.0, 1.0));
+
+    if (angle < 1e-9) {
+        outLon = lon1;
+        outLat = lat1;
+        return;
+    }
+
+    const double a = std::sin((1.0 - fraction) * angle) / std::sin(angle);
+    const double b = std::sin(fraction * angle) / std::sin(angle);
+    const double x = a * x1 + b * x2, y = a * y1 + b * y2, z = a * z1 + b * z2;
+    outLat = qRadiansToDegrees(std::atan2(z, std::sqrt(x * x + y * y)));
+    outLon = qRadiansToDegrees(std::atan2(y, x));
+}
+
+void appendNumber(QByteArray& out, double value, int precision)
+{
+    out.append(QByteArray::number(value, 'f', precision));
+}
+}
+
+TrafficGenerator::TrafficGenerator(const Options& options)
+    : m_options(options)
+    , m_random(options.seed)
+    , m_time(options.startTime)
+{
+    m_options.aircraftCount = qMax(0, m_options.aircraftCount);
+    m_options.groundFraction = qBound(0.0, m_options.groundFraction, 0.95);
+    m_options.regionalFraction = qBound(0.0, m_options.regionalFraction, 1.0);
+
+    buildHubs();
+
+    // Size the hub dwell so arrivals keep the ground share steady:
+    // ground / total = dwell / (dwell + flight time)
+    double totalFlightSeconds = 0.0;
+    constexpr int RouteSamples = 256;
+    for (int i = 0; i < RouteSamples; ++i) {
+        Aircraft probe;
+        assignIdentity(probe, pickHub());
+        depart(probe, probe.homeHub);
+        totalFlightSeconds += probe.routeLength / probe.cruiseSpeed;
+    }
+    const double meanFlightSeconds = totalFlightSeconds / RouteSamples;
+    m_meanDwell = m_options.groundFraction / (1.0 - m_options.groundFraction) * meanFlightSeconds;
+
+    m_aircraft.resize(m_options.aircraftCount);
+    m_indexByAddress.reserve(m_options.aircraftCount);
+    for (int i = 0; i < m_aircraft.size(); ++i) {
+        spawn(m_aircraft[i], m_random.generateDouble() >= m_options.groundFraction);
+        m_indexByAddress.insert(m_aircraft[i].address, i);
+    }
+}
+
+void TrafficGenerator::buildHubs()
+{
+    double total = 0.0;
+    for (const HubSpec& spec : HubSpecs) {
+        Hub hub;
+        hub.code = QString::fromLatin1(spec.code);
+        hub.latitude = spec.latitude;
+        hub.longitude = spec.longitude;
+        hub.country = QString::fromLatin1(spec.country);
+        hub.airlines = QString::fromLatin1(spec.airlines).split(' ');
+        hub.weight = spec.weight;
+        m_hubs.append(hub);
+
+        total += spec.weight;
+        m_cumulativeHubWeight.append(total);
+    }
+}
+
+int TrafficGenerator::pickHub(int excludeHub)
+{
+    while (true) {
+        const double target = m_random.generateDouble() * m_cumulativeHubWeight.last();
+        const int hub = int(std::upper_bound(m_cumulativeHubWeight.cbegin(), m_cumulativeHubWeight.cend(), target)
+                            - m_cumulativeHubWeight.cbegin());
+        if (hub != excludeHub && hub < m_hubs.size()) {
+            return hub;
+        }
+    }
+}
+
+double TrafficGenerator::gaussian(double mean, double sigma)
+{
+    // Box-Muller, so the sequence doesn't depend on the standard library's distributions
+    const double u1 = std::max(m_random.generateDouble(), 1e-12);
+    const double u2 = m_random.generateDouble();
+    return mean + sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+quint32 TrafficGenerator::nextAddress()
+{
+    // Multiplying by an odd constant permutes 24-bit values, so addresses stay unique
+    // for the first 16M transponders while looking scattered like real ones
+    return ((++m_serial + m_options.seed * 7919u) * 0xB5AD4Bu) & 0xFFFFFFu;
+}
+
+QString TrafficGenerator::icao24At(int index) const
+{
+    return QString("%1").arg(m_aircraft.at(index).address, 6, 16, QChar('0'));
+}
+
+void TrafficGenerator::assignIdentity(Aircraft& aircraft, int hub)
+{
+    const Hub& home = m_hubs.at(hub);
+    aircraft.address = nextAddress();
+    aircraft.homeHub = hub;
+    aircraft.country = home.country;
+    // Callsign prefix is kept per aircraft, the flight number changes per leg
+    aircraft.callsign = home.airlines.at(int(m_random.bounded(int(home.airlines.size()))));
+}
+
+void TrafficGenerator::spawn(Aircraft& aircraft, bool midFlight)
+{
+    assignIdentity(aircraft, pickHub());
+
+    if (!midFlight) {
+        // Already part-way through the turnaround
+        park(aircraft, aircraft.homeHub, -m_meanDwell * std::log(std::max(m_random.generateDouble(), 1e-12)));
+        return;
+    }
+
+    depart(aircraft, aircraft.homeHub);
+    aircraft.flown = m_random.generateDouble() * aircraft.routeLength;
+    aircraft.departureTime = m_clock - aircraft.flown / aircraft.cruiseSpeed;
+    updateKinematics(aircraft);
+}
+
+void TrafficGenerator::park(Aircraft& aircraft, int hub, double dwell)
+{
+    const Hub& airport = m_hubs.at(hub);
+    aircraft.onGround = true;
+    aircraft.homeHub = hub;
+    aircraft.dwell = dwell;
+
+    // Gates and taxiways spread around the field
+    destinationPoint(airport.longitude, airport.latitude, m_random.generateDouble() * 360.0,
+                     std::abs(gaussian(0.0, 1000.0)), aircraft.groundLon, aircraft.groundLat);
+
+    const bool taxiing = m_random.generateDouble() < 0.3;
+    aircraft.groundSpeed = taxiing ? 4.0 + m_random.generateDouble() * 10.0 : 0.0;
+    aircraft.groundHeading = m_random.generateDouble() * 360.0;
+    updateKinematics(aircraft);
+}
+
+void TrafficGenerator::depart(Aircraft& aircraft, int originHub)
+{
+    // originHub -1 departs from the regional airport the aircraft just reached
+    double fromLon = aircraft.destLon;
+    double fromLat = aircraft.destLat;
+    if (originHub >= 0) {
+        fromLon = m_hubs.at(originHub).longitude;
+        fromLat = m_hubs.at(originHub).latitude;
+    }
+
+    aircraft.originLon = fromLon;
+    aircraft.originLat = fromLat;
+
+    if (originHub < 0) {
+        aircraft.destinationHub = aircraft.homeHub;
+        aircraft.destLon = m_hubs.at(aircraft.homeHub).longitude;
+        aircraft.destLat = m_hubs.at(aircraft.homeHub).latitude;
+    } else if (m_random.generateDouble() < m_options.regionalFraction) {
+        aircraft.destinationHub = -1;
+        destinationPoint(fromLon, fromLat, m_random.generateDouble() * 360.0,
+                         150000.0 + m_random.generateDouble() * 750000.0, aircraft.destLon, aircraft.destLat);
+    } else {
+        aircraft.destinationHub = pickHub(originHub);
+        aircraft.destLon = m_hubs.at(aircraft.destinationHub).longitude;
+        aircraft.destLat = m_hubs.at(aircraft.destinationHub).latitude;
+    }
+
+    aircraft.routeLength = std::max(1000.0, distanceMeters(fromLon, fromLat, aircraft.destLon, aircraft.destLat));
+    aircraft.flown = 0.0;
+    aircraft.departureTime = m_clock;
+    aircraft.onGround = false;
+
+    // Lanes cluster on the route centerline like parallel airway tracks
+    aircraft.laneOffset = (int(m_random.bounded(3)) + int(m_random.bounded(3)) - 2) * LaneSpacing;
+
+    // Semicircular rule: eastbound odd flight levels, westbound even
+    const bool eastbound = bearingDegrees(fromLon, fromLat, aircraft.destLon, aircraft.destLat) < 180.0;
+    int flightLevel = 290 + 20 * int(m_random.bounded(6)) + (eastbound ? 0 : 10);
+    // Short legs top out where climb and descent meet
+    const double ceiling = aircraft.routeLength / (1.0 / ClimbGradient + 1.0 / DescentGradient) * 0.9;
+    flightLevel = std::min(flightLevel, int(ceiling / FeetToMeters / 1000.0) * 10);
+    aircraft.cruiseAltitude = std::max(30, flightLevel) * 100.0 * FeetToMeters;
+    aircraft.cruiseSpeed = std::clamp(gaussian(232.0, 12.0), 190.0, 260.0);
+
+    aircraft.callsign = aircraft.callsign.left(3) + QString::number(1 + m_random.bounded(9999));
+    aircraft.squawk = QString("%1%2%3%4")
+                          .arg(m_random.bounded(7))   // 7xxx is left to emergencies
+                          .arg(m_random.bounded(8))
+                          .arg(m_random.bounded(8))
+                          .arg(m_random.bounded(8));
+}
+
+TrafficGenerator::Kinematics TrafficGenerator::kinematicsAt(const Aircraft& aircraft, double flown) const
+{
+    Kinematics k;
+    const double fraction = std::clamp(flown / aircraft.routeLength, 0.0, 1.0);
+    interpolate(aircraft.originLon, aircraft.originLat, aircraft.destLon, aircraft.destLat, fraction,
+                k.longitude, k.latitude);
+
+    k.heading = fraction < 1.0 ? bearingDegrees(k.longitude, k.latitude, aircraft.destLon, aircraft.destLat)
+                               : bearingDegrees(aircraft.originLon, aircraft.originLat, aircraft.destLon, aircraft.destLat);
+
+    // Lanes merge back onto the centerline near the airports
+    const double remaining = aircraft.routeLength - flown;
+    const double laneBlend = std::min(1.0, std::min(flown, remaining) / 50000.0);
+    if (aircraft.laneOffset != 0.0 && laneBlend > 0.0) {
+        destinationPoint(k.longitude, k.latitude, k.heading + 90.0, aircraft.laneOffset * laneBlend,
+                         k.longitude, k.latitude);
+    }
+
+    const double climbLimit = ClimbGradient * flown;
+    const double descentLimit = DescentGradient * remaining;
+    k.altitude = std::max(0.0, std::min({aircraft.cruiseAltitude, climbLimit, descentLimit}));
+    k.velocity = ApproachSpeed + (aircraft.cruiseSpeed - ApproachSpeed) * (k.altitude / aircraft.cruiseAltitude);
+
+    if (k.altitude >= aircraft.cruiseAltitude) {
+        k.verticalRate = 0.0;
+    } else if (climbLimit < descentLimit) {
+        k.verticalRate = ClimbGradient * k.velocity;
+    } else {
+        k.verticalRate = -DescentGradient * k.velocity;
+    }
+    return k;
+}
+
+void TrafficGenerator::updateKinematics(Aircraft& aircraft) const
+{
+    if (aircraft.onGround) {
+        aircraft.longitude = aircraft.groundLon;
+        aircraft.latitude = aircraft.groundLat;
+        aircraft.altitude = 0.0;
+        aircraft.velocity = aircraft.groundSpeed;
+        aircraft.heading = aircraft.groundHeading;
+        aircraft.verticalRate = 0.0;
+        return;
+    }
+
+    const Kinematics k = kinematicsAt(aircraft, aircraft.flown);
+    aircraft.longitude = k.longitude;
+    aircraft.latitude = k.latitude;
+    aircraft.altitude = k.altitude;
+    aircraft.velocity = k.velocity;
+    aircraft.heading = k.heading;
+    aircraft.verticalRate = k.verticalRate;
+    // Geometric altitude drifts from barometric with the weather
+    aircraft.geoOffset = 30.0 + 0.002 * k.altitude;
+}
+
+void TrafficGenerator::step(Aircraft& aircraft, double seconds)
+{
+    if (aircraft.onGround) {
+        aircraft.dwell -= seconds;
+        if (aircraft.dwell <= 0.0) {
+            depart(aircraft, aircraft.homeHub);
+        } else if (aircraft.groundSpeed > 0.0) {
+            const Hub& hub = m_hubs.at(aircraft.homeHub);
+            if (distanceMeters(aircraft.groundLon, aircraft.groundLat, hub.longitude, hub.latitude) > TaxiRadius) {
+                aircraft.groundHeading = bearingDegrees(aircraft.groundLon, aircraft.groundLat, hub.longitude, hub.latitude);
+            }
+            destinationPoint(aircraft.groundLon, aircraft.groundLat, aircraft.groundHeading,
+                             aircraft.groundSpeed * seconds, aircraft.groundLon, aircraft.groundLat);
+        }
+        updateKinematics(aircraft);
+        return;
+    }
+
+    aircraft.flown += std::max(aircraft.velocity, ApproachSpeed) * seconds;
+    if (aircraft.flown >= aircraft.routeLength) {
+        if (aircraft.destinationHub >= 0) {
+            park(aircraft, aircraft.destinationHub, -m_meanDwell * std::log(std::max(m_random.generateDouble(), 1e-12)));
+            return;
+        }
+        // Quick turnaround at a regional airport and back to the hub
+        depart(aircraft, -1);
+    }
+    updateKinematics(aircraft);
+}
+
+void TrafficGenerator::churn(double seconds)
+{
+    if (m_aircraft.isEmpty() || m_options.churnPerHour <= 0.0) {
+        return;
+    }
+
+    m_churnCarry += m_aircraft.size() * m_options.churnPerHour * seconds / 3600.0;
+    const int replacements = int(m_churnCarry);
+    m_churnCarry -= replacements;
+
+    for (int i = 0; i < replacements; ++i) {
+        const int index = int(m_random.bounded(int(m_aircraft.size())));
+        Aircraft& aircraft = m_aircraft[index];
+        m_indexByAddress.remove(aircraft.address);
+        aircraft = Aircraft();
+        spawn(aircraft, m_random.generateDouble() >= m_options.groundFraction);
+        m_indexByAddress.insert(aircraft.address, index);
+    }
+}
+
+void TrafficGenerator::advance(double seconds)
+{
+    if (seconds <= 0.0) {
+        return;
+    }
+
+    m_clock += seconds;
+    m_time = m_options.startTime + qint64(m_clock);
+
+    for (Aircraft& aircraft : m_aircraft) {
+        step(aircraft, seconds);
+    }
+    churn(seconds);
+}
+
+QList<FlightData> TrafficGenerator::flights() const
+{
+    QList<FlightData> flights;
+    flights.reserve(m_aircraft.size());
+    for (const Aircraft& aircraft : m_aircraft) {
+        flights.append(FlightData(QString("%1").arg(aircraft.address, 6, 16, QChar('0')),
+                                  aircraft.callsign, aircraft.country,
+                                  aircraft.longitude, aircraft.latitude, aircraft.altitude,
+                                  aircraft.velocity, aircraft.heading, aircraft.verticalRate,
+                                  aircraft.onGround, aircraft.squawk));
+    }
+    return flights;
+}
+
+QByteArray TrafficGenerator::statesJson() const
+{
+    const QByteArray time = QByteArray::number(m_time);
+
+    QByteArray json;
+    json.reserve(64 + m_aircraft.size() * 160);
+    json.append("{\"time\":").append(time).append(",\"states\":[");
+
+    for (qsizetype i = 0; i < m_aircraft.size(); ++i) {
+        const Aircraft& aircraft = m_aircraft.at(i);
+        if (i > 0) {
+            json.append(',');
+        }
+
+        // [icao24, callsign, origin_country, time_position, last_contact, longitude, latitude,
+        //  baro_altitude, on_ground, velocity, true_track, vertical_rate, sensors, geo_altitude,
+        //  squawk, spi, position_source]
+        json.append("[\"").append(QByteArray::number(aircraft.address, 16).rightJustified(6, '0'));
+        json.append("\",\"").append(aircraft.callsign.toLatin1().leftJustified(8, ' '));
+        json.append("\",\"").append(aircraft.country.toUtf8());
+        json.append("\",").append(time).append(',').append(time).append(',');
+        appendNumber(json, aircraft.longitude, 4);
+        json.append(',');
+        appendNumber(json, aircraft.latitude, 4);
+        json.append(',');
+        if (aircraft.onGround) {
+            json.append("null,true,");
+        } else {
+            appendNumber(json, aircraft.altitude, 2);
+            json.append(",false,");
+        }
+        appendNumber(json, aircraft.velocity, 2);
+        json.append(',');
+        appendNumber(json, aircraft.heading, 2);
+        json.append(',');
+        if (aircraft.onGround) {
+            json.append("null,null,null,\"");
+        } else {
+            appendNumber(json, aircraft.verticalRate, 2);
+            json.append(",null,");
+            appendNumber(json, aircraft.altitude + aircraft.geoOffset, 2);
+            json.append(",\"");
+        }
+        json.append(aircraft.squawk.toLatin1()).append("\",false,0]");
+    }
+
+    json.append("]}");
+    return json;
+}
+
+QByteArray TrafficGenerator::trackJson(const QString& icao24) const
+{
+    bool ok = false;
+    const quint32 address = icao24.toUInt(&ok, 16);
+    auto it = m_indexByAddress.constFind(address);
+    if (!ok || it == m_indexByAddress.constEnd()) {
+        return QByteArray();
+    }
+
+    const Aircraft& aircraft = m_aircraft.at(*it);
+    if (aircraft.onGround) {
+        return QByteArray();
+    }
+
+    // Current leg up to now, one waypoint per sample interval
+    QByteArray json;
+    json.append("{\"icao24\":\"").append(icao24.toLower().toLatin1());
+    json.append("\",\"callsign\":\"").append(aircraft.callsign.toLatin1());
+    json.append("\",\"startTime\":").append(QByteArray::number(m_options.startTime + qint64(aircraft.departureTime)));
+    json.append(",\"endTime\":").append(QByteArray::number(m_time));
+    json.append(",\"path\":[");
+
+    const double sampleDistance = aircraft.cruiseSpeed * TrackSampleSeconds;
+    for (double flown = 0.0; ; flown += sampleDistance) {
+        const bool last = flown >= aircraft.flown;
+        const double distance = last ? aircraft.flown : flown;
+        const Kinematics k = kinematicsAt(aircraft, distance);
+        const qint64 time = m_options.startTime + qint64(aircraft.departureTime + distance / aircraft.cruiseSpeed);
+
+        // [time, latitude, longitude, baro_altitude, true_track, on_ground]
+        if (flown > 0.0) {
+            json.append(',');
+        }
+        json.append('[').append(QByteArray::number(time)).append(',');
+        appendNumber(json, k.latitude, 4);
+        json.append(',');
+        appendNumber(json, k.longitude, 4);
+        json.append(',');
+        appendNumber(json, k.altitude, 0);
+        json.append(',');
+        appendNumber(json, k.heading, 0);
+        json.append(",false]");
+
+        if (last) {
+            break;
+        }
+    }
+
+    json.append("]}");
+    return json;
+}
\ No newline at end of file
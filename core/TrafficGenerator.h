@@ -0,0 +1,134 @@
+#ifndef TRAFFICGENERATOR_H
+#define TRAFFICGENERATOR_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringList>
+#include "FlightData.h"
+
+// Deterministic synthetic world traffic shaped like OpenSky /states/all data.
+//
+// Airborne aircraft fly great circles between weighted hubs (or out to regional airports and back)
+// on one of a few parallel lanes per route, with climb/cruise/descent profiles, semicircular cruise
+// levels and speeds that follow altitude. Arrivals park at their hub before departing again, which
+// keeps a ground cluster at every hub. Churn drops aircraft out of coverage and brings new
+// transponders in. The same seed and options always produce the same snapshots.
+class TrafficGenerator
+{
+public:
+    struct Options
+    {
+        quint32 seed = 1;
+        int aircraftCount = 10000;
+        double groundFraction = 0.1;    // share of aircraft parked or taxiing at hubs
+        double churnPerHour = 0.05;     // share of aircraft per hour replaced by new transponders
+        double regionalFraction = 0.4;  // share of departures to regional airports instead of hubs
+        qint64 startTime = 1735689600;  // unix seconds of the first snapshot
+    };
+
+    explicit TrafficGenerator(const Options& options);
+
+    // Moves all aircraft forward in time, landing, departing and churning as they go
+    void advance(double seconds);
+
+    qint64 currentTime() const { return m_time; }
+    int aircraftCount() const { return int(m_aircraft.size()); }
+    QString icao24At(int index) const;
+
+    QList<FlightData> flights() const;
+
+    // /states/all and /tracks/all response bodies for the current time
+    QByteArray statesJson() const;
+    QByteArray trackJson(const QString& icao24) const;
+
+private:
+    struct Hub
+    {
+        QString code;
+        double longitude;
+        double latitude;
+        QString country;
+        QStringList airlines;
+        double weight;
+    };
+
+    struct Aircraft
+    {
+        quint32 address = 0;
+        QString callsign;
+        QString country;
+        QString squawk;
+        int homeHub = 0;
+
+        // Route, destinationHub is -1 for a regional airport
+        double originLon = 0.0;
+        double originLat = 0.0;
+        double destLon = 0.0;
+        double destLat = 0.0;
+        int destinationHub = -1;
+        double routeLength = 0.0;   // meters
+        double flown = 0.0;         // meters along the route
+        double laneOffset = 0.0;    // meters right of the great circle
+        double cruiseAltitude = 0.0;
+        double cruiseSpeed = 0.0;
+        double departureTime = 0.0;
+
+        // Ground state
+        bool onGround = false;
+        double groundLon = 0.0;
+        double groundLat = 0.0;
+        double groundSpeed = 0.0;
+        double groundHeading = 0.0;
+        double dwell = 0.0;         // seconds left before departing
+
+        // Cached kinematics for the current time
+        double longitude = 0.0;
+        double latitude = 0.0;
+        double altitude = 0.0;
+        double velocity = 0.0;
+        double heading = 0.0;
+        double verticalRate = 0.0;
+        double geoOffset = 0.0;     // geometric minus barometric altitude
+    };
+
+    struct Kinematics
+    {
+        double longitude;
+        double latitude;
+        double altitude;
+        double velocity;
+        double heading;
+        double verticalRate;
+    };
+
+    void buildHubs();
+    int pickHub(int excludeHub = -1);
+    double gaussian(double mean, double sigma);
+    quint32 nextAddress();
+
+    void spawn(Aircraft& aircraft, bool midFlight);
+    void assignIdentity(Aircraft& aircraft, int hub);
+    void park(Aircraft& aircraft, int hub, double dwell);
+    void depart(Aircraft& aircraft, int originHub);
+    void step(Aircraft& aircraft, double seconds);
+    Kinematics kinematicsAt(const Aircraft& aircraft, double flown) const;
+    void updateKinematics(Aircraft& aircraft) const;
+    void churn(double seconds);
+
+    Options m_options;
+    QRandomGenerator m_random;
+    QList<Hub> m_hubs;
+    QList<double> m_cumulativeHubWeight;
+    QList<Aircraft> m_aircraft;
+    QHash<quint32, int> m_indexByAddress;
+    quint32 m_serial = 0;
+    double m_meanDwell = 0.0;
+    double m_churnCarry = 0.0;
+    qint64 m_time = 0;
+    double m_clock = 0.0;   // fractional seconds since startTime
+};
+
+#endif // TRAFFICGENERATOR_H
\ No newline at end of file
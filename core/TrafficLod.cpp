@@ -0,0 +1,116 @@
+#include "TrafficLod.h"
+#include "WebMercator.h"
+#include <QHash>
+#include <algorithm>
+#include <cmath>
+
+TrafficLod::TrafficLod(const Options& options)
+    : m_options(options)
+{
+}
+
+TrafficLod::Position TrafficLod::toEcef(double longitude, double latitude, double altitude)
+{
+    // A sphere is plenty for choosing a symbol
+    const double lon = qDegreesToRadians(longitude);
+    const double lat = qDegreesToRadians(latitude);
+    const double radius = WebMercator::EarthRadiusMeters + altitude;
+    return Position{radius * std::cos(lat) * std::cos(lon),
+                    radius * std::cos(lat) * std::sin(lon),
+                    radius * std::sin(lat)};
+}
+
+void TrafficLod::setFlights(const QList<FlightData>& flights)
+{
+    // Only drawn aircraft need matching up; everything else starts hidden anyway
+    QHash<QString, Level> previous;
+    for (qsizetype i = 0; i < m_levels.size(); ++i) {
+        if (m_levels[i] != Hidden) {
+            previous.insert(m_icao24s[i], m_levels[i]);
+        }
+    }
+
+    m_positions.resize(flights.size());
+    m_icao24s.resize(flights.size());
+    m_levels.resize(flights.size());
+    for (qsizetype i = 0; i < flights.size(); ++i) {
+        const FlightData& flight = flights[i];
+        m_positions[i] = toEcef(flight.longitude(), flight.latitude(), flight.altitude());
+        m_icao24s[i] = flight.icao24();
+        m_levels[i] = previous.value(flight.icao24(), Hidden);
+    }
+}
+
+void TrafficLod::clear()
+{
+    m_positions.clear();
+    m_icao24s.clear();
+    m_levels.clear();
+}
+
+QList<int> TrafficLod::update(double longitude, double latitude, double altitude)
+{
+    const Position camera = toEcef(longitude, latitude, altitude);
+
+    // Aircraft already at a level keep it until they are past the widened threshold;
+    // others only move up once they are inside the narrowed one
+    const double widen = 1.0 + m_options.hysteresis;
+    const double narrow = 1.0 - m_options.hysteresis;
+    const double modelKeep = std::pow(m_options.modelDistance * widen, 2);
+    const double modelEnter = std::pow(m_options.modelDistance * narrow, 2);
+    const double markerKeep = std::pow(m_options.markerDistance * widen, 2);
+    const double markerEnter = std::pow(m_options.markerDistance * narrow, 2);
+
+    const qsizetype count = m_positions.size();
+    m_distances.resize(count);
+    m_candidates.clear();
+
+    QList<int> changed;
+    for (qsizetype i = 0; i < count; ++i) {
+        const double dx = m_positions[i].x - camera.x;
+        const double dy = m_positions[i].y - camera.y;
+        const double dz = m_positions[i].z - camera.z;
+        const double distance = dx * dx + dy * dy + dz * dz;
+        m_distances[i] = distance;
+
+        const Level current = m_levels[i];
+        Level next = Hidden;
+        if (distance <= (current == Model ? modelKeep : modelEnter)) {
+            next = Model;
+        } else if (distance <= (current == Hidden ? markerEnter : markerKeep)) {
+            next = Marker;
+        }
+
+        if (next == Model) {
+            m_candidates.append(int(i));
+            // Decided below, once the nearest models are known
+            continue;
+        }
+        if (next != current) {
+            m_levels[i] = next;
+            changed.append(int(i));
+        }
+    }
+
+    // Past the model budget the furthest candidates fall back to markers
+    const qsizetype budget = qMax(0, m_options.maxModels);
+    if (m_candidates.size() > budget) {
+        std::nth_element(m_candidates.begin(), m_candidates.begin() + budget, m_candidates.end(),
+                         [this](int a, int b) { return m_distances[a] < m_distances[b]; });
+    }
+    for (qsizetype i = 0; i < m_candidates.size(); ++i) {
+        const int index = m_candidates[i];
+        const Level next = i < budget ? Model : Marker;
+        if (m_levels[index] != next) {
+            m_levels[index] = next;
+            changed.append(index);
+        }
+    }
+
+    return changed;
+}
+
+int TrafficLod::count(Level level) const
+{
+    return int(std::count(m_levels.cbegin(), m_levels.cend(), level));
+}
\ No newline at end of file
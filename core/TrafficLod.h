@@ -0,0 +1,61 @@
+#ifndef TRAFFICLOD_H
+#define TRAFFICLOD_H
+
+#include <QList>
+#include <QString>
+#include "FlightData.h"
+
+// Picks how each aircraft around the 3D camera is drawn: the full model close in, a marker
+// further out and nothing past the cutoff. Positions are converted to earth-centred coordinates
+// once per snapshot, so a camera move costs one squared distance per aircraft. An aircraft only
+// changes level once it is clearly past a threshold, so aircraft near a boundary don't flicker
+// between symbols while the camera orbits.
+class TrafficLod
+{
+public:
+    enum Level : quint8 { Hidden, Marker, Model };
+
+    struct Options
+    {
+        double modelDistance = 5000.0;    // meters from the camera
+        double markerDistance = 80000.0;  // nothing is drawn past this
+        int maxModels = 40;               // the nearest aircraft keep the model, the rest get markers
+        double hysteresis = 0.1;          // fraction of a threshold an aircraft must cross to change level
+    };
+
+    explicit TrafficLod(const Options& options = Options());
+
+    const Options& options() const { return m_options; }
+    void setOptions(const Options& options) { m_options = options; }
+
+    // Replaces the aircraft. Aircraft that were already present keep their level until the next update.
+    void setFlights(const QList<FlightData>& flights);
+    void clear();
+
+    // Recomputes the levels for a camera at this position (altitude in meters) and returns the
+    // indexes into the last setFlights whose level changed
+    QList<int> update(double longitude, double latitude, double altitude);
+
+    qsizetype size() const { return m_levels.size(); }
+    Level level(int index) const { return m_levels[index]; }
+    int count(Level level) const;
+
+private:
+    struct Position
+    {
+        double x;
+        double y;
+        double z;
+    };
+
+    static Position toEcef(double longitude, double latitude, double altitude);
+
+    Options m_options;
+    QList<Position> m_positions;
+    QList<QString> m_icao24s;
+    QList<Level> m_levels;
+    QList<double> m_distances;
+    QList<int> m_candidates;
+};
+
+#endif // TRAFFICLOD_H
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "TrafficStats.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <iterator>
+
+bool TrafficStats::apply(const FlightSnapshotDelta& delta)
+{
+    TraceScope trace("stats", "pipeline", QString::number(delta.upserted.size() + delta.removed.size()));
+
+    for (const QString& icao24 : delta.removed) {
+        const auto it = m_facets.constFind(icao24);
+        if (it != m_facets.cend()) {
+            tally(*it, -1);
+            m_facets.erase(it);
+        }
+    }
+
+    bool newCountry = false;
+    for (const FlightData& flight : delta.upserted) {
+        const Facets facets = facetsOf(flight, &newCountry);
+        auto it = m_facets.find(flight.icao24());
+        if (it == m_facets.end()) {
+            m_facets.insert(flight.icao24(), facets);
+            tally(facets, 1);
+            continue;
+        }
+        // Most updates only move the aircraft a little and leave every counter as it was
+        if (it->country != facets.country || it->status != facets.status || it->vertical != facets.vertical
+            || it->altitudeBand != facets.altitudeBand) {
+            tally(*it, -1);
+            tally(facets, 1);
+            *it = facets;
+        }
+    }
+    return newCountry;
+}
+
+void TrafficStats::clear()
+{
+    m_facets.clear();
+    m_countryIds.clear();
+    m_countryNames.clear();
+    m_countryCounts.clear();
+    m_countryContinents.clear();
+    m_continentIds.clear();
+    m_continentNames.clear();
+    m_continentCounts.clear();
+    std::fill(std::begin(m_status), std::end(m_status), 0);
+    std::fill(std::begin(m_vertical), std::end(m_vertical), 0);
+    std::fill(std::begin(m_altitudeBands), std::end(m_altitudeBands), 0);
+}
+
+void TrafficStats::setCountryRegistry(const CountryRegistry& registry)
+{
+    m_registry = registry;
+    m_continentIds.clear();
+    m_continentNames.clear();
+    m_continentCounts.clear();
+    for (int id = 0; id < m_countryNames.size(); ++id) {
+        m_countryContinents[id] = continentIdOf(m_countryNames[id]);
+        m_continentCounts[m_countryContinents[id]] += m_countryCounts[id];
+    }
+}
+
+int TrafficStats::continentIdOf(const QString& country)
+{
+    const QString continent = m_registry.continentFor(country);
+    auto it = m_continentIds.constFind(continent);
+    if (it == m_continentIds.cend()) {
+        it = m_continentIds.insert(continent, int(m_continentNames.size()));
+        m_continentNames.append(continent);
+        m_continentCounts.append(0);
+    }
+    return *it;
+}
+
+TrafficStats::Status TrafficStats::statusOf(const FlightData& flight)
+{
+    return flight.onGround() ? OnGround : Airborne;
+}
+
+TrafficStats::Vertical TrafficStats::verticalOf(const FlightData& flight)
+{
+    // Same thresholds as FlightFilter's vertical status
+    if (flight.verticalRate() > 0.5) {
+        return Climbing;
+    }
+    return flight.verticalRate() < -0.5 ? Descending : Level;
+}
+
+int TrafficStats::altitudeBandOf(const FlightData& flight)
+{
+    const double feet = flight.altitude() * 3.28084;
+    return std::clamp(int(feet / AltitudeBandFeet), 0, AltitudeBandCount - 1);
+}
+
+TrafficStats::Facets TrafficStats::facetsOf(const FlightData& flight, bool* newCountry)
+{
+    Facets facets;
+    facets.status = statusOf(flight);
+    facets.vertical = verticalOf(flight);
+    facets.altitudeBand = quint8(altitudeBandOf(flight));
+
+    // Flights without a country are counted everywhere except per country
+    const QString country = flight.country().trimmed();
+    if (!country.isEmpty()) {
+        auto it = m_countryIds.constFind(country);
+        if (it == m_countryIds.cend()) {
+            it = m_countryIds.insert(country, int(m_countryNames.size()));
+            m_countryNames.append(country);
+            m_countryCounts.append(0);
+            m_countryContinents.append(continentIdOf(country));
+            *newCountry = true;
+        }
+        facets.country = *it;
+    }
+    return facets;
+}
+
+void TrafficStats::tally(const Facets& facets, int delta)
+{
+    if (facets.country >= 0) {
+        m_countryCounts[facets.country] += delta;
+        m_continentCounts[m_countryContinents[facets.country]] += delta;
+    }
+    m_status[facets.status] += delta;
+    m_vertical[facets.vertical] += delta;
+    m_altitudeBands[facets.altitudeBand] += delta;
+}
+
+QVariantMap TrafficStats::toVariantMap() const
+{
+    QVariantList bands;
+    for (int band : m_altitudeBands) {
+        bands.append(band);
+    }
+    return {
+        {"total", total()},
+        {"airborne", m_status[Airborne]},
+        {"onGround", m_status[OnGround]},
+        {"climbing", m_vertical[Climbing]},
+        {"descending", m_vertical[Descending]},
+        {"level", m_vertical[Level]},
+        {"altitudeBands", bands},
+        {"altitudeBandFeet", AltitudeBandFeet}
+    };
+}
\ No newline at end of file
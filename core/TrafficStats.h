@@ -0,0 +1,85 @@
+#ifndef TRAFFICSTATS_H
+#define TRAFFICSTATS_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include "CountryRegistry.h"
+#include "FlightData.h"
+#include "FlightSnapshot.h"
+
+// Running flight counts per country, status, vertical state and altitude band, kept up to date
+// from snapshot deltas. The facets each aircraft was counted under are remembered, so a change
+// or removal moves one aircraft between counters and nothing is recounted.
+//
+// Countries get ids in the order they are first seen and keep them until clear(), also once
+// their count drops to zero, so the filter's list only ever grows. Each country is counted
+// under its continent too, looked up once per country in the registry.
+class TrafficStats
+{
+public:
+    enum Status : quint8 { Airborne, OnGround, StatusCount };
+    enum Vertical : quint8 { Climbing, Descending, Level, VerticalCount };
+
+    // 0-5000 ft, 5000-10000 ft, ... with the last band open-ended, as the altitude slider
+    static constexpr int AltitudeBandFeet = 5000;
+    static constexpr int AltitudeBandCount = 8;
+
+    // Counts the changes in delta; returns true when a country was seen for the first time
+    bool apply(const FlightSnapshotDelta& delta);
+    void clear();
+
+    int total() const { return int(m_facets.size()); }
+    int count(Status status) const { return m_status[status]; }
+    int count(Vertical vertical) const { return m_vertical[vertical]; }
+    int altitudeBand(int band) const { return m_altitudeBands[band]; }
+
+    // Every country seen since clear(), indexed by id
+    const QStringList& countries() const { return m_countryNames; }
+    int countryCount(int id) const { return m_countryCounts[id]; }
+
+    // Continents of the countries seen, indexed by id. Setting the registry looks every
+    // country up again, so countries seen before it was loaded move to their continent.
+    void setCountryRegistry(const CountryRegistry& registry);
+    const CountryRegistry& countryRegistry() const { return m_registry; }
+    const QStringList& continents() const { return m_continentNames; }
+    int continentOf(int countryId) const { return m_countryContinents[countryId]; }
+    int continentCount(int id) const { return m_continentCounts[id]; }
+
+    static Status statusOf(const FlightData& flight);
+    static Vertical verticalOf(const FlightData& flight);
+    static int altitudeBandOf(const FlightData& flight);
+
+    // {total, airborne, onGround, climbing, descending, level, altitudeBands, altitudeBandFeet} for QML
+    QVariantMap toVariantMap() const;
+
+private:
+    struct Facets
+    {
+        int country = -1;
+        Status status = Airborne;
+        Vertical vertical = Level;
+        quint8 altitudeBand = 0;
+    };
+
+    Facets facetsOf(const FlightData& flight, bool* newCountry);
+    int continentIdOf(const QString& country);
+    void tally(const Facets& facets, int delta);
+
+    QHash<QString, Facets> m_facets;    // by icao24
+    QHash<QString, int> m_countryIds;
+    QStringList m_countryNames;
+    QList<int> m_countryCounts;
+    QList<int> m_countryContinents;     // continent id by country id
+    CountryRegistry m_registry;
+    QHash<QString, int> m_continentIds;
+    QStringList m_continentNames;
+    QList<int> m_continentCounts;
+    int m_status[StatusCount] = {};
+    int m_vertical[VerticalCount] = {};
+    int m_altitudeBands[AltitudeBandCount] = {};
+};
+
+#endif // TRAFFICSTATS_H
\ No newline at end of file
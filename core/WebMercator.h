@@ -0,0 +1,24 @@
+#ifndef WEBMERCATOR_H
+#define WEBMERCATOR_H
+
+#include <QPointF>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+// Spherical Web Mercator (EPSG:3857), the projection of the basemaps, in meters
+namespace WebMercator {
+
+constexpr double EarthRadiusMeters = 6378137.0;
+constexpr double MaxLatitude = 85.05112878;
+
+inline QPointF project(double longitude, double latitude)
+{
+    const double lat = std::clamp(latitude, -MaxLatitude, MaxLatitude);
+    return QPointF(EarthRadiusMeters * longitude * M_PI / 180.0,
+                   EarthRadiusMeters * std::log(std::tan(M_PI / 4.0 + lat * M_PI / 360.0)));
+}
+
+}
+
+#endif // WEBMERCATOR_H
\ No newline at end of file
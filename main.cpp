@@ -12,6 +12,7 @@
 
 #include "FlightTracker.h"
 #include "Flight3DViewer.h"
+#include "StartupTimeline.h"
 
 #include "ArcGISRuntimeEnvironment.h"
 #include "MapQuickView.h"
@@ -19,6 +20,7 @@
 #include <QDir>
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
+#include <QQuickWindow>
 #include <QFontDatabase>
 #include <QDebug>
 #include <QQuickStyle>
@@ -53,7 +55,9 @@ QString loadArcGISApiKey()
 
 int main(int argc, char *argv[])
 {
+    StartupTimeline::instance().start();
     QGuiApplication app(argc, argv);
+    StartupTimeline::instance().mark("application created");
 
 
 
@@ -97,6 +101,12 @@ int main(int argc, char *argv[])
 
     // Register the FlightTracker (QQuickItem) for QML
     qmlRegisterType<FlightTracker>("Esri.FlightTracker", 1, 0, "FlightTracker");
+    qmlRegisterUncreatableType<CountryTreeModel>("Esri.FlightTracker", 1, 0, "CountryTreeModel",
+                                                 "CountryTreeModel is owned by FlightTracker");
+    qmlRegisterUncreatableType<FlightListModel>("Esri.FlightTracker", 1, 0, "FlightListModel",
+                                                "FlightListModel is owned by FlightTracker");
+    qmlRegisterUncreatableType<AlertEngine>("Esri.FlightTracker", 1, 0, "AlertEngine",
+                                            "AlertEngine is owned by FlightTracker");
     Flight3DViewer::init();
 
     qmlRegisterModule("Calcite", 1, 0);
@@ -113,6 +123,14 @@ int main(int argc, char *argv[])
 
     // Set the source
     engine.load(QUrl("qrc:/qml/main.qml"));
+    StartupTimeline::instance().mark("qml loaded");
+
+    // frameSwapped comes from the render thread, the mark is queued back to this one
+    if (QQuickWindow *window = qobject_cast<QQuickWindow*>(engine.rootObjects().value(0))) {
+        QObject::connect(window, &QQuickWindow::frameSwapped, &app, []() {
+            StartupTimeline::instance().mark("first window frame");
+        }, Qt::ConnectionType(Qt::QueuedConnection | Qt::SingleShotConnection));
+    }
 
     return app.exec();
 }
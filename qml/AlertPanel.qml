@@ -0,0 +1,177 @@
+// Copyright 2025 ESRI
+//
+// All rights reserved under the copyright laws of the United States
+// and applicable international laws, treaties, and conventions.
+//
+// You may freely redistribute and use this sample code, with or
+// without modification, provided you include the original copyright
+// notice and use restrictions.
+//
+// See the Sample code usage restrictions document for further information.
+//
+
+import QtQuick
+import QtQuick.Controls
+import Esri.FlightTracker
+import "qrc:/esri.com/imports/Calcite" 1.0 as Calcite
+
+// Alerts from FlightTracker's AlertEngine, newest first. Cleared alerts stay dimmed until
+// dismissed; clicking one selects its aircraft if it is still in the feed.
+Rectangle {
+    id: root
+
+    property var flightModel: null
+    readonly property var alerts: flightModel ? flightModel.alerts : null
+
+    width: 340
+    height: Math.min(header.height + list.contentHeight + 2, 320)
+    color: Calcite.Calcite.foreground1
+    border.color: root.alerts && root.alerts.activeCount > 0 ? "#e61e1e" : Calcite.Calcite.border1
+    border.width: 1
+
+    function kindColor(kind) {
+        switch (kind) {
+        case AlertEngine.Hijack:
+        case AlertEngine.Emergency: return "#e61e1e"
+        case AlertEngine.RadioFailure:
+        case AlertEngine.RapidDescent: return "#ff8c00"
+        default: return Calcite.Calcite.text2
+        }
+    }
+
+    Rectangle {
+        id: header
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.margins: 1
+        height: 32
+        color: Calcite.Calcite.foreground2
+
+        Text {
+            anchors.left: parent.left
+            anchors.leftMargin: 10
+            anchors.verticalCenter: parent.verticalCenter
+            text: root.alerts ? "Alerts (" + root.alerts.activeCount + " active)" : "Alerts"
+            color: Calcite.Calcite.text1
+            font.pixelSize: 12
+            font.weight: Font.Medium
+            font.family: "Segoe UI"
+        }
+
+        Text {
+            anchors.right: parent.right
+            anchors.rightMargin: 10
+            anchors.verticalCenter: parent.verticalCenter
+            text: "Dismiss all"
+            color: dismissAllArea.containsMouse ? Calcite.Calcite.text1 : Calcite.Calcite.text2
+            font.pixelSize: 11
+            font.family: "Segoe UI"
+
+            MouseArea {
+                id: dismissAllArea
+                anchors.fill: parent
+                hoverEnabled: true
+                cursorShape: Qt.PointingHandCursor
+                onClicked: root.alerts.dismissAll()
+            }
+        }
+    }
+
+    ListView {
+        id: list
+        anchors.top: header.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        anchors.margins: 1
+        clip: true
+        model: root.alerts
+        boundsBehavior: Flickable.StopAtBounds
+
+        ScrollBar.vertical: Calcite.ScrollBar {
+            policy: ScrollBar.AsNeeded
+        }
+
+        delegate: Rectangle {
+            required property int index
+            required property int kind
+            required property string kindName
+            required property string icao24
+            required property string callsign
+            required property string message
+            required property date time
+            required property bool active
+
+            width: ListView.view.width
+            height: 44
+            color: alertMouseArea.containsMouse ? Calcite.Calcite.foreground2 : "transparent"
+            opacity: active ? 1.0 : 0.55
+
+            Rectangle {
+                width: 4
+                height: parent.height - 8
+                anchors.left: parent.left
+                anchors.leftMargin: 6
+                anchors.verticalCenter: parent.verticalCenter
+                color: root.kindColor(kind)
+            }
+
+            Column {
+                anchors.left: parent.left
+                anchors.leftMargin: 18
+                anchors.right: dismissText.left
+                anchors.rightMargin: 8
+                anchors.verticalCenter: parent.verticalCenter
+                spacing: 2
+
+                Text {
+                    width: parent.width
+                    text: kindName + "  " + (callsign !== "" ? callsign : icao24)
+                          + "  " + Qt.formatTime(time, "HH:mm:ss") + (active ? "" : "  (cleared)")
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 12
+                    font.weight: Font.Medium
+                    font.family: "Segoe UI"
+                    elide: Text.ElideRight
+                }
+
+                Text {
+                    width: parent.width
+                    text: message
+                    color: Calcite.Calcite.text2
+                    font.pixelSize: 11
+                    font.family: "Segoe UI"
+                    elide: Text.ElideRight
+                }
+            }
+
+            MouseArea {
+                id: alertMouseArea
+                anchors.fill: parent
+                hoverEnabled: true
+                cursorShape: Qt.PointingHandCursor
+                onClicked: root.flightModel.selectFlight(icao24)
+            }
+
+            Text {
+                id: dismissText
+                anchors.right: parent.right
+                anchors.rightMargin: 10
+                anchors.verticalCenter: parent.verticalCenter
+                text: "✕"
+                color: dismissArea.containsMouse ? Calcite.Calcite.text1 : Calcite.Calcite.text2
+                font.pixelSize: 12
+
+                MouseArea {
+                    id: dismissArea
+                    anchors.fill: parent
+                    anchors.margins: -6
+                    hoverEnabled: true
+                    cursorShape: Qt.PointingHandCursor
+                    onClicked: root.alerts.dismiss(index)
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
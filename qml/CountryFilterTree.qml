@@ -1,66 +1,19 @@
-// CountryFilterTree.qml - Simplified tree structure for country filtering
+// CountryFilterTree.qml - Continent/country tree for country filtering
 
 import QtQuick
 import QtQuick.Controls
+import QtQml.Models
 import "qrc:/esri.com/imports/Calcite" 1.0 as Calcite
 
+// Selection and counts live in FlightTracker's CountryTreeModel; each checkbox writes its
+// node's checkState and the filter picks the change up from there
 Column {
     id: root
 
-    property var countryData: model.availableCountries || {}
-
-    // Simple object to track what's selected
-    property var countrySelection: ({})
-
-    // Signal for parent component
-    signal selectionChanged(var selectedCountries)
+    property var tree: model ? model.countryTree : null
 
     spacing: 4
 
-    Component.onCompleted: {
-        // Wait for data to be available
-        if (Object.keys(countryData).length === 0) {
-            return  // Data not ready yet
-        }
-
-        var newSelection = {}
-        for (var continent in countryData) {
-            var countries = countryData[continent]
-            for (var i = 0; i < countries.length; i++) {
-                newSelection[countries[i]] = true
-            }
-        }
-        countrySelection = newSelection
-        emitSelectionChange()
-    }
-
-    onCountryDataChanged: {
-        if (Object.keys(countryData).length > 0) {
-            var newSelection = {}
-                // Check if we already have a selection from the backend
-                if (model && model.selectedCountries && model.selectedCountries.length > 0) {
-                    // Use the backend's current selection instead of selecting all
-                    var backendSelected = model.selectedCountries
-
-                    for (var i = 0; i < backendSelected.length; i++) {
-                        newSelection[backendSelected[i]] = true
-                    }
-                    countrySelection = newSelection
-                    emitSelectionChange()
-                } else {
-                    // Only select all if we have no backend selection (first time)
-                    for (var continent in countryData) {
-                        var countries = countryData[continent]
-                        for (var i = 0; i < countries.length; i++) {
-                            newSelection[countries[i]] = true
-                        }
-                    }
-                    countrySelection = newSelection
-                    emitSelectionChange()
-                }
-            }
-    }
-
     // Root "All Countries" checkbox with dropdown
     Column {
         id: rootSection
@@ -89,21 +42,29 @@ Column {
 
                 Calcite.CheckBox {
                     id: selectAllCheckbox
-                    text: "All Countries (" + getSelectedCount() + "/" + getTotalCount() + ")"
+                    text: root.tree ? "All Countries (" + root.tree.selectedCount + "/" + root.tree.countryCount + ")"
+                                    : "All Countries"
                     font.weight: Font.Medium
-                    checked: isAllSelected()
+                    checkState: root.tree ? root.tree.allCheckState : Qt.Unchecked
                     anchors.verticalCenter: parent.verticalCenter
 
                     onClicked: {
-                        if (checked) {
-                            selectAll()
-                        } else {
-                            selectNone()
+                        if (root.tree) {
+                            root.tree.setAllSelected(checked)
                         }
                     }
                 }
             }
 
+            Text {
+                anchors.right: parent.right
+                anchors.rightMargin: 8
+                anchors.verticalCenter: parent.verticalCenter
+                text: root.tree ? root.tree.flightCount : ""
+                font.pixelSize: 11
+                color: Calcite.Calcite.text2
+            }
+
             // Click anywhere on header to expand/collapse
             MouseArea {
                 anchors.fill: parent
@@ -114,26 +75,6 @@ Column {
                 cursorShape: Qt.PointingHandCursor
             }
         }
-
-        // Selection summary - removed/hidden
-        Rectangle {
-            width: parent.width
-            height: 24
-            color: Calcite.Calcite.background
-            border.color: Calcite.Calcite.border1
-            border.width: 1
-            radius: 2
-            visible: false  // Hide this since we show count in the checkbox text now
-
-            Text {
-                anchors.left: parent.left
-                anchors.leftMargin: 8
-                anchors.verticalCenter: parent.verticalCenter
-                text: getSelectedCount() + " of " + getTotalCount() + " countries selected"
-                font.pixelSize: 11
-                color: Calcite.Calcite.text2
-            }
-        }
     }
 
     // Continent sections container
@@ -143,12 +84,12 @@ Column {
         visible: rootSection.expanded  // Show only when All Countries is expanded
 
         Repeater {
-            model: Object.keys(root.countryData).sort()
+            model: root.tree
 
             // Continent section
             Column {
-                property string continentName: modelData
-                property var countries: root.countryData[modelData] || []
+                id: continentSection
+                property int continentRow: index
                 property bool expanded: false
 
                 width: root.width
@@ -179,20 +120,16 @@ Column {
                     Calcite.CheckBox {
                         id: continentCheckbox
                         anchors.verticalCenter: parent.verticalCenter
-                        checked: isContinentSelected(continentName)
+                        checkState: model.checkState
 
                         onClicked: {
-                            if (checked) {
-                                selectContinent(continentName)
-                            } else {
-                                deselectContinent(continentName)
-                            }
+                            model.checkState = checked ? Qt.Checked : Qt.Unchecked
                         }
                     }
 
                     // Continent name with count
                     Text {
-                        text: continentName + " (" + getContinentSelectedCount(continentName) + "/" + countries.length + ")"
+                        text: model.name + " (" + model.selectedCount + "/" + model.countryCount + ")"
                         font.pixelSize: 13
                         font.weight: Font.Medium
                         color: Calcite.Calcite.text1
@@ -200,6 +137,15 @@ Column {
                     }
                 }
 
+                Text {
+                    anchors.right: parent.right
+                    anchors.rightMargin: 8
+                    anchors.verticalCenter: parent.verticalCenter
+                    text: model.flightCount
+                    font.pixelSize: 11
+                    color: Calcite.Calcite.text2
+                }
+
                 // Click on text to expand/collapse, but not on checkbox or arrow
                 MouseArea {
                     anchors.fill: parent
@@ -218,7 +164,15 @@ Column {
                 spacing: 2
 
                 Repeater {
-                    model: countries.sort()
+                    model: DelegateModel {
+                        model: root.tree
+                        rootIndex: root.tree.index(continentSection.continentRow, 0)
+                        delegate: countryDelegate
+                    }
+                }
+
+                Component {
+                    id: countryDelegate
 
                     Rectangle {
                         width: parent.width
@@ -235,29 +189,37 @@ Column {
                             Calcite.CheckBox {
                                 id: countryCheckbox
                                 anchors.verticalCenter: parent.verticalCenter
-                                checked: isCountrySelected(modelData)
+                                checkState: model.checkState
 
                                 onClicked: {
-                                    toggleCountry(modelData, checked)
+                                    model.checkState = checked ? Qt.Checked : Qt.Unchecked
                                 }
                             }
 
                             Text {
-                                text: modelData
+                                text: model.name
                                 font.pixelSize: 12
                                 color: Calcite.Calcite.text1
                                 anchors.verticalCenter: parent.verticalCenter
                             }
                         }
 
+                        Text {
+                            anchors.right: parent.right
+                            anchors.rightMargin: 8
+                            anchors.verticalCenter: parent.verticalCenter
+                            text: model.flightCount
+                            font.pixelSize: 11
+                            color: Calcite.Calcite.text2
+                        }
+
                         MouseArea {
                             id: countryMouseArea
                             anchors.fill: parent
                             anchors.leftMargin: 16
                             hoverEnabled: true
                             onClicked: {
-                                var isSelected = isCountrySelected(modelData)
-                                toggleCountry(modelData, !isSelected)
+                                model.checkState = model.checkState === Qt.Checked ? Qt.Unchecked : Qt.Checked
                             }
                             cursorShape: Qt.PointingHandCursor
                         }
@@ -267,150 +229,4 @@ Column {
         }
     }
     }
-
-    // Helper functions
-    function isCountrySelected(country) {
-        return countrySelection[country] === true
-    }
-
-    function isContinentSelected(continent) {
-        var countries = countryData[continent] || []
-        for (var i = 0; i < countries.length; i++) {
-            if (!isCountrySelected(countries[i])) {
-                return false
-            }
-        }
-        return countries.length > 0
-    }
-
-    function isAllSelected() {
-        for (var continent in countryData) {
-            var countries = countryData[continent]
-            for (var i = 0; i < countries.length; i++) {
-                if (!isCountrySelected(countries[i])) {
-                    return false
-                }
-            }
-        }
-        return true
-    }
-
-    function getSelectedCount() {
-        var count = 0
-        for (var country in countrySelection) {
-            if (countrySelection[country]) {
-                count++
-            }
-        }
-        return count
-    }
-
-    function getTotalCount() {
-        var total = 0
-        for (var continent in countryData) {
-            total += countryData[continent].length
-        }
-        return total
-    }
-
-    function getContinentSelectedCount(continent) {
-        var count = 0
-        var countries = countryData[continent] || []
-        for (var i = 0; i < countries.length; i++) {
-            if (isCountrySelected(countries[i])) {
-                count++
-            }
-        }
-        return count
-    }
-
-    function toggleCountry(country, selected) {
-        var newSelection = {}
-        // Copy existing selections
-        for (var c in countrySelection) {
-            newSelection[c] = countrySelection[c]
-        }
-        // Update this country
-        newSelection[country] = selected
-        countrySelection = newSelection
-        emitSelectionChange()
-    }
-
-    function selectContinent(continent) {
-        var newSelection = {}
-        // Copy existing selections
-        for (var c in countrySelection) {
-            newSelection[c] = countrySelection[c]
-        }
-        // Select all countries in continent
-        var countries = countryData[continent] || []
-        for (var i = 0; i < countries.length; i++) {
-            newSelection[countries[i]] = true
-        }
-        countrySelection = newSelection
-        emitSelectionChange()
-    }
-
-    function deselectContinent(continent) {
-        var newSelection = {}
-        // Copy existing selections
-        for (var c in countrySelection) {
-            newSelection[c] = countrySelection[c]
-        }
-        // Deselect all countries in continent
-        var countries = countryData[continent] || []
-        for (var i = 0; i < countries.length; i++) {
-            newSelection[countries[i]] = false
-        }
-        countrySelection = newSelection
-        emitSelectionChange()
-    }
-
-    function selectAll() {
-        var newSelection = {}
-        for (var continent in countryData) {
-            var countries = countryData[continent]
-            for (var i = 0; i < countries.length; i++) {
-                newSelection[countries[i]] = true
-            }
-        }
-        countrySelection = newSelection
-        emitSelectionChange()
-    }
-
-    function selectNone() {
-        var newSelection = {}
-        for (var continent in countryData) {
-            var countries = countryData[continent]
-            for (var i = 0; i < countries.length; i++) {
-                newSelection[countries[i]] = false
-            }
-        }
-        countrySelection = newSelection
-        emitSelectionChange()
-    }
-
-    function emitSelectionChange() {
-        var selectedList = []
-        for (var country in countrySelection) {
-            if (countrySelection[country]) {
-                selectedList.push(country)
-            }
-        }
-        selectionChanged(selectedList)
-    }
-
-    function resetToAllSelected() {
-        if (Object.keys(countryData).length > 0) {
-            var newSelection = {}
-            for (var continent in countryData) {
-                var countries = countryData[continent]
-                for (var i = 0; i < countries.length; i++) {
-                    newSelection[countries[i]] = true
-                }
-            }
-            countrySelection = newSelection
-            // Don't emit selection change since backend was already updated
-        }
-    }
-}
+}
\ No newline at end of file
@@ -11,6 +11,8 @@ Item {
     property bool isOpen: false
 
     property var flightModel: null
+    // Running counts behind the badges and the altitude histogram
+    readonly property var stats: flightModel ? flightModel.trafficStats : null
 
     width: Math.min(500, parent.width * 0.4)
     height: filterButton.height
@@ -117,12 +119,6 @@ Item {
                     CountryFilterTree {
                         id: countryTree
                         width: parent.width
-
-                        onSelectionChanged: function(selectedCountries) {
-                            if (root.flightModel) {
-                                root.flightModel.selectedCountries = selectedCountries
-                            }
-                        }
                     }
                 }
 
@@ -139,6 +135,8 @@ Item {
 
                     // Configure the generic component for flight status
                     title: "Flight Status"
+                    counts: root.stats ? {All: root.stats.total, Airborne: root.stats.airborne,
+                                          OnGround: root.stats.onGround} : ({})
                     options: [
                         {text: "All Flights", value: "All"},
                         {text: "Airborne Only", value: "Airborne"},
@@ -168,6 +166,7 @@ Item {
                      width: parent.width - 32
 
                      title: "Altitude (ft)"
+                     histogram: root.stats ? root.stats.altitudeBands : []
                      unit: "ft"
                      minValue: 0
                      maxValue: 40000  // Changed from 45000
@@ -236,6 +235,8 @@ Item {
                     width: parent.width - 32
 
                     title: "Vertical Rate"
+                    counts: root.stats ? {All: root.stats.total, Climbing: root.stats.climbing,
+                                          Descending: root.stats.descending, Level: root.stats.level} : ({})
                     options: [
                         {text: "All", value: "All"},
                         {text: "Climbing", value: "Climbing"},
@@ -293,16 +294,7 @@ Item {
                         speedFilter.resetToDefaults()
 
                         // Reset country filter to all countries
-                        if (root.flightModel.availableCountries) {
-                            var allCountries = [];
-                            var continents = root.flightModel.availableCountries;
-                            for (var continent in continents) {
-                                var countries = continents[continent];
-                                allCountries = allCountries.concat(countries);
-                            }
-                            root.flightModel.selectedCountries = allCountries;
-                            countryTree.resetToAllSelected();
-                        }
+                        root.flightModel.countryTree.setAllSelected(true)
                     }
                 }
             }
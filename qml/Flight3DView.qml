@@ -4,6 +4,8 @@ import Esri.FlightTracker
 import "qrc:/esri.com/imports/Calcite" 1.0 as Calcite
 
 Item {
+    id: flight3DView
+
     // Properties passed from StackView.push()
     property var flightData: null
     property var flightTracker: null
@@ -20,6 +22,7 @@ Item {
         id: flight3DViewer
         sceneView: sceneView
         mapView: miniMapView
+        flightTracker: flight3DView.flightTracker
 
         Component.onCompleted: {
             // Initialize theme
@@ -29,20 +32,16 @@ Item {
                 }
             })
             
-            // Check if we have valid flight data first
-            if (flightData && Array.isArray(flightData) && flightData.length > 0) {
-                console.log("Displaying flight in 3D view")
-                displayFlight(flightData)
-            } else if (flightTracker && typeof flightTracker.getSelectedFlightData === "function") {
-                var data = flightTracker.getSelectedFlightData()
-                if (data && data.length > 0) {
-                    console.log("Displaying flight in 3D view from tracker")
-                    displayFlight(data)
-                } else {
-                    console.log("No flight selected - select a flight first")
-                }
+            // Follow the selected aircraft; the viewer takes each refresh from the tracker
+            var data = flightData
+            if (!(data && data.length > 0) && flightTracker) {
+                data = flightTracker.getSelectedFlightData()
+            }
+            if (data && data.length > 0) {
+                console.log("Following flight in 3D view")
+                icao24 = data[0]
             } else {
-                console.log("No flight data available for 3D view")
+                console.log("No flight selected - select a flight first")
             }
         }
     }
@@ -71,7 +70,7 @@ Item {
         anchors.right: parent.right
         anchors.margins: 16
         width: 220
-        height: 200
+        height: 250
         color: Calcite.Calcite.foreground1
         border.color: Calcite.Calcite.border1
         border.width: 1
@@ -131,6 +130,28 @@ Item {
                     flight3DViewer.cameraHeading = value
                 }
             }
+
+            Row {
+                spacing: 8
+
+                Calcite.Switch {
+                    checked: flight3DViewer.showTraffic
+                    anchors.verticalCenter: parent.verticalCenter
+
+                    onCheckedChanged: {
+                        flight3DViewer.showTraffic = checked
+                    }
+                }
+
+                Text {
+                    text: flight3DViewer.showTraffic
+                          ? "Traffic: " + flight3DViewer.trafficModels + " near, " + flight3DViewer.trafficMarkers + " far"
+                          : "Traffic"
+                    color: Calcite.Calcite.text2
+                    font.pixelSize: 10
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+            }
         }
     }
 
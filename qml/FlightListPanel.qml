@@ -0,0 +1,220 @@
+// Copyright 2025 ESRI
+//
+// All rights reserved under the copyright laws of the United States
+// and applicable international laws, treaties, and conventions.
+//
+// You may freely redistribute and use this sample code, with or
+// without modification, provided you include the original copyright
+// notice and use restrictions.
+//
+// See the Sample code usage restrictions document for further information.
+//
+
+import QtQuick
+import QtQuick.Controls
+import Esri.FlightTracker
+import "qrc:/esri.com/imports/Calcite" 1.0 as Calcite
+
+// The visible flights as a sortable table. Rows come from FlightTracker's FlightListModel,
+// which updates them in place, so the list keeps its scroll position across refreshes.
+// Delegates have a fixed height and are reused, so only the rows on screen exist.
+Rectangle {
+    id: root
+
+    property var flightModel: null
+    readonly property var listModel: flightModel ? flightModel.flightList : null
+    property string selectedIcao24: ""
+
+    readonly property int rowHeight: 24
+    readonly property var columns: [
+        { title: "Callsign", column: FlightListModel.Callsign, width: 80 },
+        { title: "ICAO24", column: FlightListModel.Icao24, width: 64 },
+        { title: "Country", column: FlightListModel.Country, width: 130 },
+        { title: "Alt (ft)", column: FlightListModel.Altitude, width: 68 },
+        { title: "Spd (kt)", column: FlightListModel.Speed, width: 60 },
+        { title: "Hdg", column: FlightListModel.Heading, width: 40 },
+        { title: "V/S (fpm)", column: FlightListModel.VerticalRate, width: 68 },
+        { title: "Squawk", column: FlightListModel.Squawk, width: 52 }
+    ]
+
+    width: 600
+    color: Calcite.Calcite.foreground1
+    border.color: Calcite.Calcite.border1
+    border.width: 1
+
+    Connections {
+        target: root.flightModel
+        function onSelectedFlightChanged() {
+            const data = root.flightModel.getSelectedFlightData()
+            root.selectedIcao24 = data.length > 0 ? data[0] : ""
+        }
+    }
+
+    // Header: clicking a column sorts by it, clicking it again reverses the order
+    Rectangle {
+        id: header
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.margins: 1
+        height: 32
+        color: Calcite.Calcite.foreground2
+
+        Row {
+            anchors.left: parent.left
+            anchors.leftMargin: 8
+            anchors.verticalCenter: parent.verticalCenter
+
+            Repeater {
+                model: root.columns
+
+                Item {
+                    required property var modelData
+                    readonly property bool sorted: root.listModel && root.listModel.sortColumn === modelData.column
+
+                    width: modelData.width
+                    height: header.height
+
+                    Text {
+                        anchors.verticalCenter: parent.verticalCenter
+                        text: modelData.title + (!sorted ? "" : root.listModel.sortOrder === Qt.AscendingOrder ? " ▲" : " ▼")
+                        color: sorted ? Calcite.Calcite.text1 : Calcite.Calcite.text2
+                        font.pixelSize: 11
+                        font.weight: sorted ? Font.Medium : Font.Normal
+                        font.family: "Segoe UI"
+                    }
+
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        enabled: root.listModel !== null
+                        onClicked: {
+                            const order = sorted && root.listModel.sortOrder === Qt.AscendingOrder
+                                          ? Qt.DescendingOrder : Qt.AscendingOrder
+                            root.listModel.sort(modelData.column, order)
+                        }
+                    }
+                }
+            }
+        }
+
+        Text {
+            anchors.right: parent.right
+            anchors.rightMargin: 12
+            anchors.verticalCenter: parent.verticalCenter
+            text: root.listModel ? root.listModel.count + " flights" : ""
+            color: Calcite.Calcite.text2
+            font.pixelSize: 11
+            font.family: "Segoe UI"
+        }
+    }
+
+    ListView {
+        id: list
+        anchors.top: header.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        anchors.margins: 1
+        clip: true
+        model: root.listModel
+        reuseItems: true
+        boundsBehavior: Flickable.StopAtBounds
+
+        ScrollBar.vertical: Calcite.ScrollBar {
+            policy: ScrollBar.AsNeeded
+        }
+
+        delegate: Rectangle {
+            required property int index
+            required property string icao24
+            required property string callsign
+            required property string country
+            required property double altitude
+            required property double speed
+            required property double heading
+            required property double verticalRate
+            required property bool onGround
+            required property string squawk
+
+            readonly property bool selected: icao24 === root.selectedIcao24
+
+            width: ListView.view.width
+            height: root.rowHeight
+            color: selected ? Calcite.Calcite.border2
+                            : rowMouseArea.containsMouse ? Calcite.Calcite.foreground2 : "transparent"
+
+            Row {
+                anchors.left: parent.left
+                anchors.leftMargin: 8
+                anchors.verticalCenter: parent.verticalCenter
+
+                Text {
+                    width: root.columns[0].width
+                    text: callsign
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                    elide: Text.ElideRight
+                }
+                Text {
+                    width: root.columns[1].width
+                    text: icao24
+                    color: Calcite.Calcite.text2
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                }
+                Text {
+                    width: root.columns[2].width
+                    text: country
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 11
+                    font.family: "Segoe UI"
+                    elide: Text.ElideRight
+                }
+                Text {
+                    width: root.columns[3].width
+                    text: onGround ? "GND" : Math.round(altitude)
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                }
+                Text {
+                    width: root.columns[4].width
+                    text: Math.round(speed)
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                }
+                Text {
+                    width: root.columns[5].width
+                    text: Math.round(heading)
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                }
+                Text {
+                    width: root.columns[6].width
+                    text: Math.round(verticalRate)
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                }
+                Text {
+                    width: root.columns[7].width
+                    text: squawk
+                    color: Calcite.Calcite.text2
+                    font.pixelSize: 11
+                    font.family: "Consolas"
+                }
+            }
+
+            MouseArea {
+                id: rowMouseArea
+                anchors.fill: parent
+                hoverEnabled: true
+                onClicked: root.flightModel.selectFlight(icao24)
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -22,6 +22,9 @@ Item {
     property bool isDarkTheme: true
     signal toggleTheme()
 
+    // Live data needs an OpenSky token; a replay runs without one
+    readonly property bool hasDataSource: model.isAuthenticated || model.isReplaying
+
     MapView {
         id: view
         anchors.fill: parent
@@ -81,7 +84,7 @@ Item {
         border.width: 1
         radius: 5
         z: 10
-        visible: model.isAuthenticated
+        visible: hasDataSource
 
         Column {
             anchors.centerIn: parent
@@ -212,7 +215,7 @@ Item {
         anchors.fill: parent
         color: "black"
         opacity: 0.8
-        visible: !model.isAuthenticated
+        visible: !hasDataSource
 
         Column {
             anchors.centerIn: parent
@@ -228,7 +231,7 @@ Item {
 
             BusyIndicator {
                 anchors.horizontalCenter: parent.horizontalCenter
-                visible: !model.isAuthenticated
+                visible: !hasDataSource
             }
         }
     }
@@ -354,6 +357,7 @@ Item {
     }
 
     Rectangle {
+        id: controlsBar
         anchors.top: parent.top
         anchors.horizontalCenter: parent.horizontalCenter
         anchors.topMargin: 16
@@ -364,7 +368,7 @@ Item {
         border.width: 1
         radius: 0
         z: 15
-        visible: model.isAuthenticated
+        visible: hasDataSource
 
         Row {
             id: controlsRow
@@ -373,11 +377,21 @@ Item {
 
             Calcite.Button {
                 id: refreshButton
-                text: "Update Flights"
+                text: !model.isReplaying ? "Update Flights"
+                                         : model.isReplayFinished ? "Restart Replay"
+                                         : (model.isReplayPaused ? "Resume Replay" : "Pause Replay")
                 anchors.verticalCenter: parent.verticalCenter
 
                 onClicked: {
-                    model.fetchFlightData()
+                    if (!model.isReplaying) {
+                        model.fetchFlightData()
+                    } else if (model.isReplayFinished) {
+                        model.restartReplay()
+                    } else if (model.isReplayPaused) {
+                        model.resumeReplay()
+                    } else {
+                        model.pauseReplay()
+                    }
                 }
             }
 
@@ -440,7 +454,8 @@ Item {
                 spacing: 2
 
                 Text {
-                    text: "Last Update"
+                    // Flights from the previous session until live data arrives
+                    text: model.isStale ? "Last Update (cached)" : "Last Update"
                     color: Calcite.Calcite.text2
                     font.pixelSize: 10
                     font.family: "Segoe UI"
@@ -474,7 +489,7 @@ Item {
         border.width: 1
         radius: 0
         z: 25
-        visible: model.isAuthenticated
+        visible: hasDataSource
 
 
         Row {
@@ -514,6 +529,34 @@ Item {
                 anchors.verticalCenter: parent.verticalCenter
             }
 
+            // Flight List Toggle
+            Row {
+                spacing: 8
+                anchors.verticalCenter: parent.verticalCenter
+
+                Text {
+                    text: "Show List"
+                    color: Calcite.Calcite.text1
+                    font.pixelSize: 12
+                    font.family: "Segoe UI"
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+
+                Calcite.Switch {
+                    id: listSwitch
+                    checked: false
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+            }
+
+            // Separator line
+            Rectangle {
+                width: 1
+                height: parent.height - 16
+                color: Calcite.Calcite.border2
+                anchors.verticalCenter: parent.verticalCenter
+            }
+
             // Filter Panel (embedded without its own container)
             FilterPanel {
                 id: filterPanel
@@ -531,7 +574,7 @@ Item {
         anchors.bottomMargin: 32
         text: "View in 3D"
         z: 15
-        enabled: model.isAuthenticated && model.hasSelectedFlight
+        enabled: hasDataSource && model.hasSelectedFlight
 
         onClicked: {
             console.log("3D View button clicked")
@@ -541,6 +584,124 @@ Item {
     }
     signal switchTo3DRequested(var flightModel)
 
+    // Zoomed out far enough that aircraft are drawn as density
+    Rectangle {
+        anchors.bottom: view3DButton.top
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.bottomMargin: 12
+        width: densityText.width + 20
+        height: densityText.height + 10
+        color: Calcite.Calcite.foreground1
+        border.color: Calcite.Calcite.border1
+        border.width: 1
+        z: 15
+        visible: hasDataSource && model.showDensity
+
+        Text {
+            id: densityText
+            anchors.centerIn: parent
+            text: "Showing traffic density - zoom in to see individual aircraft"
+            color: Calcite.Calcite.text2
+            font.pixelSize: 11
+            font.family: "Segoe UI"
+        }
+    }
+
+    // Loss of separation: the nearest pairs, red while closing; a click selects the first aircraft
+    Rectangle {
+        id: conflictBox
+        anchors.top: controlsBar.bottom
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.topMargin: 8
+        width: conflictColumn.width + 20
+        height: conflictColumn.height + 12
+        color: Calcite.Calcite.foreground1
+        border.color: "#ffaa00"
+        border.width: 1
+        z: 15
+        visible: hasDataSource && model.conflictCount > 0
+
+        readonly property var shown: model.conflicts.slice(0, 3)
+
+        function select(icao24) {
+            model.selectFlight(icao24)
+        }
+
+        Column {
+            id: conflictColumn
+            anchors.centerIn: parent
+            spacing: 2
+
+            Text {
+                text: model.conflictCount + (model.conflictCount === 1 ? " pair" : " pairs") + " below separation"
+                color: Calcite.Calcite.text1
+                font.pixelSize: 12
+                font.weight: Font.Medium
+                font.family: "Segoe UI"
+            }
+
+            Repeater {
+                model: conflictBox.shown
+
+                Text {
+                    required property var modelData
+                    text: (modelData.firstCallsign || modelData.first) + " / "
+                          + (modelData.secondCallsign || modelData.second) + "   "
+                          + modelData.distanceNm.toFixed(1) + " NM, " + Math.round(modelData.verticalFeet) + " ft, "
+                          + (modelData.closureKnots > 0 ? "closing " + Math.round(modelData.closureKnots) + " kt"
+                                                        : "diverging")
+                    color: modelData.closureKnots > 0 ? "#e61e1e" : Calcite.Calcite.text2
+                    font.pixelSize: 11
+                    font.family: "Segoe UI"
+
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: conflictBox.select(modelData.first)
+                    }
+                }
+            }
+        }
+    }
+
+    FlightListPanel {
+        anchors.left: parent.left
+        anchors.top: parent.top
+        anchors.bottom: view3DButton.top
+        anchors.leftMargin: 16
+        anchors.topMargin: 16
+        anchors.bottomMargin: 16
+        z: 20
+        flightModel: model
+        visible: hasDataSource && listSwitch.checked
+    }
+
+    // Raised alerts, above the altitude legend
+    AlertPanel {
+        anchors.right: parent.right
+        anchors.bottom: altitudeLegend.top
+        anchors.rightMargin: 32
+        anchors.bottomMargin: 12
+        z: 20
+        flightModel: model
+        visible: hasDataSource && model.alerts.count > 0
+    }
+
+    PerformanceOverlay {
+        anchors.left: parent.left
+        anchors.top: parent.top
+        anchors.leftMargin: 16
+        anchors.topMargin: 16
+        z: 30
+        flightModel: model
+        visible: model.showPerformanceOverlay
+    }
+
+    Shortcut {
+        sequence: "Ctrl+Shift+P"
+        onActivated: model.showPerformanceOverlay = !model.showPerformanceOverlay
+    }
+
     // Declare the C++ instance which creates the map etc. and supply the view
     FlightTracker {
         id: model
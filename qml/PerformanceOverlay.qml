@@ -0,0 +1,121 @@
+// Copyright 2025 ESRI
+//
+// All rights reserved under the copyright laws of the United States
+// and applicable international laws, treaties, and conventions.
+//
+// You may freely redistribute and use this sample code, with or
+// without modification, provided you include the original copyright
+// notice and use restrictions.
+//
+// See the Sample code usage restrictions document for further information.
+//
+
+import QtQuick
+import "qrc:/esri.com/imports/Calcite" 1.0 as Calcite
+
+// Rolling refresh-stage and frame timings from FlightTracker
+Rectangle {
+    id: root
+
+    property var flightModel: null
+
+    width: content.width + 20
+    height: content.height + 16
+    color: Calcite.Calcite.foreground1
+    opacity: 0.92
+    border.color: Calcite.Calcite.border1
+    border.width: 1
+
+    function ms(value) {
+        return value === undefined ? "-" : value.toFixed(1)
+    }
+
+    Column {
+        id: content
+        anchors.centerIn: parent
+        spacing: 4
+
+        Text {
+            text: "Pipeline (ms)"
+            color: Calcite.Calcite.text1
+            font.pixelSize: 12
+            font.weight: Font.Medium
+            font.family: "Segoe UI"
+        }
+
+        Grid {
+            columns: 5
+            columnSpacing: 12
+            rowSpacing: 2
+
+            Repeater {
+                model: ["Stage", "Last", "Avg", "P95", "Max"]
+                Text {
+                    text: modelData
+                    color: Calcite.Calcite.text2
+                    font.pixelSize: 11
+                    font.family: "Segoe UI"
+                }
+            }
+
+            Repeater {
+                model: flightModel ? flightModel.pipelineStats : []
+
+                Repeater {
+                    property var stage: modelData
+                    model: [stage.name,
+                            stage.count > 0 ? ms(stage.last) : "-",
+                            stage.count > 0 ? ms(stage.avg) : "-",
+                            stage.count > 0 ? ms(stage.p95) : "-",
+                            stage.count > 0 ? ms(stage.max) : "-"]
+                    Text {
+                        text: modelData
+                        color: Calcite.Calcite.text1
+                        font.pixelSize: 11
+                        font.family: "Consolas"
+                        horizontalAlignment: index === 0 ? Text.AlignLeft : Text.AlignRight
+                    }
+                }
+            }
+        }
+
+        Text {
+            readonly property var frames: flightModel ? flightModel.frameStats : ({})
+            text: frames.count > 0
+                  ? "Frames: " + frames.fps.toFixed(0) + " fps, " + ms(frames.avg) + " avg / "
+                    + ms(frames.p95) + " p95 / " + ms(frames.max) + " max ms"
+                  : "Frames: idle"
+            color: Calcite.Calcite.text2
+            font.pixelSize: 11
+            font.family: "Consolas"
+        }
+
+        Text {
+            readonly property var memory: flightModel ? flightModel.memoryStats : ({})
+            text: "Live: " + (memory.graphics || 0) + " graphics, " + (memory.symbols || 0) + " symbols, "
+                  + (memory.popups || 0) + " popups, RSS "
+                  + (memory.residentBytes > 0 ? (memory.residentBytes / 1048576).toFixed(0) + " MB" : "-")
+            color: Calcite.Calcite.text2
+            font.pixelSize: 11
+            font.family: "Consolas"
+        }
+
+        Text {
+            readonly property var startup: flightModel ? flightModel.startupStats : ({})
+            text: startup.mapMs >= 0
+                  ? "Startup: map drawn " + startup.mapMs.toFixed(0) + " ms after Start (budget "
+                    + startup.budgetMs.toFixed(0) + " ms)"
+                  : "Startup: map not drawn yet"
+            color: startup.mapMs > startup.budgetMs ? Calcite.Calcite.danger : Calcite.Calcite.text2
+            font.pixelSize: 11
+            font.family: "Consolas"
+        }
+
+        Text {
+            text: "Ctrl+Shift+P to hide"
+            color: Calcite.Calcite.text3
+            font.pixelSize: 10
+            font.family: "Segoe UI"
+        }
+    }
+}
\ No newline at end of file
@@ -15,6 +15,9 @@ Column {
     property real selectedMaxValue: 100
     property real stepSize: 1
 
+    // Flight counts in equal bins from minValue to maxValue, drawn above the slider
+    property var histogram: []
+
     // Preset buttons configuration
     property var presets: []  // Array of {text: "Label", min: 0, max: 100}
 
@@ -63,6 +66,38 @@ Column {
                 }
             }
 
+            // Distribution of the current flights; bins outside the selection are dimmed
+            Row {
+                id: histogramRow
+                width: parent.width
+                height: 32
+                visible: root.histogram.length > 0
+
+                readonly property real peak: Math.max(1, Math.max.apply(null, root.histogram))
+                readonly property real binSize: (root.maxValue - root.minValue) / Math.max(1, root.histogram.length)
+
+                Repeater {
+                    model: root.histogram
+
+                    Item {
+                        width: histogramRow.width / root.histogram.length
+                        height: histogramRow.height
+
+                        readonly property real binStart: root.minValue + index * histogramRow.binSize
+                        readonly property bool selected: binStart + histogramRow.binSize > root.selectedMinValue
+                                                         && binStart < root.selectedMaxValue
+
+                        Rectangle {
+                            anchors.bottom: parent.bottom
+                            anchors.horizontalCenter: parent.horizontalCenter
+                            width: parent.width - 2
+                            height: modelData > 0 ? Math.max(2, parent.height * modelData / histogramRow.peak) : 0
+                            color: parent.selected ? Calcite.Calcite.text2 : Calcite.Calcite.border2
+                        }
+                    }
+                }
+            }
+
             // Range slider
             Calcite.RangeSlider {
                 id: rangeSlider
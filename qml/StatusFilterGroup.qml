@@ -14,6 +14,8 @@ Column {
         {text: "Option 3", value: "Value3"}
     ]
     property string selectedValue: "All"
+    // Live flight count per option value, shown beside its label when present
+    property var counts: ({})
 
     signal valueChanged(string value)
 
@@ -37,7 +39,9 @@ Column {
                 model: root.options
 
                 Calcite.RadioButton {
-                    text: modelData.text
+                    text: root.counts[modelData.value] !== undefined
+                          ? modelData.text + "  (" + root.counts[modelData.value].toLocaleString(Qt.locale(), "f", 0) + ")"
+                          : modelData.text
                     checked: root.selectedValue === modelData.value
 
                     onClicked: {
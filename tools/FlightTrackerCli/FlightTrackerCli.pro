@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#  Runs the tracker's data pipeline headless against fixtures or
+#  synthetic traffic and prints per-stage throughput. Links only
+#  FlightTrackerCore, so it builds and profiles without the ArcGIS
+#  SDK or a GPU.
+#-------------------------------------------------
+
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+QT = core
+
+TARGET = FlightTrackerCli
+
+include($$PWD/../../core/FlightTrackerCore.pri)
+
+DEFINES += COUNTRIES_JSON=\\\"$$PWD/../../qml/countries.json\\\"
+
+SOURCES += \
+    main.cpp
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "FlightDataSource.h"
+#include "FlightStore.h"
+#include "PipelineStats.h"
+#include "TraceRecorder.h"
+#include "TrafficGenerator.h"
+#include "MemoryStats.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QDebug>
+#include <cstdio>
+
+namespace {
+enum Stage { Decode, Ingest, Filter, Query, Record, StageCount };
+
+const char* StageNames[StageCount] = {"decode", "ingest+diff", "filter", "query", "record"};
+
+void quietMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    // decodeStates logs every call, which would swamp the report
+    if (type == QtDebugMsg) {
+        return;
+    }
+    fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+}
+
+QList<QByteArray> loadStates(const QString& fixtureDir)
+{
+    QList<QByteArray> states;
+    QDir statesDir(QDir(fixtureDir).filePath("states"));
+    for (const QString& name : statesDir.entryList({"*.json"}, QDir::Files, QDir::Name)) {
+        QFile file(statesDir.filePath(name));
+        if (file.open(QIODevice::ReadOnly)) {
+            states.append(file.readAll());
+        }
+    }
+    return states;
+}
+
+QList<QByteArray> syntheticStates(int aircraft, int snapshots, quint32 seed)
+{
+    TrafficGenerator::Options options;
+    options.seed = seed;
+    options.aircraftCount = aircraft;
+    TrafficGenerator generator(options);
+
+    QList<QByteArray> states;
+    for (int i = 0; i < snapshots; ++i) {
+        if (i > 0) {
+            generator.advance(10);
+        }
+        states.append(generator.statesJson());
+    }
+    return states;
+}
+
+double elapsedMs(QElapsedTimer& timer)
+{
+    const double ms = timer.nsecsElapsed() / 1e6;
+    timer.restart();
+    return ms;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("FlightTrackerCli");
+    qInstallMessageHandler(quietMessageHandler);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs the flight data pipeline (decode, ingest and diff, filter, query, record) "
+                                     "without a map and prints per-stage throughput.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("fixtures", "Fixture directory with states/*.json (omit with --synthetic).", "[fixtures]");
+
+    QCommandLineOption syntheticOption("synthetic", "Generate this many aircraft instead of reading fixtures.", "count");
+    QCommandLineOption snapshotsOption("snapshots", "Synthetic snapshots to generate.", "count", "10");
+    QCommandLineOption seedOption("seed", "Seed for synthetic traffic and query points.", "seed", "1");
+    QCommandLineOption passesOption("passes", "Times to run through all snapshots.", "count", "5");
+    QCommandLineOption queriesOption("queries", "Hit tests and lookups per snapshot.", "count", "1000");
+    QCommandLineOption statusOption("status", "Status filter: All, Airborne or OnGround.", "status", "All");
+    QCommandLineOption altitudeOption("altitude", "Altitude filter in feet.", "min,max", "0,40000");
+    QCommandLineOption speedOption("speed", "Speed filter in knots.", "min,max", "0,600");
+    QCommandLineOption countriesOption("countries", "countries.json for continent grouping.", "path", COUNTRIES_JSON);
+    QCommandLineOption recordOption("record", "Also record every snapshot to this archive.", "path");
+    QCommandLineOption traceOption("trace", "Write a Chrome trace of the run to this file.", "path");
+    parser.addOptions({syntheticOption, snapshotsOption, seedOption, passesOption, queriesOption, statusOption,
+                       altitudeOption, speedOption, countriesOption, recordOption, traceOption});
+    parser.process(app);
+
+    QList<QByteArray> states;
+    QString sourceName;
+    if (parser.isSet(syntheticOption)) {
+        const int aircraft = parser.value(syntheticOption).toInt();
+        states = syntheticStates(aircraft, qMax(1, parser.value(snapshotsOption).toInt()),
+                                 parser.value(seedOption).toUInt());
+        sourceName = QString("synthetic %1 aircraft").arg(aircraft);
+    } else if (parser.positionalArguments().size() == 1) {
+        sourceName = parser.positionalArguments().first();
+        states = loadStates(sourceName);
+    } else {
+        parser.showHelp(1);
+    }
+
+    if (states.isEmpty()) {
+        qCritical() << "No snapshots to run";
+        return 1;
+    }
+
+    if (parser.isSet(traceOption) && !TraceRecorder::instance().start(parser.value(traceOption))) {
+        qCritical() << TraceRecorder::instance().errorString();
+        return 1;
+    }
+
+    FlightStore store;
+    CountryRegistry registry;
+    if (!registry.load(parser.value(countriesOption))) {
+        qWarning() << "Could not load" << parser.value(countriesOption) << "- continents will be Unknown";
+    }
+    store.setCountries(registry);
+
+    if (parser.isSet(recordOption) && !store.startRecording(parser.value(recordOption))) {
+        qCritical() << store.recordingError();
+        return 1;
+    }
+
+    const QStringList altitude = parser.value(altitudeOption).split(',');
+    const QStringList speed = parser.value(speedOption).split(',');
+    FlightFilter filter;
+    filter.setStatus(parser.value(statusOption));
+    filter.setAltitudeRange(altitude.value(0).toDouble(), altitude.value(1, "40000").toDouble());
+    filter.setSpeedRange(speed.value(0).toDouble(), speed.value(1, "600").toDouble());
+
+    const int passes = qMax(1, parser.value(passesOption).toInt());
+    const int queries = qMax(0, parser.value(queriesOption).toInt());
+    QRandomGenerator random(parser.value(seedOption).toUInt());
+
+    const int runs = passes * int(states.size());
+    RollingStats stages[StageCount] = {RollingStats(runs), RollingStats(runs), RollingStats(runs),
+                                       RollingStats(runs), RollingStats(runs)};
+    double totals[StageCount] = {};
+    qint64 flightsProcessed = 0;
+    qint64 changed = 0;
+    qint64 hits = 0;
+    int continents = 0;
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    QElapsedTimer wall;
+    wall.start();
+
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const QByteArray& json : std::as_const(states)) {
+            TraceScope trace("snapshot", "cli");
+            QElapsedTimer timer;
+            timer.start();
+            double ms[StageCount] = {};
+
+            const QList<FlightData> flights = FlightDataSource::decodeStates(json);
+            ms[Decode] = elapsedMs(timer);
+
+            const FlightSnapshotDelta delta = store.ingest(flights);
+            ms[Ingest] = elapsedMs(timer);
+
+            store.setFilter(filter);
+            ms[Filter] = elapsedMs(timer);
+
+            // Clicks near random aircraft and lookups by icao24, as selection does
+            for (int i = 0; i < queries && !flights.isEmpty(); ++i) {
+                const FlightData& target = flights[random.bounded(int(flights.size()))];
+                hits += store.hitTest(target.longitude(), target.latitude(), 5000.0) >= 0;
+                hits += store.indexOf(target.icao24()) >= 0;
+            }
+            continents = int(store.countriesByContinent().size());
+            ms[Query] = elapsedMs(timer);
+
+            if (store.isRecording()) {
+                timestamp += 10000;
+                if (!store.record(flights, timestamp)) {
+                    qCritical() << store.recordingError();
+                    return 1;
+                }
+            }
+            ms[Record] = elapsedMs(timer);
+
+            for (int stage = 0; stage < StageCount; ++stage) {
+                stages[stage].add(ms[stage]);
+                totals[stage] += ms[stage];
+            }
+            flightsProcessed += flights.size();
+            changed += delta.upserted.size() + delta.removed.size();
+        }
+    }
+
+    const double wallSeconds = wall.nsecsElapsed() / 1e9;
+    const qint64 snapshots = qint64(passes) * states.size();
+
+    QTextStream out(stdout);
+    out << "Source:    " << sourceName << " (" << states.size() << " snapshots x " << passes << " passes)\n";
+    out << "Flights:   " << flightsProcessed << " processed, " << changed << " changes diffed, "
+        << store.visibleCount() << "/" << store.size() << " visible at the end, "
+        << continents << " continents\n";
+    out << "Queries:   " << qint64(queries) * snapshots * 2 << " (" << hits << " found)\n\n";
+
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg("stage", -12).arg("total ms", 10).arg("avg ms", 9).arg("p95 ms", 9).arg("max ms", 9)
+               .arg("flights/s", 12);
+    for (int stage = 0; stage < StageCount; ++stage) {
+        const RollingStats& stats = stages[stage];
+        const double perSecond = totals[stage] > 0.0 ? flightsProcessed / (totals[stage] / 1000.0) : 0.0;
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+                   .arg(StageNames[stage], -12)
+                   .arg(totals[stage], 10, 'f', 1)
+                   .arg(stats.mean(), 9, 'f', 3)
+                   .arg(stats.percentile(0.95), 9, 'f', 3)
+                   .arg(stats.max(), 9, 'f', 3)
+                   .arg(perSecond, 12, 'f', 0);
+    }
+
+    out << "\nWall:      " << QString::number(wallSeconds, 'f', 2) << " s, "
+        << QString::number(snapshots / wallSeconds, 'f', 1) << " snapshots/s, "
+        << QString::number(flightsProcessed / wallSeconds, 'f', 0) << " flights/s\n";
+
+    const qint64 resident = MemoryStats::residentBytes();
+    if (resident > 0) {
+        out << "Resident:  " << QString::number(resident / 1048576.0, 'f', 1) << " MB\n";
+    }
+    out.flush();
+
+    store.stopRecording();
+    if (TraceRecorder::isEnabled() && !TraceRecorder::instance().stop()) {
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
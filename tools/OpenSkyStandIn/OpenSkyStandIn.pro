@@ -0,0 +1,20 @@
+#-------------------------------------------------
+#  Offline stand-in for the OpenSky Network REST API.
+#  Serves the OAuth2 token endpoint, /api/states/all and /api/tracks/all from fixture files.
+#-------------------------------------------------
+
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+QT = core network
+
+TARGET = OpenSkyStandIn
+
+HEADERS += \
+    StandInServer.h
+
+SOURCES += \
+    StandInServer.cpp \
+    main.cpp
\ No newline at end of file
@@ -0,0 +1,334 @@
+#include "StandInServer.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QtNumeric>
+#include <QTimer>
+#include <QRegularExpression>
+#include <QUuid>
+#include <QDebug>
+
+namespace {
+const QString TokenPath = "/auth/realms/opensky-network/protocol/openid-connect/token";
+const QString StatesPath = "/api/states/all";
+const QString TracksPath = "/api/tracks/all";
+
+// Requests larger than this are dropped rather than buffered
+constexpr qsizetype MaxRequestSize = 64 * 1024;
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 503: return "Service Unavailable";
+    default: return "Error";
+    }
+}
+}
+
+StandInServer::StandInServer(const Options& options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_server(new QTcpServer(this))
+    , m_random(options.seed)
+{
+    // Snapshots are served from memory so large generated fixtures don't hit the disk per request
+    QDir statesDir(QDir(options.fixturePath).filePath("states"));
+    for (const QString& name : statesDir.entryList({"*.json"}, QDir::Files, QDir::Name)) {
+        QFile file(statesDir.filePath(name));
+        if (file.open(QIODevice::ReadOnly)) {
+            m_states.append(file.readAll());
+        }
+    }
+
+    connect(m_server, &QTcpServer::newConnection, this, &StandInServer::onNewConnection);
+}
+
+bool StandInServer::listen()
+{
+    if (m_states.isEmpty()) {
+        m_error = QString("No state fixtures in %1/states").arg(m_options.fixturePath);
+        return false;
+    }
+
+    if (!m_server->listen(QHostAddress::LocalHost, m_options.port)) {
+        m_error = m_server->errorString();
+        return false;
+    }
+
+    qInfo() << "OpenSky stand-in listening on" << QString("http://127.0.0.1:%1").arg(port())
+            << "with" << m_states.size() << "snapshots";
+    return true;
+}
+
+quint16 StandInServer::port() const
+{
+    return m_server->serverPort();
+}
+
+void StandInServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void StandInServer::onReadyRead(QTcpSocket *socket)
+{
+    QByteArray& buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    Request request;
+    bool malformed = false;
+    while (takeRequest(buffer, request, malformed)) {
+        const Response response = handle(request);
+        qDebug().noquote() << request.method << request.path << "->" << response.status;
+
+        // Delay each response independently, the socket is the context so a closed connection cancels it
+        QTimer::singleShot(responseDelay(), socket, [this, socket, response]() { send(socket, response); });
+    }
+
+    if (malformed || buffer.size() > MaxRequestSize) {
+        send(socket, jsonError(400, "invalid_request", "Malformed HTTP request"));
+        socket->disconnectFromHost();
+    }
+}
+
+bool StandInServer::takeRequest(QByteArray& buffer, Request& request, bool& malformed)
+{
+    const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return false;
+    }
+
+    const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+    const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+    if (requestLine.size() != 3) {
+        malformed = true;
+        return false;
+    }
+
+    request = Request();
+    request.method = requestLine[0];
+    const QUrl target(QString::fromLatin1(requestLine[1]));
+    request.path = target.path();
+    request.query = QUrlQuery(target);
+
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const qsizetype colon = lines[i].indexOf(':');
+        if (colon > 0) {
+            request.headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+        }
+    }
+
+    bool ok = true;
+    const qsizetype contentLength = request.headers.value("content-length", "0").toLongLong(&ok);
+    if (!ok || contentLength < 0) {
+        malformed = true;
+        return false;
+    }
+
+    const qsizetype bodyStart = headerEnd + 4;
+    if (buffer.size() - bodyStart < contentLength) {
+        return false;
+    }
+
+    request.body = buffer.mid(bodyStart, contentLength);
+    buffer.remove(0, bodyStart + contentLength);
+    return true;
+}
+
+StandInServer::Response StandInServer::handle(const Request& request)
+{
+    if (m_options.errorRate > 0.0 && m_random.generateDouble() < m_options.errorRate) {
+        return jsonError(503, "unavailable", "Injected failure");
+    }
+
+    if (request.path == TokenPath) {
+        if (request.method != "POST") {
+            return jsonError(405, "invalid_request", "Token endpoint requires POST");
+        }
+        return issueToken(request);
+    }
+
+    if (request.path != StatesPath && request.path != TracksPath) {
+        return jsonError(404, "not_found", "Unknown endpoint");
+    }
+
+    if (request.method != "GET") {
+        return jsonError(405, "invalid_request", "API endpoints require GET");
+    }
+
+    if (!isAuthorized(request)
+        || (m_options.unauthorizedRate > 0.0 && m_random.generateDouble() < m_options.unauthorizedRate)) {
+        Response response = jsonError(401, "invalid_token", "Missing, unknown or expired access token");
+        response.extraHeaders = "WWW-Authenticate: Bearer error=\"invalid_token\"\r\n";
+        return response;
+    }
+
+    return request.path == StatesPath ? serveStates(request) : serveTrack(request);
+}
+
+StandInServer::Response StandInServer::issueToken(const Request& request)
+{
+    // Any non-empty client credentials are accepted
+    const QUrlQuery form(QString::fromUtf8(request.body));
+    if (form.queryItemValue("grant_type") != "client_credentials"
+        || form.queryItemValue("client_id").isEmpty()
+        || form.queryItemValue("client_secret").isEmpty()) {
+        return jsonError(400, "invalid_client", "Client credentials grant with client_id and client_secret required");
+    }
+
+    const QByteArray token = QUuid::createUuid().toByteArray(QUuid::WithoutBraces);
+    m_tokens.insert(token, QDateTime::currentDateTimeUtc().addSecs(m_options.tokenLifetimeSecs));
+
+    QJsonObject body;
+    body["access_token"] = QString::fromLatin1(token);
+    body["token_type"] = "Bearer";
+    body["expires_in"] = m_options.tokenLifetimeSecs;
+
+    Response response;
+    response.body = QJsonDocument(body).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+bool StandInServer::isAuthorized(const Request& request)
+{
+    const QByteArray authorization = request.headers.value("authorization");
+    if (!authorization.startsWith("Bearer ")) {
+        return false;
+    }
+
+    auto it = m_tokens.find(authorization.mid(7));
+    if (it == m_tokens.end()) {
+        return false;
+    }
+
+    if (*it < QDateTime::currentDateTimeUtc()) {
+        m_tokens.erase(it);
+        return false;
+    }
+    return true;
+}
+
+StandInServer::Response StandInServer::serveStates(const Request& request)
+{
+    QUrlQuery bounds;
+    for (const char* name : {"lamin", "lomin", "lamax", "lomax"}) {
+        if (request.query.hasQueryItem(name)) {
+            bounds.addQueryItem(name, request.query.queryItemValue(name));
+        }
+    }
+
+    int& next = m_nextState[bounds.toString()];
+    const int index = next;
+    next = (next + 1) % m_states.size();
+
+    Response response;
+    response.body = bounds.isEmpty() ? m_states[index] : statesInBounds(index, bounds);
+    return response;
+}
+
+QByteArray StandInServer::statesInBounds(int index, const QUrlQuery& bounds)
+{
+    const QString key = QString("%1?%2").arg(index).arg(bounds.toString());
+    auto cached = m_boundedStates.constFind(key);
+    if (cached != m_boundedStates.constEnd()) {
+        return *cached;
+    }
+
+    // Missing bounds are open, as in OpenSky; bounds are inclusive
+    auto bound = [&bounds](const char* name, double fallback) {
+        bool ok = false;
+        const double value = bounds.queryItemValue(name).toDouble(&ok);
+        return ok ? value : fallback;
+    };
+    const double minLatitude = bound("lamin", -90.0);
+    const double minLongitude = bound("lomin", -180.0);
+    const double maxLatitude = bound("lamax", 90.0);
+    const double maxLongitude = bound("lomax", 180.0);
+
+    QJsonObject snapshot = QJsonDocument::fromJson(m_states[index]).object();
+    QJsonArray inBounds;
+    const QJsonArray states = snapshot["states"].toArray();
+    for (const QJsonValue& value : states) {
+        const QJsonArray state = value.toArray();
+        const double longitude = state.at(5).toDouble(qQNaN());
+        const double latitude = state.at(6).toDouble(qQNaN());
+        if (latitude >= minLatitude && latitude <= maxLatitude
+            && longitude >= minLongitude && longitude <= maxLongitude) {
+            inBounds.append(state);
+        }
+    }
+    snapshot["states"] = inBounds;
+
+    const QByteArray body = QJsonDocument(snapshot).toJson(QJsonDocument::Compact);
+    m_boundedStates.insert(key, body);
+    return body;
+}
+
+StandInServer::Response StandInServer::serveTrack(const Request& request)
+{
+    const QString icao24 = request.query.queryItemValue("icao24").toLower();
+    // icao24 is a hex address, anything else must not become a path
+    static const QRegularExpression hexAddress("^[0-9a-f]{6}$");
+    if (!hexAddress.match(icao24).hasMatch()) {
+        return jsonError(400, "invalid_request", "icao24 must be a 6 digit hex address");
+    }
+
+    QFile file(QDir(m_options.fixturePath).filePath(QString("tracks/%1.json").arg(icao24)));
+    if (!file.open(QIODevice::ReadOnly)) {
+        // OpenSky answers 404 when it has no track for the aircraft
+        return jsonError(404, "not_found", "No track for " + icao24.toLatin1());
+    }
+
+    Response response;
+    response.body = file.readAll();
+    return response;
+}
+
+void StandInServer::send(QTcpSocket *socket, const Response& response)
+{
+    QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+    head += "Content-Type: application/json\r\n";
+    head += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    head += response.extraHeaders;
+    head += "\r\n";
+
+    socket->write(head);
+    socket->write(response.body);
+}
+
+int StandInServer::responseDelay()
+{
+    int delay = m_options.latencyMs;
+    if (m_options.jitterMs > 0) {
+        delay += int(m_random.bounded(m_options.jitterMs + 1));
+    }
+    return delay;
+}
+
+StandInServer::Response StandInServer::jsonError(int status, const QByteArray& error, const QByteArray& description)
+{
+    QJsonObject body;
+    body["error"] = QString::fromLatin1(error);
+    body["error_description"] = QString::fromLatin1(description);
+
+    Response response;
+    response.status = status;
+    response.body = QJsonDocument(body).toJson(QJsonDocument::Compact);
+    return response;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef STANDINSERVER_H
+#define STANDINSERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QUrlQuery>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Minimal HTTP/1.1 server that answers like OpenSky:
+//   POST /auth/realms/opensky-network/protocol/openid-connect/token  client credentials grant
+//   GET  /api/states/all[?lamin=&lomin=&lamax=&lomax=]               next fixture in <root>/states
+//   GET  /api/tracks/all?icao24=...                                  <root>/tracks/<icao24>.json
+// API requests need a Bearer token issued by the token endpoint that has not expired.
+// Each bounding box steps through the fixtures on its own, so the shards of one refresh
+// all come from the same snapshot.
+class StandInServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options
+    {
+        QString fixturePath;
+        quint16 port = 8080;
+        int latencyMs = 0;           // added to every response
+        int jitterMs = 0;            // uniform extra delay in [0, jitterMs]
+        double errorRate = 0.0;      // fraction of requests answered with 503
+        double unauthorizedRate = 0.0; // fraction of API requests answered with 401
+        int tokenLifetimeSecs = 1800;
+        quint32 seed = 1;
+    };
+
+    explicit StandInServer(const Options& options, QObject *parent = nullptr);
+
+    bool listen();
+    QString errorString() const { return m_error; }
+    quint16 port() const;
+
+private slots:
+    void onNewConnection();
+
+private:
+    struct Request
+    {
+        QByteArray method;
+        QString path;
+        QUrlQuery query;
+        QHash<QByteArray, QByteArray> headers;  // lower-case names
+        QByteArray body;
+    };
+
+    struct Response
+    {
+        int status = 200;
+        QByteArray body;
+        QByteArray extraHeaders;
+    };
+
+    void onReadyRead(QTcpSocket *socket);
+    bool takeRequest(QByteArray& buffer, Request& request, bool& malformed);
+    Response handle(const Request& request);
+    Response issueToken(const Request& request);
+    Response serveStates(const Request& request);
+    QByteArray statesInBounds(int index, const QUrlQuery& bounds);
+    Response serveTrack(const Request& request);
+    bool isAuthorized(const Request& request);
+    void send(QTcpSocket *socket, const Response& response);
+    int responseDelay();
+
+    static Response jsonError(int status, const QByteArray& error, const QByteArray& description);
+
+    Options m_options;
+    QTcpServer *m_server;
+    QRandomGenerator m_random;
+    QList<QByteArray> m_states;
+    QHash<QString, int> m_nextState;            // bounding box query -> next fixture
+    QHash<QString, QByteArray> m_boundedStates; // "<fixture>?<bounding box query>" -> body
+    QHash<QByteArray, QDateTime> m_tokens;  // token -> expiry
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+    QString m_error;
+};
+
+#endif // STANDINSERVER_H
\ No newline at end of file
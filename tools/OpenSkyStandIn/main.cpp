@@ -0,0 +1,49 @@
+#include "StandInServer.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("OpenSkyStandIn");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Serves OpenSky-compatible token, /states/all and /tracks/all endpoints from fixture files.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("fixtures", "Fixture directory containing states/ and tracks/.");
+
+    QCommandLineOption portOption("port", "Port to listen on (0 picks a free one).", "port", "8080");
+    QCommandLineOption latencyOption("latency", "Delay added to every response in ms.", "ms", "0");
+    QCommandLineOption jitterOption("jitter", "Extra random delay of up to this many ms.", "ms", "0");
+    QCommandLineOption errorRateOption("error-rate", "Fraction of requests answered with 503.", "rate", "0");
+    QCommandLineOption unauthorizedRateOption("unauthorized-rate", "Fraction of API requests answered with 401.", "rate", "0");
+    QCommandLineOption tokenLifetimeOption("token-lifetime", "Access token lifetime in seconds.", "secs", "1800");
+    QCommandLineOption seedOption("seed", "Seed for latency jitter and error injection.", "seed", "1");
+    parser.addOptions({portOption, latencyOption, jitterOption, errorRateOption,
+                       unauthorizedRateOption, tokenLifetimeOption, seedOption});
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+
+    StandInServer::Options options;
+    options.fixturePath = parser.positionalArguments().first();
+    options.port = quint16(parser.value(portOption).toUInt());
+    options.latencyMs = qMax(0, parser.value(latencyOption).toInt());
+    options.jitterMs = qMax(0, parser.value(jitterOption).toInt());
+    options.errorRate = qBound(0.0, parser.value(errorRateOption).toDouble(), 1.0);
+    options.unauthorizedRate = qBound(0.0, parser.value(unauthorizedRateOption).toDouble(), 1.0);
+    options.tokenLifetimeSecs = qMax(1, parser.value(tokenLifetimeOption).toInt());
+    options.seed = parser.value(seedOption).toUInt();
+
+    StandInServer server(options);
+    if (!server.listen()) {
+        qCritical() << "Could not start:" << server.errorString();
+        return 1;
+    }
+
+    return app.exec();
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#  Writes synthetic traffic as OpenSky-shaped fixture files for the
+#  file data source, the stand-in server and benchmarks.
+#-------------------------------------------------
+
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+QT = core
+
+TARGET = TrafficGen
+
+include($$PWD/../../core/FlightTrackerCore.pri)
+
+SOURCES += \
+    main.cpp
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "TrafficGenerator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+
+namespace {
+bool writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size()) {
+        qCritical() << "Could not write" << path << file.errorString();
+        return false;
+    }
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("TrafficGen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Writes deterministic synthetic traffic as OpenSky /states/all and /tracks/all fixtures.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("output", "Fixture directory to create (states/ and tracks/ are written inside).");
+
+    QCommandLineOption aircraftOption("aircraft", "Number of aircraft.", "count", "10000");
+    QCommandLineOption snapshotsOption("snapshots", "Number of /states/all snapshots.", "count", "10");
+    QCommandLineOption intervalOption("interval", "Seconds between snapshots.", "secs", "10");
+    QCommandLineOption seedOption("seed", "Generator seed.", "seed", "1");
+    QCommandLineOption groundOption("ground", "Share of aircraft on the ground at hubs.", "fraction", "0.1");
+    QCommandLineOption churnOption("churn", "Share of aircraft replaced per hour.", "fraction", "0.05");
+    QCommandLineOption tracksOption("tracks", "Write tracks for this many aircraft of the last snapshot.", "count", "20");
+    parser.addOptions({aircraftOption, snapshotsOption, intervalOption, seedOption,
+                       groundOption, churnOption, tracksOption});
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+
+    const QDir output(parser.positionalArguments().first());
+    if (!output.mkpath("states") || !output.mkpath("tracks")) {
+        qCritical() << "Could not create" << output.path();
+        return 1;
+    }
+
+    TrafficGenerator::Options options;
+    options.seed = parser.value(seedOption).toUInt();
+    options.aircraftCount = parser.value(aircraftOption).toInt();
+    options.groundFraction = parser.value(groundOption).toDouble();
+    options.churnPerHour = parser.value(churnOption).toDouble();
+
+    TrafficGenerator generator(options);
+    const int snapshots = qMax(1, parser.value(snapshotsOption).toInt());
+    const double interval = parser.value(intervalOption).toDouble();
+
+    for (int i = 0; i < snapshots; ++i) {
+        if (i > 0) {
+            generator.advance(interval);
+        }
+        const QString path = output.filePath(QString("states/%1.json").arg(i + 1, 4, 10, QChar('0')));
+        if (!writeFile(path, generator.statesJson())) {
+            return 1;
+        }
+    }
+
+    // Ground aircraft have no current leg, so they are skipped
+    int written = 0;
+    const int wanted = parser.value(tracksOption).toInt();
+    for (int i = 0; i < generator.aircraftCount() && written < wanted; ++i) {
+        const QString icao24 = generator.icao24At(i);
+        const QByteArray track = generator.trackJson(icao24);
+        if (track.isEmpty()) {
+            continue;
+        }
+        if (!writeFile(output.filePath(QString("tracks/%1.json").arg(icao24)), track)) {
+            return 1;
+        }
+        ++written;
+    }
+
+    qInfo() << "Wrote" << snapshots << "snapshots of" << generator.aircraftCount() << "aircraft and"
+            << written << "tracks to" << output.path();
+    return 0;
+}
\ No newline at end of file